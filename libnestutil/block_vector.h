@@ -235,6 +235,14 @@ public:
    */
   void push_back( const value_type_& value );
 
+  /**
+   * @brief Allocate the blocks for n elements.
+   *
+   * Allocates blocks up front, so that no blocks are added while the
+   * BlockVector grows to n elements. Does not change the size.
+   */
+  void reserve( size_t n );
+
   /**
    * Erases all the elements.
    */
@@ -393,8 +401,9 @@ template < typename value_type_ >
 inline void
 BlockVector< value_type_ >::push_back( const value_type_& value )
 {
-  // If this is the last element in the current block, add another block
-  if ( finish_.block_it_ == finish_.current_block_end_ - 1 )
+  // If this is the last element in the current block, add another block,
+  // unless it has been reserved already
+  if ( finish_.block_it_ == finish_.current_block_end_ - 1 and finish_.block_index_ + 1 == blockmap_.size() )
   {
     blockmap_.emplace_back( max_block_size );
   }
@@ -402,6 +411,24 @@ BlockVector< value_type_ >::push_back( const value_type_& value )
   ++finish_;
 }
 
+template < typename value_type_ >
+inline void
+BlockVector< value_type_ >::reserve( const size_t n )
+{
+  // The block after the last element must always exist.
+  const size_t num_blocks_needed = n / max_block_size + 1;
+  if ( num_blocks_needed > blockmap_.size() )
+  {
+    // Blocks are moved when the blockmap is reallocated, so finish_ stays
+    // valid, as in push_back().
+    blockmap_.reserve( num_blocks_needed );
+    while ( blockmap_.size() < num_blocks_needed )
+    {
+      blockmap_.emplace_back( max_block_size );
+    }
+  }
+}
+
 template < typename value_type_ >
 inline void
 BlockVector< value_type_ >::clear()
@@ -0,0 +1,133 @@
+/*
+ *  index_set.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef INDEX_SET_H
+#define INDEX_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Set of indices, meant to be reused for drawing many samples without
+ * repetitions.
+ *
+ * The indices are stored in an open-addressing hash table with linear
+ * probing. Each slot is marked with the generation in which it was
+ * filled, so clearing the set only advances the generation and neither
+ * allocates nor touches the slots unless the table must grow.
+ */
+class IndexSet
+{
+public:
+  IndexSet()
+    : slots_( 1 )
+    , generation_( 0 )
+    , shift_( 64 )
+  {
+  }
+
+  /**
+   * Remove all indices and make room for at least n indices.
+   */
+  void
+  clear( const size_t n )
+  {
+    ++generation_;
+
+    // keep the table at most half full
+    size_t capacity = 1;
+    unsigned int shift = 64;
+    while ( capacity < 2 * n )
+    {
+      capacity *= 2;
+      --shift;
+    }
+
+    if ( capacity > slots_.size() or generation_ == 0 )
+    {
+      slots_.assign( capacity, Slot() );
+      shift_ = shift;
+      generation_ = 1;
+    }
+  }
+
+  /**
+   * Return true if the index is in the set.
+   */
+  bool
+  contains( const size_t index ) const
+  {
+    for ( size_t slot = hash_( index );; slot = ( slot + 1 ) & ( slots_.size() - 1 ) )
+    {
+      if ( slots_[ slot ].generation != generation_ )
+      {
+        return false;
+      }
+      if ( slots_[ slot ].index == index )
+      {
+        return true;
+      }
+    }
+  }
+
+  /**
+   * Add the index to the set, which must not contain it yet.
+   */
+  void
+  insert( const size_t index )
+  {
+    size_t slot = hash_( index );
+    while ( slots_[ slot ].generation == generation_ )
+    {
+      slot = ( slot + 1 ) & ( slots_.size() - 1 );
+    }
+    slots_[ slot ].index = index;
+    slots_[ slot ].generation = generation_;
+  }
+
+private:
+  struct Slot
+  {
+    Slot()
+      : index( 0 )
+      , generation( 0 )
+    {
+    }
+
+    size_t index;
+    unsigned int generation; //!< slot is in use if equal to generation_
+  };
+
+  //! Fibonacci hashing, using the highest bits of the product
+  size_t
+  hash_( const size_t index ) const
+  {
+    return shift_ == 64 ? 0 : ( static_cast< std::uint64_t >( index ) * 11400714819323198485ull ) >> shift_;
+  }
+
+  std::vector< Slot > slots_;
+  unsigned int generation_;
+  unsigned int shift_; //!< 64 - log2 of the number of slots
+};
+
+#endif // INDEX_SET_H
@@ -586,11 +586,13 @@ aeif_cond_beta_multisynapse::update( Time const& origin, const long from, const
       --S_.r_;
     }
 
+    const double* spikes = B_.spikes_.get_values_all_ports( lag );
     for ( size_t i = 0; i < P_.n_receptors(); ++i )
     {
       S_.y_[ State_::DG + ( State_::NUM_STATE_ELEMENTS_PER_RECEPTOR * i ) ] +=
-        B_.spikes_[ i ].get_value( lag ) * V_.g0_[ i ]; // add incoming spike
+        spikes[ i ] * V_.g0_[ i ]; // add incoming spike
     }
+    B_.spikes_.reset_values_all_ports( lag );
     // set new input current
     B_.I_stim_ = B_.currents_.get_value( lag );
 
@@ -623,8 +625,9 @@ aeif_cond_beta_multisynapse::handle( SpikeEvent& e )
   assert( e.get_delay_steps() > 0 );
   assert( ( e.get_rport() > 0 ) && ( ( size_t ) e.get_rport() <= P_.n_receptors() ) );
 
-  B_.spikes_[ e.get_rport() - 1 ].add_value(
-    e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ), e.get_weight() * e.get_multiplicity() );
+  B_.spikes_.add_value( e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ),
+    e.get_rport() - 1,
+    e.get_weight() * e.get_multiplicity() );
 }
 
 void
@@ -316,7 +316,7 @@ private:
     DynamicUniversalDataLogger< aeif_cond_beta_multisynapse > logger_;
 
     /** buffers and sums up incoming spikes/currents */
-    std::vector< RingBuffer > spikes_;
+    MultiPortRingBuffer spikes_;
     RingBuffer currents_;
 
     /** GSL ODE stuff */
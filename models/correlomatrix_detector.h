@@ -140,7 +140,7 @@ SpikeEvent
 See also
 ++++++++
 
-correlation_detector, spike_recorder
+correlation_detector, parallel_correlomatrix_detector, spike_recorder
 
 EndUserDocs */
 
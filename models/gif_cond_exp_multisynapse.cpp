@@ -452,10 +452,7 @@ void
 nest::gif_cond_exp_multisynapse::init_buffers_()
 {
   B_.spikes_.resize( P_.n_receptors() );
-  for ( size_t i = 0; i < P_.n_receptors(); ++i )
-  {
-    B_.spikes_[ i ].clear(); // includes resize
-  }
+  B_.spikes_.clear(); // includes resize
 
   B_.currents_.clear(); //!< includes resize
   B_.logger_.reset();   //!< includes resize
@@ -587,10 +584,12 @@ nest::gif_cond_exp_multisynapse::update( Time const& origin, const long from, co
       }
     }
 
+    const double* spikes = B_.spikes_.get_values_all_ports( lag );
     for ( size_t i = 0; i < P_.n_receptors(); i++ )
     {
-      S_.y_[ State_::G + ( State_::NUM_STATE_ELEMENTS_PER_RECEPTOR * i ) ] += B_.spikes_[ i ].get_value( lag );
+      S_.y_[ State_::G + ( State_::NUM_STATE_ELEMENTS_PER_RECEPTOR * i ) ] += spikes[ i ];
     }
+    B_.spikes_.reset_values_all_ports( lag );
 
     if ( S_.r_ref_ == 0 ) // neuron is not in refractory period
     {
@@ -651,8 +650,9 @@ nest::gif_cond_exp_multisynapse::handle( SpikeEvent& e )
   assert( e.get_delay_steps() > 0 );
   assert( ( e.get_rport() > 0 ) && ( ( size_t ) e.get_rport() <= P_.n_receptors() ) );
 
-  B_.spikes_[ e.get_rport() - 1 ].add_value(
-    e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ), e.get_weight() * e.get_multiplicity() );
+  B_.spikes_.add_value( e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ),
+    e.get_rport() - 1,
+    e.get_weight() * e.get_multiplicity() );
 }
 
 void
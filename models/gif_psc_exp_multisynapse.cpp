@@ -342,8 +342,6 @@ nest::gif_psc_exp_multisynapse::calibrate()
   {
     V_.P11_syn_[ i ] = std::exp( -h / P_.tau_syn_[ i ] );
     V_.P21_syn_[ i ] = propagator_32( P_.tau_syn_[ i ], tau_m, P_.c_m_, h );
-
-    B_.spikes_[ i ].resize();
   }
 }
 
@@ -377,14 +375,16 @@ nest::gif_psc_exp_multisynapse::update( Time const& origin, const long from, con
     }
 
     double sum_syn_pot = 0.0;
+    const double* spikes = B_.spikes_.get_values_all_ports( lag );
     for ( size_t i = 0; i < P_.n_receptors_(); i++ )
     {
       // computing effect of synaptic currents on membrane potential
       sum_syn_pot += V_.P21_syn_[ i ] * S_.i_syn_[ i ];
       // exponential decaying PSCs
       S_.i_syn_[ i ] = V_.P11_syn_[ i ] * S_.i_syn_[ i ];
-      S_.i_syn_[ i ] += B_.spikes_[ i ].get_value( lag ); // collecting spikes
+      S_.i_syn_[ i ] += spikes[ i ]; // collecting spikes
     }
+    B_.spikes_.reset_values_all_ports( lag );
 
     if ( S_.r_ref_ == 0 ) // neuron is not in refractory period
     {
@@ -440,8 +440,9 @@ gif_psc_exp_multisynapse::handle( SpikeEvent& e )
   assert( e.get_delay_steps() > 0 );
   assert( ( e.get_rport() > 0 ) && ( ( size_t ) e.get_rport() <= P_.n_receptors_() ) );
 
-  B_.spikes_[ e.get_rport() - 1 ].add_value(
-    e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ), e.get_weight() * e.get_multiplicity() );
+  B_.spikes_.add_value( e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ),
+    e.get_rport() - 1,
+    e.get_weight() * e.get_multiplicity() );
 }
 
 void
@@ -337,7 +337,7 @@ private:
     Buffers_( const Buffers_&, gif_psc_exp_multisynapse& );
 
     /** buffers and sums up incoming spikes/currents */
-    std::vector< RingBuffer > spikes_;
+    MultiPortRingBuffer spikes_;
     RingBuffer currents_;
 
     //! Logger for all analog data
@@ -326,7 +326,6 @@ iaf_psc_alpha_multisynapse::calibrate()
     V_.P32_syn_[ i ] = propagator_32( P_.tau_syn_[ i ], P_.Tau_, P_.C_, h );
 
     V_.PSCInitialValues_[ i ] = 1.0 * numerics::e / P_.tau_syn_[ i ];
-    B_.spikes_[ i ].resize();
   }
 
   V_.RefractoryCounts_ = Time( Time::ms( P_.refractory_time_ ) ).get_steps();
@@ -360,6 +359,7 @@ iaf_psc_alpha_multisynapse::update( Time const& origin, const long from, const l
       --S_.refractory_steps_;
     }
 
+    const double* spikes = B_.spikes_.get_values_all_ports( lag );
     for ( size_t i = 0; i < P_.n_receptors_(); i++ )
     {
       // alpha shape PSCs
@@ -367,8 +367,9 @@ iaf_psc_alpha_multisynapse::update( Time const& origin, const long from, const l
       S_.y1_syn_[ i ] *= V_.P11_syn_[ i ];
 
       // collect spikes
-      S_.y1_syn_[ i ] += V_.PSCInitialValues_[ i ] * B_.spikes_[ i ].get_value( lag );
+      S_.y1_syn_[ i ] += V_.PSCInitialValues_[ i ] * spikes[ i ];
     }
+    B_.spikes_.reset_values_all_ports( lag );
 
     if ( S_.V_m_ >= P_.Theta_ ) // threshold crossing
     {
@@ -409,8 +410,9 @@ iaf_psc_alpha_multisynapse::handle( SpikeEvent& e )
 {
   assert( e.get_delay_steps() > 0 );
 
-  B_.spikes_[ e.get_rport() - 1 ].add_value(
-    e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ), e.get_weight() * e.get_multiplicity() );
+  B_.spikes_.add_value( e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ),
+    e.get_rport() - 1,
+    e.get_weight() * e.get_multiplicity() );
 }
 
 void
@@ -93,6 +93,11 @@ optimization levels. A future version of iaf_psc_delta will probably
 address the problem of efficient usage of appropriate vector and
 matrix objects.
 
+If the kernel attribute ``sparse_input_buffers`` is set, incoming spikes
+and currents are buffered only for those time steps that actually receive
+input. This reduces memory consumption for sparsely driven neurons in
+networks with long maximal delays.
+
 Parameters
 ++++++++++
 
@@ -269,8 +274,8 @@ private:
     Buffers_( const Buffers_&, iaf_psc_delta& );
 
     /** buffers and summs up incoming spikes/currents */
-    RingBuffer spikes_;
-    RingBuffer currents_;
+    CompactRingBuffer spikes_;
+    CompactRingBuffer currents_;
 
     //! Logger for all analog data
     UniversalDataLogger< iaf_psc_delta > logger_;
@@ -303,7 +303,6 @@ nest::iaf_psc_exp_multisynapse::calibrate()
     // these are determined according to a numeric stability criterion
     V_.P21_syn_[ i ] = propagator_32( P_.tau_syn_[ i ], P_.Tau_, P_.C_, h );
 
-    B_.spikes_[ i ].resize();
   }
 
   V_.RefractoryCounts_ = Time( Time::ms( P_.refractory_time_ ) ).get_steps();
@@ -333,14 +332,16 @@ iaf_psc_exp_multisynapse::update( const Time& origin, const long from, const lon
     {
       --S_.refractory_steps_; // neuron is absolute refractory
     }
+    const double* spikes = B_.spikes_.get_values_all_ports( lag );
     for ( size_t i = 0; i < P_.n_receptors_(); i++ )
     {
       // exponential decaying PSCs
       S_.i_syn_[ i ] *= V_.P11_syn_[ i ];
 
       // collect spikes
-      S_.i_syn_[ i ] += B_.spikes_[ i ].get_value( lag ); // not sure about this
+      S_.i_syn_[ i ] += spikes[ i ]; // not sure about this
     }
+    B_.spikes_.reset_values_all_ports( lag );
 
     if ( S_.V_m_ >= P_.Theta_ ) // threshold crossing
     {
@@ -377,8 +378,9 @@ iaf_psc_exp_multisynapse::handle( SpikeEvent& e )
 {
   assert( e.get_delay_steps() > 0 );
 
-  B_.spikes_[ e.get_rport() - 1 ].add_value(
-    e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ), e.get_weight() * e.get_multiplicity() );
+  B_.spikes_.add_value( e.get_rel_delivery_steps( kernel().simulation_manager.get_slice_origin() ),
+    e.get_rport() - 1,
+    e.get_weight() * e.get_multiplicity() );
 }
 
 void
@@ -109,8 +109,10 @@
 #include "correlomatrix_detector.h"
 #include "correlospinmatrix_detector.h"
 #include "multimeter.h"
+#include "parallel_correlomatrix_detector.h"
 #include "spike_dilutor.h"
 #include "spike_recorder.h"
+#include "spike_statistics_detector.h"
 #include "spin_detector.h"
 #include "volume_transmitter.h"
 #include "weight_recorder.h"
@@ -140,6 +142,7 @@
 #include "stdp_nn_symm_synapse.h"
 #include "stdp_nn_pre_centered_synapse.h"
 #include "stdp_pl_synapse_hom.h"
+#include "stdp_postdriven_synapse.h"
 #include "stdp_triplet_synapse.h"
 #include "tsodyks2_synapse.h"
 #include "tsodyks_synapse.h"
@@ -262,6 +265,8 @@ ModelsModule::init( SLIInterpreter* )
   kernel().model_manager.register_node_model< correlation_detector >( "correlation_detector" );
   kernel().model_manager.register_node_model< correlomatrix_detector >( "correlomatrix_detector" );
   kernel().model_manager.register_node_model< correlospinmatrix_detector >( "correlospinmatrix_detector" );
+  kernel().model_manager.register_node_model< parallel_correlomatrix_detector >( "parallel_correlomatrix_detector" );
+  kernel().model_manager.register_node_model< spike_statistics_detector >( "spike_statistics_detector" );
   kernel().model_manager.register_node_model< volume_transmitter >( "volume_transmitter" );
 
 #ifdef HAVE_GSL
@@ -324,6 +329,7 @@ ModelsModule::init( SLIInterpreter* )
   register_connection_model< stdp_nn_symm_synapse >( "stdp_nn_symm_synapse" );
   register_connection_model< stdp_nn_pre_centered_synapse >( "stdp_nn_pre_centered_synapse" );
   register_connection_model< stdp_pl_synapse_hom >( "stdp_pl_synapse_hom" );
+  register_connection_model< stdp_postdriven_synapse >( "stdp_postdriven_synapse" );
   register_connection_model< stdp_triplet_synapse >( "stdp_triplet_synapse" );
   register_connection_model< tsodyks_synapse >( "tsodyks_synapse" );
   register_connection_model< tsodyks_synapse_hom >( "tsodyks_synapse_hom" );
@@ -22,6 +22,9 @@
 
 #include "multimeter.h"
 
+// C++ includes:
+#include <algorithm>
+
 // Includes from nestkernel:
 #include "event_delivery_manager_impl.h"
 
@@ -46,7 +49,7 @@ multimeter::multimeter( const multimeter& n )
 }
 
 port
-multimeter::send_test_event( Node& target, rport receptor_type, synindex, bool )
+multimeter::send_test_event( Node& target, rport receptor_type, synindex, bool dummy_target )
 {
   DataLoggingRequest e( P_.interval_, P_.offset_, P_.record_from_ );
   e.set_sender( *this );
@@ -54,6 +57,10 @@ multimeter::send_test_event( Node& target, rport receptor_type, synindex, bool )
   if ( p != invalid_port_ and not is_model_prototype() )
   {
     B_.has_targets_ = true;
+    if ( not dummy_target )
+    {
+      ++B_.n_targets_;
+    }
   }
   return p;
 }
@@ -86,6 +93,7 @@ nest::multimeter::Parameters_& nest::multimeter::Parameters_::operator=( const P
 
 nest::multimeter::Buffers_::Buffers_()
   : has_targets_( false )
+  , n_targets_( 0 )
 {
 }
 
@@ -172,6 +180,13 @@ void
 multimeter::calibrate()
 {
   RecordingDevice::calibrate( P_.record_from_, RecordingBackend::NO_LONG_VALUE_NAMES );
+
+  // reserve space for the samples of all targets in one slice
+  const size_t n_samples =
+    B_.n_targets_ * ( kernel().connection_manager.get_min_delay() / P_.interval_.get_steps() + 1 );
+  B_.sample_senders_.reserve( n_samples );
+  B_.sample_times_.reserve( n_samples );
+  B_.sample_values_.reserve( n_samples * P_.record_from_.size() );
 }
 
 void
@@ -196,6 +211,8 @@ multimeter::update( Time const& origin, const long from, const long )
   // Note that not all nodes receiving the request will necessarily answer.
   DataLoggingRequest req;
   kernel().event_delivery_manager.send( *this, req );
+
+  write_samples_();
 }
 
 void
@@ -207,7 +224,7 @@ multimeter::handle( DataLoggingReply& reply )
   // count records that have been skipped during inactivity
   size_t inactive_skipped = 0;
 
-  // record all data, time point by time point
+  // collect all data, time point by time point
   for ( size_t j = 0; j < info.size(); ++j )
   {
     if ( not info[ j ].timestamp.is_finite() )
@@ -221,13 +238,33 @@ multimeter::handle( DataLoggingReply& reply )
       continue;
     }
 
-    reply.set_stamp( info[ j ].timestamp );
-    // const index sender = reply.get_sender_node_id();
-    // const Time stamp = reply.get_stamp();
-    // const double offset = reply.get_offset();
+    B_.sample_senders_.push_back( reply.get_sender_node_id() );
+    B_.sample_times_.push_back( info[ j ].timestamp );
+    B_.sample_values_.insert( B_.sample_values_.end(), info[ j ].data.begin(), info[ j ].data.end() );
+  }
+}
 
-    write( reply, info[ j ].data, RecordingBackend::NO_LONG_VALUES );
+void
+multimeter::write_samples_()
+{
+  if ( B_.sample_senders_.empty() )
+  {
+    return;
   }
+
+  const RecordBatch batch( B_.sample_senders_.size(),
+    B_.sample_senders_.data(),
+    B_.sample_times_.data(),
+    nullptr,
+    P_.record_from_.size(),
+    B_.sample_values_.data(),
+    0,
+    nullptr );
+  write_batch( batch );
+
+  B_.sample_senders_.clear();
+  B_.sample_times_.clear();
+  B_.sample_values_.clear();
 }
 
 RecordingDevice::Type
@@ -236,6 +273,21 @@ multimeter::get_type() const
   return RecordingDevice::MULTIMETER;
 }
 
+size_t
+multimeter::get_expected_events( Time const& from, Time const& to ) const
+{
+  // only sample points at which the device is active are recorded
+  const long first = std::max( from.get_steps(), get_t_min_() );
+  const long last = std::min( to.get_steps(), get_t_max_() );
+  if ( B_.n_targets_ == 0 or last <= first )
+  {
+    return 0;
+  }
+
+  const size_t n_samples = ( last - first ) / P_.interval_.get_steps() + 1;
+  return n_samples * B_.n_targets_;
+}
+
 
 //
 // Definition of voltmeter subclass
@@ -154,6 +154,7 @@ public:
   SignalType sends_signal() const;
 
   Type get_type() const;
+  size_t get_expected_events( Time const& from, Time const& to ) const;
   void get_status( DictionaryDatum& ) const;
   void set_status( const DictionaryDatum& );
 
@@ -168,12 +169,19 @@ protected:
    * points for membrane potential information and then outputs
    * that information. The sampled nodes must provide data from
    * the previous time slice.
+   *
+   * The replies of all targets are collected by handle() into one
+   * batch, which is written to the recording backend once all targets
+   * have answered.
    */
   void update( Time const&, const long, const long );
 
 private:
   struct Buffers_;
 
+  //! Write the samples collected in the current slice and clear the batch
+  void write_samples_();
+
   struct Parameters_
   {
     Time interval_;                   //!< recording interval, in ms
@@ -199,6 +207,16 @@ private:
     Buffers_();
 
     bool has_targets_;
+    size_t n_targets_; //!< number of nodes sampled by this instance
+
+    /**
+     * Samples of all targets collected in the current slice, stored as
+     * structure of arrays. sample_values_ holds one row of
+     * record_from_.size() values per sample.
+     */
+    std::vector< index > sample_senders_;
+    std::vector< Time > sample_times_;
+    std::vector< double > sample_values_;
   };
 
   // ------------------------------------------------------------
@@ -0,0 +1,536 @@
+/*
+ *  parallel_correlomatrix_detector.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "parallel_correlomatrix_detector.h"
+
+// C++ includes:
+#include <algorithm>
+#include <functional>
+
+// Includes from libnestutil:
+#include "dict_util.h"
+
+// Includes from nestkernel:
+#include "kernel_manager.h"
+
+// Includes from sli:
+#include "arraydatum.h"
+#include "dict.h"
+#include "dictutils.h"
+
+/* ----------------------------------------------------------------
+ * Default constructors defining default parameters and state
+ * ---------------------------------------------------------------- */
+
+nest::parallel_correlomatrix_detector::Parameters_::Parameters_()
+  : delta_tau_( 5 * Time::get_resolution() )
+  , tau_max_( 10 * delta_tau_ )
+  , Tstart_( Time::ms( 0.0 ) )
+  , Tstop_( Time::pos_inf() )
+  , N_channels_( 1 )
+{
+}
+
+nest::parallel_correlomatrix_detector::Parameters_::Parameters_( const Parameters_& p )
+  : delta_tau_( p.delta_tau_ )
+  , tau_max_( p.tau_max_ )
+  , Tstart_( p.Tstart_ )
+  , Tstop_( p.Tstop_ )
+  , N_channels_( p.N_channels_ )
+{
+  // Check for proper properties is not done here but in the
+  // parallel_correlomatrix_detector() copy c'tor, see
+  // correlomatrix_detector.
+  delta_tau_.calibrate();
+  tau_max_.calibrate();
+  Tstart_.calibrate();
+  Tstop_.calibrate();
+}
+
+nest::parallel_correlomatrix_detector::Parameters_& nest::parallel_correlomatrix_detector::Parameters_::operator=(
+  const Parameters_& p )
+{
+  delta_tau_ = p.delta_tau_;
+  tau_max_ = p.tau_max_;
+  Tstart_ = p.Tstart_;
+  Tstop_ = p.Tstop_;
+  N_channels_ = p.N_channels_;
+
+  delta_tau_.calibrate();
+  tau_max_.calibrate();
+  Tstart_.calibrate();
+  Tstop_.calibrate();
+
+  return *this;
+}
+
+nest::parallel_correlomatrix_detector::State_::State_()
+  : n_events_( 1, 0 )
+  , covariance_( 1, std::vector< std::vector< double > >( 1, std::vector< double >() ) )
+  , count_covariance_( 1, std::vector< std::vector< long > >( 1, std::vector< long >() ) )
+  , last_step_( 0 )
+{
+}
+
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::parallel_correlomatrix_detector::Parameters_::get( DictionaryDatum& d ) const
+{
+  ( *d )[ names::delta_tau ] = delta_tau_.get_ms();
+  ( *d )[ names::tau_max ] = tau_max_.get_ms();
+  ( *d )[ names::Tstart ] = Tstart_.get_ms();
+  ( *d )[ names::Tstop ] = Tstop_.get_ms();
+  ( *d )[ names::N_channels ] = N_channels_;
+}
+
+void
+nest::parallel_correlomatrix_detector::State_::get( DictionaryDatum& d ) const
+{
+  ( *d )[ names::n_events ] = IntVectorDatum( new std::vector< long >( n_events_ ) );
+
+  ArrayDatum* C = new ArrayDatum;
+  ArrayDatum* CountC = new ArrayDatum;
+  for ( size_t i = 0; i < covariance_.size(); ++i )
+  {
+    ArrayDatum* C_i = new ArrayDatum;
+    ArrayDatum* CountC_i = new ArrayDatum;
+    for ( size_t j = 0; j < covariance_[ i ].size(); ++j )
+    {
+      C_i->push_back( new DoubleVectorDatum( new std::vector< double >( covariance_[ i ][ j ] ) ) );
+      CountC_i->push_back( new IntVectorDatum( new std::vector< long >( count_covariance_[ i ][ j ] ) ) );
+    }
+    C->push_back( *C_i );
+    CountC->push_back( *CountC_i );
+  }
+  ( *d )[ names::covariance ] = C;
+  ( *d )[ names::count_covariance ] = CountC;
+}
+
+bool
+nest::parallel_correlomatrix_detector::Parameters_::set( const DictionaryDatum& d,
+  const parallel_correlomatrix_detector& n,
+  Node* node )
+{
+  bool reset = false;
+  double t;
+  long N;
+
+  if ( updateValueParam< long >( d, names::N_channels, N, node ) )
+  {
+    if ( N < 1 )
+    {
+      throw BadProperty( "/N_channels can only be larger than zero." );
+    }
+    else
+    {
+      N_channels_ = N;
+      reset = true;
+    }
+  }
+
+  if ( updateValueParam< double >( d, names::delta_tau, t, node ) )
+  {
+    delta_tau_ = Time::ms( t );
+    reset = true;
+  }
+
+  if ( updateValueParam< double >( d, names::tau_max, t, node ) )
+  {
+    tau_max_ = Time::ms( t );
+    reset = true;
+  }
+
+  if ( updateValueParam< double >( d, names::Tstart, t, node ) )
+  {
+    Tstart_ = Time::ms( t );
+    reset = true;
+  }
+
+  if ( updateValueParam< double >( d, names::Tstop, t, node ) )
+  {
+    Tstop_ = Time::ms( t );
+    reset = true;
+  }
+
+  if ( not delta_tau_.is_step() )
+  {
+    throw StepMultipleRequired( n.get_name(), names::delta_tau, delta_tau_ );
+  }
+
+  if ( not tau_max_.is_multiple_of( delta_tau_ ) )
+  {
+    throw TimeMultipleRequired( n.get_name(), names::tau_max, tau_max_, names::delta_tau, delta_tau_ );
+  }
+
+  if ( delta_tau_.get_steps() % 2 != 1 )
+  {
+    throw BadProperty( "/delta_tau must be odd multiple of resolution." );
+  }
+
+  return reset;
+}
+
+void
+nest::parallel_correlomatrix_detector::State_::reset( const Parameters_& p )
+{
+  n_events_.clear();
+  n_events_.resize( p.N_channels_, 0 );
+
+  assert( p.tau_max_.is_multiple_of( p.delta_tau_ ) );
+
+  covariance_.clear();
+  covariance_.resize( p.N_channels_ );
+
+  count_covariance_.clear();
+  count_covariance_.resize( p.N_channels_ );
+
+  for ( long i = 0; i < p.N_channels_; ++i )
+  {
+    covariance_[ i ].resize( p.N_channels_ );
+    count_covariance_[ i ].resize( p.N_channels_ );
+    for ( long j = 0; j < p.N_channels_; ++j )
+    {
+      covariance_[ i ][ j ].resize( 1 + p.tau_max_.get_steps() / p.delta_tau_.get_steps(), 0 );
+      count_covariance_[ i ][ j ].resize( 1 + p.tau_max_.get_steps() / p.delta_tau_.get_steps(), 0 );
+    }
+  }
+
+  // all spikes up to the current time have been delivered before the reset
+  last_step_ = kernel().simulation_manager.get_time().get_steps();
+}
+
+void
+nest::parallel_correlomatrix_detector::Buffers_::clear()
+{
+  std::fill( steps_.begin(), steps_.end(), -1 );
+}
+
+
+/* ----------------------------------------------------------------
+ * Default and copy constructor for node
+ * ---------------------------------------------------------------- */
+
+nest::parallel_correlomatrix_detector::parallel_correlomatrix_detector()
+  : DeviceNode()
+  , device_()
+  , P_()
+  , S_()
+  , V_()
+  , B_()
+{
+  if ( not P_.delta_tau_.is_step() )
+  {
+    throw InvalidDefaultResolution( get_name(), names::delta_tau, P_.delta_tau_ );
+  }
+}
+
+nest::parallel_correlomatrix_detector::parallel_correlomatrix_detector( const parallel_correlomatrix_detector& n )
+  : DeviceNode( n )
+  , device_( n.device_ )
+  , P_( n.P_ )
+  , S_()
+  , V_()
+  , B_()
+{
+  if ( not P_.delta_tau_.is_step() )
+  {
+    throw InvalidTimeInModel( get_name(), names::delta_tau, P_.delta_tau_ );
+  }
+}
+
+
+/* ----------------------------------------------------------------
+ * Node initialization functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::parallel_correlomatrix_detector::init_state_( const Node& proto )
+{
+  const parallel_correlomatrix_detector& pr = downcast< parallel_correlomatrix_detector >( proto );
+
+  device_.init_state( pr.device_ );
+  S_ = pr.S_;
+  set_buffers_initialized( false ); // force recreation of buffers
+}
+
+void
+nest::parallel_correlomatrix_detector::init_buffers_()
+{
+  device_.init_buffers();
+  S_.reset( P_ );
+  B_.clear();
+}
+
+void
+nest::parallel_correlomatrix_detector::calibrate()
+{
+  device_.calibrate();
+  prepare_buffers_();
+
+  B_.siblings_.clear();
+  for ( auto sibling : kernel().node_manager.get_thread_siblings( get_node_id() ) )
+  {
+    B_.siblings_.push_back( static_cast< const parallel_correlomatrix_detector* >( sibling ) );
+  }
+}
+
+void
+nest::parallel_correlomatrix_detector::prepare_buffers_()
+{
+  // delta_tau is an odd number of steps, so that no time difference
+  // falls on the border of two bins
+  const long delta_tau_steps = P_.delta_tau_.get_steps();
+  const long max_difference = P_.tau_max_.get_steps() + delta_tau_steps / 2;
+  V_.bins_.resize( max_difference + 1 );
+  for ( long d = 0; d <= max_difference; ++d )
+  {
+    V_.bins_[ d ] = ( 2 * d + delta_tau_steps ) / ( 2 * delta_tau_steps );
+  }
+
+  // The histograms are updated at the beginning of each slice for the
+  // steps of the previous slice, while spikes of the current slice may
+  // already arrive. The ring buffer thus has to hold the steps of two
+  // slices in addition to the correlation window.
+  const size_t num_slots = max_difference + 2 * kernel().connection_manager.get_min_delay() + 1;
+  if ( B_.steps_.size() != num_slots or B_.counts_.size() != num_slots * P_.N_channels_ )
+  {
+    B_.steps_.assign( num_slots, -1 );
+    B_.weights_.assign( num_slots * P_.N_channels_, 0.0 );
+    B_.squares_.assign( num_slots * P_.N_channels_, 0.0 );
+    B_.counts_.assign( num_slots * P_.N_channels_, 0 );
+  }
+}
+
+
+/* ----------------------------------------------------------------
+ * Other functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::parallel_correlomatrix_detector::update( Time const& origin, const long, const long )
+{
+  // Spikes are delivered to the device when they are emitted. All
+  // spikes with time stamps up to the slice origin have thus been
+  // delivered, while nodes on other threads may still emit spikes in
+  // the current slice.
+  update_histograms_( origin.get_steps() );
+}
+
+void
+nest::parallel_correlomatrix_detector::post_run_cleanup()
+{
+  update_histograms_( kernel().simulation_manager.get_time().get_steps() );
+}
+
+void
+nest::parallel_correlomatrix_detector::update_histograms_( const long step )
+{
+  for ( long s = S_.last_step_ + 1; s <= step; ++s )
+  {
+    add_pairs_( s );
+  }
+  S_.last_step_ = std::max( S_.last_step_, step );
+}
+
+void
+nest::parallel_correlomatrix_detector::add_pairs_( const long step )
+{
+  const long own_index = get_index_( step, 0 );
+  if ( own_index < 0 )
+  {
+    return; // no own spikes in this step
+  }
+
+  // only count pairs whose later spike is within [Tstart, Tstop]
+  const Time stamp = Time::step( step );
+  if ( not( P_.Tstart_ <= stamp and stamp <= P_.Tstop_ ) )
+  {
+    return;
+  }
+
+  const long N = P_.N_channels_;
+  const long num_slots = B_.steps_.size();
+  const thread own_thread = get_thread();
+
+  // all instances store a step in the same slot of their ring buffers
+  long slot = own_index / N;
+  for ( size_t d = 0; d < V_.bins_.size() and d <= static_cast< size_t >( step ); ++d )
+  {
+    const long other_step = step - d;
+    const long other_index = slot * N;
+    const size_t bin = V_.bins_[ d ];
+
+    for ( size_t t = 0; t < B_.siblings_.size(); ++t )
+    {
+      const parallel_correlomatrix_detector& other = *B_.siblings_[ t ];
+      if ( other.B_.steps_[ slot ] != other_step )
+      {
+        continue;
+      }
+
+      for ( long j = 0; j < N; ++j )
+      {
+        const long count_j = other.B_.counts_[ other_index + j ];
+        if ( count_j == 0 )
+        {
+          continue;
+        }
+        const double weight_j = other.B_.weights_[ other_index + j ];
+
+        for ( long i = 0; i < N; ++i )
+        {
+          const long count_i = B_.counts_[ own_index + i ];
+          if ( count_i == 0 )
+          {
+            continue;
+          }
+          const double weight_i = B_.weights_[ own_index + i ];
+
+          if ( d == 0 )
+          {
+            // Simultaneous spikes of different channels enter both
+            // entries C[i][j][0] and C[j][i][0]. The instance of each
+            // spike of the pair adds it to the entry of its own channel.
+            // Simultaneous spikes of the same channel, including each
+            // spike with itself, are counted once per pair: by the
+            // instance on the higher thread, or by the own instance for
+            // pairs of own spikes.
+            if ( i != j or static_cast< thread >( t ) < own_thread )
+            {
+              S_.covariance_[ i ][ j ][ 0 ] += weight_i * weight_j;
+              S_.count_covariance_[ i ][ j ][ 0 ] += count_i * count_j;
+            }
+            else if ( static_cast< thread >( t ) == own_thread )
+            {
+              S_.covariance_[ i ][ i ][ 0 ] += 0.5 * ( weight_i * weight_i + B_.squares_[ own_index + i ] );
+              S_.count_covariance_[ i ][ i ][ 0 ] += ( count_i * count_i + count_i ) / 2;
+            }
+          }
+          else
+          {
+            S_.covariance_[ i ][ j ][ bin ] += weight_i * weight_j;
+            S_.count_covariance_[ i ][ j ][ bin ] += count_i * count_j;
+            if ( bin == 0 )
+            {
+              S_.covariance_[ j ][ i ][ 0 ] += weight_i * weight_j;
+              S_.count_covariance_[ j ][ i ][ 0 ] += count_i * count_j;
+            }
+          }
+        }
+      }
+    }
+
+    slot = slot > 0 ? slot - 1 : num_slots - 1;
+  }
+}
+
+void
+nest::parallel_correlomatrix_detector::handle( SpikeEvent& e )
+{
+  // The receiver port identifies the sending node in our
+  // sender list.
+  const rport channel = e.get_rport();
+
+  // If this assertion breaks, the sender does not honor the
+  // receiver port during connection or sending.
+  assert( 0 <= channel && channel <= P_.N_channels_ - 1 );
+
+  // accept spikes only if detector was active when spike was emitted
+  Time const stamp = e.get_stamp();
+  if ( not device_.is_active( stamp ) )
+  {
+    return;
+  }
+
+  const long step = stamp.get_steps();
+  const size_t slot = step % B_.steps_.size();
+  if ( B_.steps_[ slot ] != step )
+  {
+    B_.steps_[ slot ] = step;
+    std::fill_n( B_.weights_.begin() + slot * P_.N_channels_, P_.N_channels_, 0.0 );
+    std::fill_n( B_.squares_.begin() + slot * P_.N_channels_, P_.N_channels_, 0.0 );
+    std::fill_n( B_.counts_.begin() + slot * P_.N_channels_, P_.N_channels_, 0 );
+  }
+
+  const size_t index = slot * P_.N_channels_ + channel;
+  // a spike with multiplicity m enters as m spikes
+  const double weight = e.get_weight();
+  B_.weights_[ index ] += e.get_multiplicity() * weight;
+  B_.squares_[ index ] += e.get_multiplicity() * weight * weight;
+  B_.counts_[ index ] += e.get_multiplicity();
+
+  if ( P_.Tstart_ <= stamp && stamp <= P_.Tstop_ )
+  {
+    S_.n_events_[ channel ] += e.get_multiplicity(); // count these spikes
+  }
+}
+
+void
+nest::parallel_correlomatrix_detector::get_status( DictionaryDatum& d ) const
+{
+  device_.get_status( d );
+  P_.get( d );
+
+  if ( get_node_id() == 0 ) // this is a model prototype, not an actual instance
+  {
+    S_.get( d );
+    return;
+  }
+
+  // the histograms of all threads are reported by the device on thread 0
+  if ( get_thread() == 0 )
+  {
+    State_ sum = S_;
+    const std::vector< Node* > siblings = kernel().node_manager.get_thread_siblings( get_node_id() );
+    for ( auto sibling : siblings )
+    {
+      if ( sibling == this )
+      {
+        continue;
+      }
+
+      const State_& S = static_cast< const parallel_correlomatrix_detector* >( sibling )->S_;
+      for ( long i = 0; i < P_.N_channels_; ++i )
+      {
+        sum.n_events_[ i ] += S.n_events_[ i ];
+        for ( long j = 0; j < P_.N_channels_; ++j )
+        {
+          std::transform( S.covariance_[ i ][ j ].begin(),
+            S.covariance_[ i ][ j ].end(),
+            sum.covariance_[ i ][ j ].begin(),
+            sum.covariance_[ i ][ j ].begin(),
+            std::plus< double >() );
+          std::transform( S.count_covariance_[ i ][ j ].begin(),
+            S.count_covariance_[ i ][ j ].end(),
+            sum.count_covariance_[ i ][ j ].begin(),
+            sum.count_covariance_[ i ][ j ].begin(),
+            std::plus< long >() );
+        }
+      }
+    }
+    sum.get( d );
+  }
+}
@@ -0,0 +1,353 @@
+/*
+ *  parallel_correlomatrix_detector.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PARALLEL_CORRELOMATRIX_DETECTOR_H
+#define PARALLEL_CORRELOMATRIX_DETECTOR_H
+
+
+// C++ includes:
+#include <vector>
+
+// Includes from nestkernel:
+#include "device_node.h"
+#include "event.h"
+#include "nest_timeconverter.h"
+#include "nest_types.h"
+#include "pseudo_recording_device.h"
+
+
+namespace nest
+{
+
+/* BeginUserDocs: device, detector
+
+Short description
++++++++++++++++++
+
+Device for measuring the covariance matrix from several inputs using all threads
+
+Description
++++++++++++
+
+The parallel_correlomatrix_detector computes the same covariance
+matrices as the correlomatrix_detector, but distributes the work over
+all threads of the simulation. Please see the documentation of the
+correlomatrix_detector for the meaning of the parameters and of the
+recorded histograms.
+
+The correlomatrix_detector is a single node on one thread, which
+receives the spikes of all sources and compares every incoming spike
+with all spikes it has received within the correlation window. In
+contrast, the parallel_correlomatrix_detector has an instance on every
+thread, which only receives the spikes of the sources on its own
+thread. Each instance sums the weights and counts of the spikes of its
+sources per channel and time step. Once all spikes of a time step have
+been delivered, each instance adds the contributions of its own spikes
+in that step to a partial histogram, by multiplying them with the summed
+weights and counts of all instances in the preceding steps of the
+correlation window. GetStatus returns the sum of the partial
+histograms of all threads. The cost per time step with spikes is thus
+independent of the number of spikes in the correlation window, and all
+threads share the work.
+
+A spike with multiplicity m counts as m spikes in count_covariance,
+so that the counts agree with those of the correlomatrix_detector if
+all spikes have multiplicity 1. The histogram of the
+correlation_detector is obtained from a parallel_correlomatrix_detector
+with two channels as ``C[0][1][::-1] + C[1][0][1:]``, if the bins are
+concatenated.
+
+The histograms are updated at the beginning of each min_delay interval
+and at the end of each call to Run, so that they are complete up to
+the current simulation time whenever they can be read. In contrast to
+the correlomatrix_detector, the device receives spikes immediately when
+they are emitted, and not only at the end of the min_delay interval.
+After a call to Run that ends within a min_delay interval, the
+histograms of the parallel_correlomatrix_detector thus already contain
+the spikes of that interval, while those of the
+correlomatrix_detector do not.
+
+.. note::
+
+   Only sources on the local MPI process are covered, as the instances
+   of the device on different processes do not exchange spikes. In
+   simulations with several MPI processes, use the
+   correlomatrix_detector instead.
+
+Parameters
+++++++++++
+
+================ ========= ====================================================
+Tstart           real      Time when to start counting events.
+Tstop            real      Time when to stop counting events.
+delta_tau        ms        Bin width. This has to be an odd multiple of
+                           the resolution.
+tau_max          ms        One-sided width of the histograms.
+N_channels       integer   The number of pools. This defines the range of
+                           receptor_type. Default is 1.
+                           Setting N_channels clears count_covariance,
+                           covariance and n_events.
+covariance       3D        matrix of read-only -raw, weighted, auto/cross
+                 matrix of correlation
+                 reals
+count_covariance 3D        matrix of read-only -raw, auto/cross correlation
+                 matrix of counts
+                 integers
+n_events         list of   number of events from all sources
+                 integers
+================ ========= ====================================================
+
+Receives
+++++++++
+
+SpikeEvent
+
+See also
+++++++++
+
+correlomatrix_detector, correlation_detector, spike_recorder
+
+EndUserDocs */
+
+/**
+ * Thread-parallel version of the correlomatrix_detector.
+ *
+ * There is one instance of the device on each thread. In handle(), an
+ * instance only sums the spikes of its sources per time step in a ring
+ * buffer. The histograms are updated in update() and post_run_cleanup(),
+ * where all spikes up to the slice origin or the current time,
+ * respectively, have been delivered and no instance writes to the
+ * buffer entries of these steps. Each
+ * instance reads the ring buffers of all its thread siblings and adds
+ * the pairs whose later spike stems from its own sources to its own
+ * histograms. The instance on thread 0 sums the histograms of all
+ * instances in get_status().
+ */
+class parallel_correlomatrix_detector : public DeviceNode
+{
+
+public:
+  parallel_correlomatrix_detector();
+  parallel_correlomatrix_detector( const parallel_correlomatrix_detector& );
+
+  bool
+  has_proxies() const
+  {
+    return false;
+  }
+
+  bool
+  local_receiver() const
+  {
+    return true;
+  }
+
+  Name
+  get_element_type() const
+  {
+    return names::recorder;
+  }
+
+  /**
+   * Import sets of overloaded virtual functions.
+   * @see Technical Issues / Virtual Functions: Overriding, Overloading, and
+   * Hiding
+   */
+  using Node::handle;
+  using Node::handles_test_event;
+
+  void handle( SpikeEvent& );
+
+  port handles_test_event( SpikeEvent&, rport );
+
+  void get_status( DictionaryDatum& ) const;
+  void set_status( const DictionaryDatum& );
+
+  void calibrate_time( const TimeConverter& tc );
+
+  void post_run_cleanup();
+
+private:
+  void init_state_( Node const& );
+  void init_buffers_();
+  void calibrate();
+
+  void update( Time const&, const long, const long );
+
+  //! Add the pairs of all steps up to and including step to the histograms
+  void update_histograms_( long step );
+
+  //! Add the pairs whose later spike is one of the own spikes in step
+  void add_pairs_( long step );
+
+  //! Compute the histogram bins and size the ring buffer for the current parameters and min_delay
+  void prepare_buffers_();
+
+  // ------------------------------------------------------------
+
+  struct Parameters_
+  {
+    Time delta_tau_;  //!< width of correlation histogram bins
+    Time tau_max_;    //!< maximum time difference of events to detect
+    Time Tstart_;     //!< start of recording
+    Time Tstop_;      //!< end of recording
+    long N_channels_; //!< number of channels
+
+    Parameters_();                     //!< Sets default parameter values
+    Parameters_( const Parameters_& ); //!< Recalibrate all times
+
+    Parameters_& operator=( const Parameters_& );
+
+    void get( DictionaryDatum& ) const; //!< Store current values in dictionary
+
+    /**
+     * Set values from dicitonary.
+     * @returns true if the state needs to be reset after a change of
+     *          binwidth or tau_max.
+     */
+    bool set( const DictionaryDatum&, const parallel_correlomatrix_detector&, Node* node );
+  };
+
+  // ------------------------------------------------------------
+
+  /**
+   * @note Constructed with empty structures, which are set to
+   *       proper sizes by init_buffers_().
+   * @note State_ only contains read-out values, so we copy-construct
+   *       using the default c'tor.
+   */
+  struct State_
+  {
+    std::vector< long > n_events_; //!< spike counters
+    /** Weighted covariance matrix.
+     *  @note Data type is double to accomodate weights.
+     */
+    std::vector< std::vector< std::vector< double > > > covariance_;
+
+    /** Unweighted covariance matrix.
+     */
+    std::vector< std::vector< std::vector< long > > > count_covariance_;
+
+    long last_step_; //!< last step whose pairs have been added to the histograms
+
+    State_(); //!< initialize default state
+
+    void get( DictionaryDatum& ) const;
+
+    void reset( const Parameters_& );
+  };
+
+  // ------------------------------------------------------------
+
+  /**
+   * Spikes of the own sources, summed per channel and step.
+   *
+   * The entries for step s are stored in slot s % steps_.size() of the
+   * ring buffer, which is cleared when it is first written for s.
+   */
+  struct Buffers_
+  {
+    std::vector< long > steps_;      //!< step stored in each slot, -1 if none
+    std::vector< double > weights_;  //!< sum of weights per slot and channel
+    std::vector< double > squares_;  //!< sum of squared weights per slot and channel
+    std::vector< long > counts_;     //!< number of spikes per slot and channel
+
+    //! instances of the device on all threads, indexed by thread
+    std::vector< const parallel_correlomatrix_detector* > siblings_;
+
+    void clear();
+  };
+
+  // ------------------------------------------------------------
+
+  struct Variables_
+  {
+    //! histogram bin of each time difference in steps within the correlation window
+    std::vector< size_t > bins_;
+  };
+
+  // ------------------------------------------------------------
+
+  //! Index of the entry for channel in the ring buffer slot of step, -1 if there is none
+  long get_index_( long step, long channel ) const;
+
+  PseudoRecordingDevice device_;
+  Parameters_ P_;
+  State_ S_;
+  Variables_ V_;
+  Buffers_ B_;
+};
+
+inline port
+parallel_correlomatrix_detector::handles_test_event( SpikeEvent&, rport receptor_type )
+{
+  if ( receptor_type < 0 || receptor_type > P_.N_channels_ - 1 )
+  {
+    throw UnknownReceptorType( receptor_type, get_name() );
+  }
+  return receptor_type;
+}
+
+inline void
+nest::parallel_correlomatrix_detector::set_status( const DictionaryDatum& d )
+{
+  Parameters_ ptmp = P_;
+  const bool reset_required = ptmp.set( d, *this, this );
+
+  device_.set_status( d );
+  P_ = ptmp;
+  if ( reset_required == true )
+  {
+    S_.reset( P_ );
+    prepare_buffers_();
+    B_.clear();
+  }
+}
+
+inline void
+nest::parallel_correlomatrix_detector::calibrate_time( const TimeConverter& tc )
+{
+  P_.delta_tau_ = tc.from_old_tics( P_.delta_tau_.get_tics() );
+  P_.tau_max_ = tc.from_old_tics( P_.tau_max_.get_tics() );
+  P_.Tstart_ = tc.from_old_tics( P_.Tstart_.get_tics() );
+  P_.Tstop_ = tc.from_old_tics( P_.Tstop_.get_tics() );
+}
+
+inline long
+nest::parallel_correlomatrix_detector::get_index_( const long step, const long channel ) const
+{
+  if ( step < 0 )
+  {
+    return -1;
+  }
+  const size_t slot = step % B_.steps_.size();
+  if ( B_.steps_[ slot ] != step )
+  {
+    return -1;
+  }
+  return slot * P_.N_channels_ + channel;
+}
+
+
+} // namespace
+
+#endif /* #ifndef PARALLEL_CORRELOMATRIX_DETECTOR_H */
@@ -118,11 +118,11 @@ private:
 
   /**
      Buffers and accumulates the number of incoming spikes per time step;
-     RingBuffer stores doubles; for now the numbers are casted.
+     CompactRingBuffer stores doubles; for now the numbers are casted.
   */
   struct Buffers_
   {
-    RingBuffer n_spikes_;
+    CompactRingBuffer n_spikes_;
   };
 
   Buffers_ B_;
@@ -41,13 +41,70 @@
 #include "doubledatum.h"
 #include "integerdatum.h"
 
+nest::spike_recorder::Parameters_::Parameters_()
+  : senders_()
+{
+}
+
+void
+nest::spike_recorder::Parameters_::get( DictionaryDatum& d ) const
+{
+  if ( senders_.get() )
+  {
+    ( *d )[ names::senders ] = senders_;
+  }
+  else
+  {
+    ArrayDatum ad;
+    ( *d )[ names::senders ] = ad;
+  }
+}
+
+void
+nest::spike_recorder::Parameters_::set( const DictionaryDatum& d )
+{
+  if ( d->known( names::senders ) )
+  {
+    const Token& tkn = d->lookup( names::senders );
+    if ( tkn.is_a< NodeCollectionDatum >() )
+    {
+      senders_ = getValue< NodeCollectionDatum >( tkn );
+    }
+    else
+    {
+      if ( tkn.is_a< IntVectorDatum >() )
+      {
+        IntVectorDatum ivd = getValue< IntVectorDatum >( tkn );
+        senders_ = NodeCollection::create( ivd );
+      }
+      if ( tkn.is_a< ArrayDatum >() )
+      {
+        ArrayDatum ad = getValue< ArrayDatum >( tkn );
+        senders_ = NodeCollection::create( ad );
+      }
+    }
+
+    // spikes of nodes without proxies are only delivered locally
+    for ( auto it = senders_->begin(); it < senders_->end(); ++it )
+    {
+      if ( not kernel().model_manager.get_model( ( *it ).model_id )->has_proxies() )
+      {
+        throw BadProperty( String::compose(
+          "Node %1 cannot be recorded via senders. Please connect it to the spike recorder.", ( *it ).node_id ) );
+      }
+    }
+  }
+}
+
 nest::spike_recorder::spike_recorder()
   : RecordingDevice()
+  , P_()
 {
 }
 
 nest::spike_recorder::spike_recorder( const spike_recorder& n )
   : RecordingDevice( n )
+  , P_( n.P_ )
 {
 }
 
@@ -55,6 +112,30 @@ void
 nest::spike_recorder::calibrate()
 {
   RecordingDevice::calibrate( RecordingBackend::NO_DOUBLE_VALUE_NAMES, RecordingBackend::NO_LONG_VALUE_NAMES );
+
+  B_.recorded_lids_.clear();
+  if ( not P_.senders_.get() or P_.senders_->size() == 0 )
+  {
+    kernel().event_delivery_manager.unregister_spike_recorder( get_thread(), *this );
+    return;
+  }
+
+  for ( auto it = P_.senders_->begin(); it < P_.senders_->end(); ++it )
+  {
+    const index node_id = ( *it ).node_id;
+    if ( kernel().vp_manager.is_node_id_vp_local( node_id )
+      and kernel().vp_manager.vp_to_thread( kernel().vp_manager.node_id_to_vp( node_id ) ) == get_thread() )
+    {
+      const index lid = kernel().vp_manager.node_id_to_lid( node_id );
+      if ( lid >= B_.recorded_lids_.size() )
+      {
+        B_.recorded_lids_.resize( lid + 1, false );
+      }
+      B_.recorded_lids_[ lid ] = true;
+    }
+  }
+
+  kernel().event_delivery_manager.register_spike_recorder( get_thread(), *this );
 }
 
 void
@@ -73,6 +154,7 @@ void
 nest::spike_recorder::get_status( DictionaryDatum& d ) const
 {
   RecordingDevice::get_status( d );
+  P_.get( d );
 
   if ( is_model_prototype() )
   {
@@ -94,7 +176,13 @@ nest::spike_recorder::get_status( DictionaryDatum& d ) const
 void
 nest::spike_recorder::set_status( const DictionaryDatum& d )
 {
+  Parameters_ ptmp = P_; // temporary copy in case of errors
+  ptmp.set( d );         // throws if BadProperty
+
   RecordingDevice::set_status( d );
+
+  // if we get here, temporaries contain consistent set of properties
+  P_ = ptmp;
 }
 
 void
@@ -111,3 +199,49 @@ nest::spike_recorder::handle( SpikeEvent& e )
     }
   }
 }
+
+void
+nest::spike_recorder::record_emitted_spikes( const std::vector< EmittedSpike >& spikes )
+{
+  const Time& origin = kernel().simulation_manager.get_slice_origin();
+
+  for ( const auto& spike : spikes )
+  {
+    const index lid = kernel().vp_manager.node_id_to_lid( spike.node_id_ );
+    if ( lid >= B_.recorded_lids_.size() or not B_.recorded_lids_[ lid ] )
+    {
+      continue;
+    }
+
+    // spikes are stamped as in EventDeliveryManager::send()
+    const Time stamp = origin + Time::step( spike.lag_ + 1 );
+    if ( not is_active( stamp ) )
+    {
+      continue;
+    }
+
+    // each spike of a multiplicity is recorded separately
+    B_.spike_senders_.insert( B_.spike_senders_.end(), spike.multiplicity_, spike.node_id_ );
+    B_.spike_stamps_.insert( B_.spike_stamps_.end(), spike.multiplicity_, stamp );
+    B_.spike_offsets_.insert( B_.spike_offsets_.end(), spike.multiplicity_, spike.offset_ );
+  }
+
+  if ( B_.spike_senders_.empty() )
+  {
+    return;
+  }
+
+  const RecordBatch batch( B_.spike_senders_.size(),
+    B_.spike_senders_.data(),
+    B_.spike_stamps_.data(),
+    B_.spike_offsets_.data(),
+    0,
+    nullptr,
+    0,
+    nullptr );
+  write_batch( batch );
+
+  B_.spike_senders_.clear();
+  B_.spike_stamps_.clear();
+  B_.spike_offsets_.clear();
+}
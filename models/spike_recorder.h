@@ -31,6 +31,7 @@
 #include "event.h"
 #include "exceptions.h"
 #include "nest_types.h"
+#include "nest_datums.h"
 #include "recording_device.h"
 
 /* BeginUserDocs: device, recorder, spike
@@ -64,6 +65,30 @@ spike creation rather than that of their arrival.
 The call to ``Connect`` will fail if the connection direction is
 reversed (i.e., connecting *sr* to *neurons*).
 
+For large populations, connecting every node to the spike recorder
+creates one connection per node and makes the spike recorder handle
+every spike individually. Instead, the nodes can be passed to the spike
+recorder in its parameter ``senders``:
+
+::
+
+   >>> sr = nest.Create('spike_recorder', params={'senders': neurons})
+
+The spike recorder then records all spikes emitted by these nodes
+without any connections. The spikes are taken directly from the
+kernel in bulk at the end of each update step. Only the spikes of
+nodes that can be connected to nodes on other processes, i.e., mostly
+neurons, can be recorded in this way. A node that is also connected to
+the spike recorder is recorded twice.
+
+Parameters
+++++++++++
+
+senders
+    A NodeCollection with the nodes whose spikes are recorded without
+    connections. It can only be set outside of a Prepare/Run/Cleanup
+    context.
+
 EndUserDocs */
 
 namespace nest
@@ -117,9 +142,34 @@ public:
   void get_status( DictionaryDatum& ) const;
   void set_status( const DictionaryDatum& );
 
+  void record_emitted_spikes( const std::vector< EmittedSpike >& );
+
 private:
   void calibrate();
   void update( Time const&, const long, const long );
+
+  struct Parameters_
+  {
+    NodeCollectionDatum senders_; //!< nodes recorded without connections
+
+    Parameters_();
+    void get( DictionaryDatum& ) const;
+    void set( const DictionaryDatum& );
+  };
+
+  struct Buffers_
+  {
+    //! Flags for the local IDs of the nodes in senders_ on the thread of the device
+    std::vector< bool > recorded_lids_;
+
+    //! Emitted spikes of the current slice, collected to be written as one batch
+    std::vector< index > spike_senders_;
+    std::vector< Time > spike_stamps_;
+    std::vector< double > spike_offsets_;
+  };
+
+  Parameters_ P_;
+  Buffers_ B_;
 };
 
 inline port
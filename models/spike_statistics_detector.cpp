@@ -0,0 +1,377 @@
+/*
+ *  spike_statistics_detector.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spike_statistics_detector.h"
+
+// C++ includes:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// Includes from nestkernel:
+#include "dict_util.h"
+#include "kernel_manager.h"
+
+// Includes from sli:
+#include "dict.h"
+#include "dictutils.h"
+
+
+/* ----------------------------------------------------------------
+ * Default constructors defining default parameters and state
+ * ---------------------------------------------------------------- */
+
+nest::spike_statistics_detector::SourceStatistics_::SourceStatistics_()
+  : n_spikes_( 0 )
+  , last_spike_( 0.0 )
+  , isi_mean_( 0.0 )
+  , isi_m2_( 0.0 )
+{
+}
+
+nest::spike_statistics_detector::Parameters_::Parameters_()
+  : bin_width_( Time::ms( 10.0 ) )
+{
+}
+
+nest::spike_statistics_detector::Parameters_::Parameters_( const Parameters_& p )
+  : bin_width_( p.bin_width_ )
+{
+  // Check for proper properties is not done here but in the
+  // spike_statistics_detector() copy c'tor, see correlation_detector.
+  bin_width_.calibrate();
+}
+
+nest::spike_statistics_detector::Parameters_& nest::spike_statistics_detector::Parameters_::operator=(
+  const Parameters_& p )
+{
+  bin_width_ = p.bin_width_;
+  bin_width_.calibrate();
+
+  return *this;
+}
+
+nest::spike_statistics_detector::State_::State_()
+  : n_events_( 0 )
+  , reset_time_( Time::step( 0 ) )
+  , sources_()
+  , statistics_()
+  , indices_()
+  , population_histogram_()
+{
+}
+
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::spike_statistics_detector::Parameters_::get( DictionaryDatum& d ) const
+{
+  ( *d )[ names::bin_width ] = bin_width_.get_ms();
+}
+
+bool
+nest::spike_statistics_detector::Parameters_::set( const DictionaryDatum& d,
+  const spike_statistics_detector& n,
+  Node* node )
+{
+  bool reset = false;
+  double t;
+  if ( updateValueParam< double >( d, names::bin_width, t, node ) )
+  {
+    bin_width_ = Time::ms( t );
+    reset = true;
+  }
+
+  if ( not bin_width_.is_step() or bin_width_.get_steps() <= 0 )
+  {
+    throw StepMultipleRequired( n.get_name(), names::bin_width, bin_width_ );
+  }
+
+  return reset;
+}
+
+void
+nest::spike_statistics_detector::State_::set( const DictionaryDatum& d, bool reset_required, Node* )
+{
+  long n_events;
+  if ( updateValue< long >( d, names::n_events, n_events ) )
+  {
+    if ( n_events != 0 )
+    {
+      throw BadProperty( "Property n_events can only be set to 0 (which resets the statistics)." );
+    }
+    reset_required = true;
+  }
+
+  if ( reset_required )
+  {
+    reset();
+  }
+}
+
+void
+nest::spike_statistics_detector::State_::reset()
+{
+  n_events_ = 0;
+  reset_time_ = kernel().simulation_manager.get_time();
+  sources_.clear();
+  statistics_.clear();
+  indices_.clear();
+  population_histogram_.clear();
+}
+
+
+/* ----------------------------------------------------------------
+ * Default and copy constructor for node
+ * ---------------------------------------------------------------- */
+
+nest::spike_statistics_detector::spike_statistics_detector()
+  : DeviceNode()
+  , device_()
+  , P_()
+  , S_()
+{
+  if ( not P_.bin_width_.is_step() )
+  {
+    throw InvalidDefaultResolution( get_name(), names::bin_width, P_.bin_width_ );
+  }
+}
+
+nest::spike_statistics_detector::spike_statistics_detector( const spike_statistics_detector& n )
+  : DeviceNode( n )
+  , device_( n.device_ )
+  , P_( n.P_ )
+  , S_()
+{
+  if ( not P_.bin_width_.is_step() )
+  {
+    throw InvalidTimeInModel( get_name(), names::bin_width, P_.bin_width_ );
+  }
+}
+
+
+/* ----------------------------------------------------------------
+ * Node initialization functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::spike_statistics_detector::init_state_( const Node& proto )
+{
+  const spike_statistics_detector& pr = downcast< spike_statistics_detector >( proto );
+
+  device_.init_state( pr.device_ );
+  S_ = pr.S_;
+  set_buffers_initialized( false ); // force recreation of buffers
+}
+
+void
+nest::spike_statistics_detector::init_buffers_()
+{
+  device_.init_buffers();
+  S_.reset();
+}
+
+void
+nest::spike_statistics_detector::calibrate()
+{
+  device_.calibrate();
+}
+
+
+/* ----------------------------------------------------------------
+ * Other functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::spike_statistics_detector::update( Time const&, const long, const long )
+{
+}
+
+nest::Time
+nest::spike_statistics_detector::get_observation_start_() const
+{
+  return std::max( device_.get_origin() + device_.get_start(), S_.reset_time_ );
+}
+
+void
+nest::spike_statistics_detector::SourceStatistics_::add_spike( const double t )
+{
+  if ( n_spikes_ > 0 )
+  {
+    // Welford's update of mean and sum of squared deviations; the
+    // number of ISIs including the new one equals the previous number
+    // of spikes
+    const double isi = t - last_spike_;
+    const double delta = isi - isi_mean_;
+    isi_mean_ += delta / n_spikes_;
+    isi_m2_ += delta * ( isi - isi_mean_ );
+  }
+
+  last_spike_ = t;
+  ++n_spikes_;
+}
+
+void
+nest::spike_statistics_detector::handle( SpikeEvent& e )
+{
+  // accept spikes only if detector was active when spike was emitted
+  Time const stamp = e.get_stamp();
+  if ( not device_.is_active( stamp ) or stamp <= S_.reset_time_ )
+  {
+    return;
+  }
+
+  const index sender = e.get_sender_node_id();
+  auto it = S_.indices_.find( sender );
+  if ( it == S_.indices_.end() )
+  {
+    it = S_.indices_.insert( std::make_pair( sender, S_.sources_.size() ) ).first;
+    S_.sources_.push_back( sender );
+    S_.statistics_.push_back( SourceStatistics_() );
+  }
+
+  const long multiplicity = e.get_multiplicity();
+  const double t = stamp.get_ms() - e.get_offset();
+  SourceStatistics_& statistics = S_.statistics_[ it->second ];
+  for ( long i = 0; i < multiplicity; ++i )
+  {
+    statistics.add_spike( t );
+  }
+
+  // bin k contains the time steps ( t0 + k * bin_width, t0 + ( k + 1 ) * bin_width ]
+  const size_t bin = ( stamp.get_steps() - get_observation_start_().get_steps() - 1 ) / P_.bin_width_.get_steps();
+  if ( bin >= S_.population_histogram_.size() )
+  {
+    S_.population_histogram_.resize( bin + 1, 0 );
+  }
+  S_.population_histogram_[ bin ] += multiplicity;
+
+  S_.n_events_ += multiplicity;
+}
+
+void
+nest::spike_statistics_detector::get_status( DictionaryDatum& d ) const
+{
+  device_.get_status( d );
+  P_.get( d );
+
+  if ( get_node_id() == 0 ) // this is a model prototype, not an actual instance
+  {
+    ( *d )[ names::n_events ] = S_.n_events_;
+    return;
+  }
+
+  // the statistics of all threads are reported by the device on thread 0
+  if ( get_thread() == 0 )
+  {
+    get_statistics_( d );
+  }
+}
+
+void
+nest::spike_statistics_detector::get_statistics_( DictionaryDatum& d ) const
+{
+  const Time t0 = get_observation_start_();
+  const Time t_end = std::min( device_.get_origin() + device_.get_stop(), kernel().simulation_manager.get_time() );
+  const double duration = std::max( 0.0, ( t_end - t0 ).get_ms() );
+
+  // collect the statistics of all siblings ordered by node ID
+  std::vector< std::pair< index, const SourceStatistics_* > > statistics;
+  std::vector< long > population_histogram;
+  long n_events = 0;
+
+  const std::vector< Node* > siblings = kernel().node_manager.get_thread_siblings( get_node_id() );
+  for ( auto sibling : siblings )
+  {
+    const State_& S = static_cast< const spike_statistics_detector* >( sibling )->S_;
+    for ( size_t i = 0; i < S.sources_.size(); ++i )
+    {
+      statistics.push_back( std::make_pair( S.sources_[ i ], &S.statistics_[ i ] ) );
+    }
+
+    if ( S.population_histogram_.size() > population_histogram.size() )
+    {
+      population_histogram.resize( S.population_histogram_.size(), 0 );
+    }
+    std::transform( S.population_histogram_.begin(),
+      S.population_histogram_.end(),
+      population_histogram.begin(),
+      population_histogram.begin(),
+      std::plus< long >() );
+
+    n_events += S.n_events_;
+  }
+  std::sort( statistics.begin(), statistics.end() );
+
+  const double nan = std::numeric_limits< double >::quiet_NaN();
+  std::vector< long >* senders = new std::vector< long >();
+  std::vector< long >* n_spikes = new std::vector< long >();
+  std::vector< double >* rates = new std::vector< double >();
+  std::vector< double >* isi_mean = new std::vector< double >();
+  std::vector< double >* isi_variance = new std::vector< double >();
+  std::vector< double >* cv = new std::vector< double >();
+  for ( const auto& entry : statistics )
+  {
+    const SourceStatistics_& s = *entry.second;
+    const long n_isi = s.n_spikes_ - 1;
+    const double mean = n_isi > 0 ? s.isi_mean_ : nan;
+    const double variance = n_isi > 0 ? s.isi_m2_ / n_isi : nan;
+
+    senders->push_back( entry.first );
+    n_spikes->push_back( s.n_spikes_ );
+    rates->push_back( duration > 0 ? 1000.0 * s.n_spikes_ / duration : nan );
+    isi_mean->push_back( mean );
+    isi_variance->push_back( variance );
+    cv->push_back( std::sqrt( variance ) / mean );
+  }
+
+  // only bins that have ended enter histogram and Fano factor
+  const size_t n_bins = std::max< long >( 0, ( t_end - t0 ).get_steps() ) / P_.bin_width_.get_steps();
+  population_histogram.resize( n_bins, 0 );
+
+  double fano_factor = nan;
+  if ( n_bins > 0 )
+  {
+    const double sum = std::accumulate( population_histogram.begin(), population_histogram.end(), 0.0 );
+    const double sum_squares =
+      std::inner_product( population_histogram.begin(), population_histogram.end(), population_histogram.begin(), 0.0 );
+    const double mean = sum / n_bins;
+    if ( mean > 0 )
+    {
+      fano_factor = ( sum_squares / n_bins - mean * mean ) / mean;
+    }
+  }
+
+  ( *d )[ names::n_events ] = n_events;
+  ( *d )[ names::senders ] = IntVectorDatum( senders );
+  ( *d )[ names::n_spikes ] = IntVectorDatum( n_spikes );
+  ( *d )[ names::rates ] = DoubleVectorDatum( rates );
+  ( *d )[ names::isi_mean ] = DoubleVectorDatum( isi_mean );
+  ( *d )[ names::isi_variance ] = DoubleVectorDatum( isi_variance );
+  ( *d )[ names::cv ] = DoubleVectorDatum( cv );
+  ( *d )[ names::population_histogram ] = IntVectorDatum( new std::vector< long >( population_histogram ) );
+  ( *d )[ names::fano_factor ] = fano_factor;
+}
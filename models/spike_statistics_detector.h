@@ -0,0 +1,308 @@
+/*
+ *  spike_statistics_detector.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SPIKE_STATISTICS_DETECTOR_H
+#define SPIKE_STATISTICS_DETECTOR_H
+
+
+// C++ includes:
+#include <unordered_map>
+#include <vector>
+
+// Includes from nestkernel:
+#include "device_node.h"
+#include "event.h"
+#include "nest_timeconverter.h"
+#include "nest_types.h"
+#include "pseudo_recording_device.h"
+
+
+namespace nest
+{
+
+/* BeginUserDocs: device, detector, spike
+
+Short description
++++++++++++++++++
+
+Device for computing firing statistics of spike sources on-line
+
+Description
++++++++++++
+
+The spike_statistics_detector collects running statistics of the spikes
+it receives instead of storing the spikes themselves. It is meant for
+monitoring long simulations, in which only firing rates and the
+regularity of the spike trains are of interest, so that recording all
+spikes and analysing them afterwards would be wasteful.
+
+For each spike source that is connected to the device and has fired at
+least once, the device keeps the number of spikes, the time of the last
+spike and the mean and variance of the inter-spike intervals (ISIs).
+The latter are updated with every spike using Welford's algorithm. In
+addition, the spikes of all sources are counted in a population
+histogram with bins of width ``bin_width``. Apart from the histogram,
+which grows with the simulated time, the memory needed by the device
+is proportional to the number of sources.
+
+The statistics can be read via GetStatus at any time. They cover the
+observation period, which starts at ``origin + start`` or at the last
+reset of the statistics, whichever is later, and ends at the current
+simulation time or at ``origin + stop``, whichever is earlier. The
+statistics are reset by setting ``n_events`` to 0.
+
+::
+
+   >>> neurons = nest.Create('iaf_psc_alpha', 100, params={'I_e': 400.})
+   >>> ssd = nest.Create('spike_statistics_detector', params={'bin_width': 5.})
+   >>> nest.Connect(neurons, ssd)
+   >>> nest.Simulate(1000.)
+   >>> ssd.get(['senders', 'rates', 'cv', 'fano_factor'])
+
+Like the spike_recorder, the device records the time of spike
+creation and ignores the connection weights and delays. It assumes
+that the spikes of each source arrive in the order of their creation.
+
+Only spike sources on the local MPI process are covered by the
+statistics read on that process.
+
+Parameters
+++++++++++
+
+==================== ======== ==================================================
+bin_width            ms       Width of the bins of the population histogram.
+                              This has to be a multiple of the resolution.
+                              Setting bin_width resets the statistics.
+n_events             integer  Total number of spikes counted. By setting
+                              n_events to 0, the statistics are reset.
+senders              list of  read-only - Node IDs of all sources that have
+                     integers fired during the observation period, in
+                              ascending order. All per-source statistics are
+                              listed in this order.
+n_spikes             list of  read-only - Number of spikes of each source
+                     integers
+rates                list of  read-only - Firing rate of each source in spikes
+                     reals    per second
+isi_mean             list of  read-only - Mean ISI of each source in ms, NaN
+                     reals    for sources with less than two spikes
+isi_variance         list of  read-only - Variance of the ISIs of each source
+                     reals    in ms^2, NaN for sources with less than two
+                              spikes
+cv                   list of  read-only - Coefficient of variation of the ISIs
+                     reals    of each source, i.e., the standard deviation
+                              divided by the mean, NaN for sources with less
+                              than two spikes
+population_histogram list of  read-only - Number of spikes of all sources in
+                     integers each bin of the observation period that has
+                              ended. Bin k contains the spikes with times in
+                              (t0 + k * bin_width, t0 + (k + 1) * bin_width],
+                              where t0 is the start of the observation period.
+fano_factor          real     read-only - Variance of the spike counts in the
+                              bins of population_histogram divided by their
+                              mean, NaN if there are no spikes in these bins
+==================== ======== ==================================================
+
+All variances are computed as mean squared deviation from the mean,
+i.e., they are normalized by the number of values.
+
+Receives
+++++++++
+
+SpikeEvent
+
+See also
+++++++++
+
+spike_recorder, correlation_detector
+
+EndUserDocs */
+
+/**
+ * Device computing running statistics of the spikes of its sources.
+ *
+ * There is one instance of the device on each thread, which receives the
+ * spikes of the sources on that thread. As each source lives on exactly
+ * one thread, the per-source statistics of the instances are disjoint.
+ * The instance on thread 0 combines the statistics of all instances in
+ * get_status().
+ */
+class spike_statistics_detector : public DeviceNode
+{
+
+public:
+  spike_statistics_detector();
+  spike_statistics_detector( const spike_statistics_detector& );
+
+  bool
+  has_proxies() const
+  {
+    return false;
+  }
+
+  bool
+  local_receiver() const
+  {
+    return true;
+  }
+
+  Name
+  get_element_type() const
+  {
+    return names::recorder;
+  }
+
+  /**
+   * Import sets of overloaded virtual functions.
+   * @see Technical Issues / Virtual Functions: Overriding, Overloading, and
+   * Hiding
+   */
+  using Node::handle;
+  using Node::handles_test_event;
+
+  void handle( SpikeEvent& );
+
+  port handles_test_event( SpikeEvent&, rport );
+
+  void get_status( DictionaryDatum& ) const;
+  void set_status( const DictionaryDatum& );
+
+  void calibrate_time( const TimeConverter& tc );
+
+private:
+  void init_state_( Node const& );
+  void init_buffers_();
+  void calibrate();
+
+  void update( Time const&, const long, const long );
+
+  //! Combine the statistics of all thread siblings and store them in d
+  void get_statistics_( DictionaryDatum& d ) const;
+
+  // ------------------------------------------------------------
+
+  /**
+   * Running statistics of the spikes of one source.
+   */
+  struct SourceStatistics_
+  {
+    long n_spikes_;
+    double last_spike_; //!< time of the last spike in ms
+    double isi_mean_;   //!< running mean of the ISIs in ms
+    double isi_m2_;     //!< running sum of squared deviations of the ISIs from their mean
+
+    SourceStatistics_();
+
+    //! Update the statistics with a spike at time t
+    void add_spike( double t );
+  };
+
+  // ------------------------------------------------------------
+
+  struct Parameters_
+  {
+    Time bin_width_; //!< width of the bins of the population histogram
+
+    Parameters_();                     //!< Sets default parameter values
+    Parameters_( const Parameters_& ); //!< Recalibrate all times
+
+    Parameters_& operator=( const Parameters_& );
+
+    void get( DictionaryDatum& ) const; //!< Store current values in dictionary
+
+    /**
+     * Set values from dictionary.
+     * @returns true if the state needs to be reset after a change of
+     *          bin_width.
+     */
+    bool set( const DictionaryDatum&, const spike_statistics_detector&, Node* );
+  };
+
+  // ------------------------------------------------------------
+
+  /**
+   * @note State_ only contains read-out values, so we copy-construct
+   *       using the default c'tor.
+   */
+  struct State_
+  {
+    long n_events_;                                //!< number of spikes counted
+    Time reset_time_;                              //!< time of the last reset
+    std::vector< index > sources_;                 //!< node IDs of the sources in order of first spike
+    std::vector< SourceStatistics_ > statistics_;  //!< statistics in the order of sources_
+    std::unordered_map< index, size_t > indices_;  //!< position of each source in sources_
+    std::vector< long > population_histogram_;     //!< spike counts of all sources per bin
+
+    State_(); //!< initialize default state
+
+    /**
+     * @param bool if true, force state reset
+     */
+    void set( const DictionaryDatum&, bool, Node* );
+
+    void reset();
+  };
+
+  // ------------------------------------------------------------
+
+  //! Start of the observation period
+  Time get_observation_start_() const;
+
+  PseudoRecordingDevice device_;
+  Parameters_ P_;
+  State_ S_;
+};
+
+inline port
+spike_statistics_detector::handles_test_event( SpikeEvent&, rport receptor_type )
+{
+  if ( receptor_type != 0 )
+  {
+    throw UnknownReceptorType( receptor_type, get_name() );
+  }
+
+  return 0;
+}
+
+inline void
+nest::spike_statistics_detector::set_status( const DictionaryDatum& d )
+{
+  Parameters_ ptmp = P_;
+  const bool reset_required = ptmp.set( d, *this, this );
+  State_ stmp = S_;
+  stmp.set( d, reset_required, this );
+
+  device_.set_status( d );
+  P_ = ptmp;
+  S_ = stmp;
+}
+
+inline void
+nest::spike_statistics_detector::calibrate_time( const TimeConverter& tc )
+{
+  P_.bin_width_ = tc.from_old_tics( P_.bin_width_.get_tics() );
+  S_.reset_time_ = tc.from_old_tics( S_.reset_time_.get_tics() );
+}
+
+
+} // namespace
+
+#endif /* #ifndef SPIKE_STATISTICS_DETECTOR_H */
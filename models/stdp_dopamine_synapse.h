@@ -533,8 +533,8 @@ stdp_dopamine_synapse< targetidentifierT >::send( Event& e, thread t, const STDP
 
   // get spike history in relevant range (t_last_update, t_spike] from
   // postsynaptic neuron
-  std::deque< histentry >::iterator start;
-  std::deque< histentry >::iterator finish;
+  SpikeHistory::iterator start;
+  SpikeHistory::iterator finish;
   target->get_history( t_last_update_ - dendritic_delay, t_spike - dendritic_delay, &start, &finish );
 
   // facilitation due to postsynaptic spikes since last update
@@ -585,8 +585,8 @@ stdp_dopamine_synapse< targetidentifierT >::trigger_update_weight( thread t,
 
   // get spike history in relevant range (t_last_update, t_trig] from postsyn.
   // neuron
-  std::deque< histentry >::iterator start;
-  std::deque< histentry >::iterator finish;
+  SpikeHistory::iterator start;
+  SpikeHistory::iterator finish;
   get_target( t )->get_history( t_last_update_ - dendritic_delay, t_trig - dendritic_delay, &start, &finish );
 
   // facilitation due to postsyn. spikes since last update
@@ -57,6 +57,7 @@ STDPPLHomCommonProperties::get_status( DictionaryDatum& d ) const
   def< double >( d, names::lambda, lambda_ );
   def< double >( d, names::alpha, alpha_ );
   def< double >( d, names::mu, mu_ );
+  def< bool >( d, names::use_exp_cache, exp_cache_plus_.is_enabled() );
 }
 
 void
@@ -64,6 +65,7 @@ STDPPLHomCommonProperties::set_status( const DictionaryDatum& d, ConnectorModel&
 {
   CommonSynapseProperties::set_status( d, cm );
 
+  const double old_tau_plus = tau_plus_;
   updateValue< double >( d, names::tau_plus, tau_plus_ );
   if ( tau_plus_ > 0. )
   {
@@ -76,6 +78,17 @@ STDPPLHomCommonProperties::set_status( const DictionaryDatum& d, ConnectorModel&
   updateValue< double >( d, names::lambda, lambda_ );
   updateValue< double >( d, names::alpha, alpha_ );
   updateValue< double >( d, names::mu, mu_ );
+
+  bool use_exp_cache = exp_cache_plus_.is_enabled();
+  updateValue< bool >( d, names::use_exp_cache, use_exp_cache );
+  if ( use_exp_cache and ( tau_plus_ != old_tau_plus or not exp_cache_plus_.is_enabled() ) )
+  {
+    exp_cache_plus_.init( tau_plus_ );
+  }
+  else if ( not use_exp_cache )
+  {
+    exp_cache_plus_.release();
+  }
 }
 
 } // of namespace nest
@@ -0,0 +1,376 @@
+/*
+ *  stdp_postdriven_synapse.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STDP_POSTDRIVEN_SYNAPSE_H
+#define STDP_POSTDRIVEN_SYNAPSE_H
+
+// C++ includes:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Includes from nestkernel:
+#include "archiving_node.h"
+#include "common_synapse_properties.h"
+#include "connection.h"
+#include "connector_model.h"
+#include "event.h"
+
+// Includes from sli:
+#include "dictdatum.h"
+#include "dictutils.h"
+
+namespace nest
+{
+
+/* BeginUserDocs: synapse, spike-timing-dependent plasticity
+
+Short description
++++++++++++++++++
+
+Synapse type for spike-timing dependent plasticity updated by the
+postsynaptic neuron
+
+Description
++++++++++++
+
+stdp_postdriven_synapse implements the same plasticity rule as
+stdp_synapse and yields identical weights, but differs in when the
+facilitation due to postsynaptic spikes is applied.
+
+stdp_synapse applies all postsynaptic spikes since the last presynaptic
+spike when the next presynaptic spike arrives. The postsynaptic neuron
+therefore has to keep its spike history until every incoming synapse has
+read it, which for rarely active inputs can take arbitrarily long.
+
+The postsynaptic neuron keeps an index of its incoming
+stdp_postdriven_synapse connections. Whenever it spikes, it applies all
+its previous spikes that reach the synapses before the beginning of the
+current time slice to all these connections at once, since all
+presynaptic spikes up to this point have been delivered. Afterwards, it
+only retains the spikes of the last maximal delay of these connections
+and the current time slice, and the latest applied spike, which is needed
+to compute depression. This bounds the length of the spike history
+independently of the in-degree and the presynaptic rates, at the cost of
+visiting all incoming connections at every postsynaptic spike.
+
+The index is rebuilt whenever connections have changed before a
+simulation starts. Only neurons that support STDP, i.e., have a spike
+history, can be targets of this synapse.
+
+Parameters
+++++++++++
+
+========= =======  ======================================================
+ tau_plus  ms      Time constant of STDP window, potentiation
+                   (tau_minus defined in postsynaptic neuron)
+ lambda    real    Step size
+ alpha     real    Asymmetry parameter (scales depressing increments as
+                   alpha*lambda)
+ mu_plus   real    Weight dependence exponent, potentiation
+ mu_minus  real    Weight dependence exponent, depression
+ Wmax      real    Maximum allowed weight
+========= =======  ======================================================
+
+Transmits
++++++++++
+
+SpikeEvent
+
+References
+++++++++++
+
+.. [1] Guetig et al. (2003). Learning input correlations through nonlinear
+       temporally asymmetric hebbian plasticity. Journal of Neuroscience,
+       23:3697-3714 DOI: https://doi.org/10.1523/JNEUROSCI.23-09-03697.2003
+
+See also
+++++++++
+
+stdp_synapse
+
+EndUserDocs */
+
+// connections are templates of target identifier type (used for pointer /
+// target index addressing) derived from generic connection template
+
+template < typename targetidentifierT >
+class stdp_postdriven_synapse : public Connection< targetidentifierT >
+{
+
+public:
+  typedef CommonSynapseProperties CommonPropertiesType;
+  typedef Connection< targetidentifierT > ConnectionBase;
+
+  /**
+   * Default Constructor.
+   * Sets default values for all parameters. Needed by GenericConnectorModel.
+   */
+  stdp_postdriven_synapse();
+
+
+  /**
+   * Copy constructor.
+   * Needs to be defined properly in order for GenericConnector to work.
+   */
+  stdp_postdriven_synapse( const stdp_postdriven_synapse& ) = default;
+
+  // Explicitly declare all methods inherited from the dependent base
+  // ConnectionBase. This avoids explicit name prefixes in all places these
+  // functions are used. Since ConnectionBase depends on the template parameter,
+  // they are not automatically found in the base class.
+  using ConnectionBase::get_delay_steps;
+  using ConnectionBase::get_delay;
+  using ConnectionBase::get_rport;
+  using ConnectionBase::get_target;
+
+  /**
+   * Get all properties of this connection and put them into a dictionary.
+   */
+  void get_status( DictionaryDatum& d ) const;
+
+  /**
+   * Set properties of this connection from the values given in dictionary.
+   */
+  void set_status( const DictionaryDatum& d, ConnectorModel& cm );
+
+  /**
+   * Send an event to the receiver of this connection.
+   * \param e The event to send
+   * \param cp common properties of all synapses (empty).
+   */
+  void send( Event& e, thread t, const CommonSynapseProperties& cp );
+
+  /**
+   * Add the connection to the index of incoming connections of its target.
+   */
+  void
+  register_postdriven_stdp( const thread t, const synindex syn_id, const index lcid )
+  {
+    static_cast< ArchivingNode* >( get_target( t ) )->register_postdriven_stdp_connection( syn_id, lcid, get_delay() );
+  }
+
+  /**
+   * Apply all postsynaptic spikes that reach the synapse up to t_lim. Called
+   * by the postsynaptic neuron once all presynaptic spikes up to t_lim have
+   * been delivered.
+   */
+  void apply_postdriven_stdp( const thread t, const double t_lim, const CommonSynapseProperties& cp );
+
+
+  class ConnTestDummyNode : public ConnTestDummyNodeBase
+  {
+  public:
+    // Ensure proper overriding of overloaded virtual functions.
+    // Return values from functions are ignored.
+    using ConnTestDummyNodeBase::handles_test_event;
+    port
+    handles_test_event( SpikeEvent&, rport )
+    {
+      return invalid_port_;
+    }
+  };
+
+  void
+  check_connection( Node& s, Node& t, rport receptor_type, const CommonPropertiesType& )
+  {
+    ConnTestDummyNode dummy_target;
+
+    ConnectionBase::check_connection_( dummy_target, s, t, receptor_type );
+
+    if ( dynamic_cast< ArchivingNode* >( &t ) == NULL )
+    {
+      throw IllegalConnection( "The target node does not support STDP synapses." );
+    }
+  }
+
+  void
+  set_weight( double w )
+  {
+    weight_ = w;
+  }
+
+private:
+  double
+  facilitate_( double w, double kplus )
+  {
+    double norm_w = ( w / Wmax_ ) + ( lambda_ * std::pow( 1.0 - ( w / Wmax_ ), mu_plus_ ) * kplus );
+    return norm_w < 1.0 ? norm_w * Wmax_ : Wmax_;
+  }
+
+  double
+  depress_( double w, double kminus )
+  {
+    double norm_w = ( w / Wmax_ ) - ( alpha_ * lambda_ * std::pow( w / Wmax_, mu_minus_ ) * kminus );
+    return norm_w > 0.0 ? norm_w * Wmax_ : 0.0;
+  }
+
+  /**
+   * Facilitate for all postsynaptic spikes up to t2 that have neither been
+   * applied by a previous presynaptic spike nor by the postsynaptic neuron.
+   */
+  void facilitate_history_( ArchivingNode& target, const double t2 );
+
+  // data members of each connection
+  double weight_;
+  double tau_plus_;
+  double lambda_;
+  double alpha_;
+  double mu_plus_;
+  double mu_minus_;
+  double Wmax_;
+  double Kplus_;
+
+  double t_lastspike_;
+
+  //! all postsynaptic spikes emitted up to this time have been applied
+  double t_post_applied_;
+};
+
+
+template < typename targetidentifierT >
+inline void
+stdp_postdriven_synapse< targetidentifierT >::facilitate_history_( ArchivingNode& target, const double t2 )
+{
+  const double dendritic_delay = get_delay();
+
+  // get spike history in relevant range (t1, t2] from postsynaptic neuron;
+  // spikes up to t_post_applied_ have been applied by the neuron before
+  SpikeHistory::iterator start;
+  SpikeHistory::iterator finish;
+  target.get_postdriven_history( std::max( t_lastspike_ - dendritic_delay, t_post_applied_ ), t2, &start, &finish );
+
+  double minus_dt;
+  while ( start != finish )
+  {
+    minus_dt = t_lastspike_ - ( start->t_ + dendritic_delay );
+    ++start;
+    assert( minus_dt < -1.0 * kernel().connection_manager.get_stdp_eps() );
+    weight_ = facilitate_( weight_, Kplus_ * std::exp( minus_dt / tau_plus_ ) );
+  }
+}
+
+/**
+ * Send an event to the receiver of this connection.
+ * \param e The event to send
+ * \param t The thread on which this connection is stored.
+ * \param cp Common properties object, containing the stdp parameters.
+ */
+template < typename targetidentifierT >
+inline void
+stdp_postdriven_synapse< targetidentifierT >::send( Event& e, thread t, const CommonSynapseProperties& )
+{
+  // synapse STDP depressing/facilitation dynamics
+  const double t_spike = e.get_stamp().get_ms();
+
+  // the target has been checked to be an ArchivingNode in check_connection()
+  ArchivingNode* target = static_cast< ArchivingNode* >( get_target( t ) );
+  const double dendritic_delay = get_delay();
+
+  // facilitation due to postsynaptic spikes since last pre-synaptic spike
+  facilitate_history_( *target, t_spike - dendritic_delay );
+
+  const double _K_value = target->get_K_value( t_spike - dendritic_delay );
+  weight_ = depress_( weight_, _K_value );
+
+  e.set_receiver( *target );
+  e.set_weight( weight_ );
+  // use accessor functions (inherited from Connection< >) to obtain delay in
+  // steps and rport
+  e.set_delay_steps( get_delay_steps() );
+  e.set_rport( get_rport() );
+  e();
+
+  Kplus_ = Kplus_ * std::exp( ( t_lastspike_ - t_spike ) / tau_plus_ ) + 1.0;
+
+  t_lastspike_ = t_spike;
+}
+
+template < typename targetidentifierT >
+inline void
+stdp_postdriven_synapse< targetidentifierT >::apply_postdriven_stdp( const thread t,
+  const double t_lim,
+  const CommonSynapseProperties& )
+{
+  // no presynaptic spike between t_lastspike_ and t_lim is pending, so the
+  // facilitation for postsynaptic spikes that reach the synapse up to t_lim
+  // uses the current Kplus_
+  const double t_post_lim = t_lim - get_delay();
+  facilitate_history_( *static_cast< ArchivingNode* >( get_target( t ) ), t_post_lim );
+  t_post_applied_ = t_post_lim;
+}
+
+
+template < typename targetidentifierT >
+stdp_postdriven_synapse< targetidentifierT >::stdp_postdriven_synapse()
+  : ConnectionBase()
+  , weight_( 1.0 )
+  , tau_plus_( 20.0 )
+  , lambda_( 0.01 )
+  , alpha_( 1.0 )
+  , mu_plus_( 1.0 )
+  , mu_minus_( 1.0 )
+  , Wmax_( 100.0 )
+  , Kplus_( 0.0 )
+  , t_lastspike_( 0.0 )
+  , t_post_applied_( -std::numeric_limits< double >::infinity() )
+{
+}
+
+template < typename targetidentifierT >
+void
+stdp_postdriven_synapse< targetidentifierT >::get_status( DictionaryDatum& d ) const
+{
+  ConnectionBase::get_status( d );
+  def< double >( d, names::weight, weight_ );
+  def< double >( d, names::tau_plus, tau_plus_ );
+  def< double >( d, names::lambda, lambda_ );
+  def< double >( d, names::alpha, alpha_ );
+  def< double >( d, names::mu_plus, mu_plus_ );
+  def< double >( d, names::mu_minus, mu_minus_ );
+  def< double >( d, names::Wmax, Wmax_ );
+  def< long >( d, names::size_of, sizeof( *this ) );
+}
+
+template < typename targetidentifierT >
+void
+stdp_postdriven_synapse< targetidentifierT >::set_status( const DictionaryDatum& d, ConnectorModel& cm )
+{
+  ConnectionBase::set_status( d, cm );
+  updateValue< double >( d, names::weight, weight_ );
+  updateValue< double >( d, names::tau_plus, tau_plus_ );
+  updateValue< double >( d, names::lambda, lambda_ );
+  updateValue< double >( d, names::alpha, alpha_ );
+  updateValue< double >( d, names::mu_plus, mu_plus_ );
+  updateValue< double >( d, names::mu_minus, mu_minus_ );
+  updateValue< double >( d, names::Wmax, Wmax_ );
+
+  // check if weight_ and Wmax_ has the same sign
+  if ( not( ( ( weight_ >= 0 ) - ( weight_ < 0 ) ) == ( ( Wmax_ >= 0 ) - ( Wmax_ < 0 ) ) ) )
+  {
+    throw BadProperty( "Weight and Wmax must have same sign." );
+  }
+}
+
+} // of namespace nest
+
+#endif // of #ifndef STDP_POSTDRIVEN_SYNAPSE_H
@@ -481,8 +481,8 @@ stdp_facetshw_synapse_hom< targetidentifierT >::send( Event& e,
   double dendritic_delay = Time( Time::step( get_delay_steps() ) ).get_ms();
 
   // get spike history in relevant range (t1, t2] from postsynaptic neuron
-  std::deque< histentry >::iterator start;
-  std::deque< histentry >::iterator finish;
+  SpikeHistory::iterator start;
+  SpikeHistory::iterator finish;
   get_target( t )->get_history( t_lastspike_ - dendritic_delay, t_spike - dendritic_delay, &start, &finish );
 
   // facilitation due to the first postsynaptic spike since the last
@@ -58,6 +58,7 @@ STDPHomCommonProperties::get_status( DictionaryDatum& d ) const
   def< double >( d, names::mu_plus, mu_plus_ );
   def< double >( d, names::mu_minus, mu_minus_ );
   def< double >( d, names::Wmax, Wmax_ );
+  def< bool >( d, names::use_exp_cache, exp_cache_plus_.is_enabled() );
 }
 
 void
@@ -65,12 +66,24 @@ STDPHomCommonProperties::set_status( const DictionaryDatum& d, ConnectorModel& c
 {
   CommonSynapseProperties::set_status( d, cm );
 
+  const double old_tau_plus = tau_plus_;
   updateValue< double >( d, names::tau_plus, tau_plus_ );
   updateValue< double >( d, names::lambda, lambda_ );
   updateValue< double >( d, names::alpha, alpha_ );
   updateValue< double >( d, names::mu_plus, mu_plus_ );
   updateValue< double >( d, names::mu_minus, mu_minus_ );
   updateValue< double >( d, names::Wmax, Wmax_ );
+
+  bool use_exp_cache = exp_cache_plus_.is_enabled();
+  updateValue< bool >( d, names::use_exp_cache, use_exp_cache );
+  if ( use_exp_cache and ( tau_plus_ != old_tau_plus or not exp_cache_plus_.is_enabled() ) )
+  {
+    exp_cache_plus_.init( tau_plus_ );
+  }
+  else if ( not use_exp_cache )
+  {
+    exp_cache_plus_.release();
+  }
 }
 
 } // of namespace nest
@@ -28,6 +28,7 @@
 
 // Includes from nestkernel:
 #include "connection.h"
+#include "exp_cache.h"
 
 namespace nest
 {
@@ -75,6 +76,11 @@ Remarks:
 The parameters are common to all synapses of the model and must be set using
 SetDefaults on the synapse model.
 
+If the boolean parameter use_exp_cache is set to true, exponentials of the
+potentiation window are cached for spike time differences that recur, e.g.,
+because spikes and delays are on the simulation grid. Results are
+bit-identical to those obtained without the cache.
+
 Transmits
 +++++++++
 
@@ -137,6 +143,9 @@ public:
   double mu_plus_;
   double mu_minus_;
   double Wmax_;
+
+  //! Optional cache for exp( -dt / tau_plus ); each thread has its own copy
+  mutable ExpCache exp_cache_plus_;
 };
 
 
@@ -286,8 +295,8 @@ stdp_synapse_hom< targetidentifierT >::send( Event& e, thread t, const STDPHomCo
   double dendritic_delay = get_delay();
 
   // get spike history in relevant range (t1, t2] from postsynaptic neuron
-  std::deque< histentry >::iterator start;
-  std::deque< histentry >::iterator finish;
+  SpikeHistory::iterator start;
+  SpikeHistory::iterator finish;
   target->get_history( t_lastspike_ - dendritic_delay, t_spike - dendritic_delay, &start, &finish );
   // facilitation due to postsynaptic spikes since last pre-synaptic spike
   double minus_dt;
@@ -298,7 +307,7 @@ stdp_synapse_hom< targetidentifierT >::send( Event& e, thread t, const STDPHomCo
     // get_history() should make sure that
     // start->t_ > t_lastspike - dendritic_delay, i.e. minus_dt < 0
     assert( minus_dt < -1.0 * kernel().connection_manager.get_stdp_eps() );
-    weight_ = facilitate_( weight_, Kplus_ * std::exp( minus_dt / cp.tau_plus_ ), cp );
+    weight_ = facilitate_( weight_, Kplus_ * cp.exp_cache_plus_.exp( minus_dt / cp.tau_plus_ ), cp );
   }
 
   // depression due to new pre-synaptic spike
@@ -310,7 +319,7 @@ stdp_synapse_hom< targetidentifierT >::send( Event& e, thread t, const STDPHomCo
   e.set_rport( get_rport() );
   e();
 
-  Kplus_ = Kplus_ * std::exp( ( t_lastspike_ - t_spike ) / cp.tau_plus_ ) + 1.0;
+  Kplus_ = Kplus_ * cp.exp_cache_plus_.exp( ( t_lastspike_ - t_spike ) / cp.tau_plus_ ) + 1.0;
 
   t_lastspike_ = t_spike;
 }
@@ -204,8 +204,8 @@ vogels_sprekeler_synapse< targetidentifierT >::send( Event& e, thread t, const C
   double dendritic_delay = get_delay();
 
   // get spike history in relevant range (t1, t2] from postsynaptic neuron
-  std::deque< histentry >::iterator start;
-  std::deque< histentry >::iterator finish;
+  SpikeHistory::iterator start;
+  SpikeHistory::iterator finish;
   target->get_history( t_lastspike_ - dendritic_delay, t_spike - dendritic_delay, &start, &finish );
 
   // presynaptic neuron j, postsynaptic neuron i
@@ -22,6 +22,9 @@
 
 #include "archiving_node.h"
 
+// C++ includes:
+#include <algorithm>
+
 // Includes from nestkernel:
 #include "kernel_manager.h"
 
@@ -43,6 +46,7 @@ nest::ArchivingNode::ArchivingNode()
   , tau_minus_triplet_inv_( 1. / tau_minus_triplet_ )
   , max_delay_( 0 )
   , last_spike_( -1.0 )
+  , postdriven_max_delay_( 0.0 )
 {
 }
 
@@ -58,23 +62,25 @@ nest::ArchivingNode::ArchivingNode( const ArchivingNode& n )
   , max_delay_( n.max_delay_ )
   , trace_( n.trace_ )
   , last_spike_( n.last_spike_ )
+  , exp_cache_minus_( n.exp_cache_minus_ )
+  , exp_cache_minus_triplet_( n.exp_cache_minus_triplet_ )
+  , postdriven_max_delay_( 0.0 )
 {
 }
 
 void
 ArchivingNode::register_stdp_connection( double t_first_read, double delay )
 {
-  // Mark all entries in the deque, which we will not read in future as read by
-  // this input input, so that we savely increment the incoming number of
+  // Mark all entries in the history, which we will not read in future as read
+  // by this input input, so that we savely increment the incoming number of
   // connections afterwards without leaving spikes in the history.
   // For details see bug #218. MH 08-04-22
 
-  for ( std::deque< histentry >::iterator runner = history_.begin();
-        runner != history_.end() and ( t_first_read - runner->t_ > -1.0 * kernel().connection_manager.get_stdp_eps() );
-        ++runner )
-  {
-    ( runner->access_counter_ )++;
-  }
+  const double eps = kernel().connection_manager.get_stdp_eps();
+  const SpikeHistory::iterator first_unread = std::partition_point( history_.begin(),
+    history_.end(),
+    [t_first_read, eps]( const histentry& entry ) { return t_first_read - entry.t_ > -1.0 * eps; } );
+  history_.mark_read( history_.begin(), first_unread );
 
   n_incoming_++;
 
@@ -93,15 +99,11 @@ nest::ArchivingNode::get_K_value( double t )
 
   // search for the latest post spike in the history buffer that came strictly
   // before `t`
-  int i = history_.size() - 1;
-  while ( i >= 0 )
+  const SpikeHistory::iterator latest = find_latest_before_( t );
+  if ( latest != history_.end() )
   {
-    if ( t - history_[ i ].t_ > kernel().connection_manager.get_stdp_eps() )
-    {
-      trace_ = ( history_[ i ].Kminus_ * std::exp( ( history_[ i ].t_ - t ) * tau_minus_inv_ ) );
-      return trace_;
-    }
-    --i;
+    trace_ = ( latest->Kminus_ * exp_cache_minus_.exp( ( latest->t_ - t ) * tau_minus_inv_ ) );
+    return trace_;
   }
 
   // this case occurs when the trace was requested at a time precisely at or
@@ -127,18 +129,15 @@ nest::ArchivingNode::get_K_values( double t,
 
   // search for the latest post spike in the history buffer that came strictly
   // before `t`
-  int i = history_.size() - 1;
-  while ( i >= 0 )
+  const SpikeHistory::iterator latest = find_latest_before_( t );
+  if ( latest != history_.end() )
   {
-    if ( t - history_[ i ].t_ > kernel().connection_manager.get_stdp_eps() )
-    {
-      K_triplet_value =
-        ( history_[ i ].Kminus_triplet_ * std::exp( ( history_[ i ].t_ - t ) * tau_minus_triplet_inv_ ) );
-      K_value = ( history_[ i ].Kminus_ * std::exp( ( history_[ i ].t_ - t ) * tau_minus_inv_ ) );
-      nearest_neighbor_K_value = std::exp( ( history_[ i ].t_ - t ) * tau_minus_inv_ );
-      return;
-    }
-    --i;
+    const double decay_minus = exp_cache_minus_.exp( ( latest->t_ - t ) * tau_minus_inv_ );
+    K_triplet_value =
+      ( latest->Kminus_triplet_ * exp_cache_minus_triplet_.exp( ( latest->t_ - t ) * tau_minus_triplet_inv_ ) );
+    K_value = ( latest->Kminus_ * decay_minus );
+    nearest_neighbor_K_value = decay_minus;
+    return;
   }
 
   // this case occurs when the trace was requested at a time precisely at or
@@ -148,11 +147,25 @@ nest::ArchivingNode::get_K_values( double t,
   K_value = 0.0;
 }
 
+SpikeHistory::iterator
+nest::ArchivingNode::find_latest_before_( double t )
+{
+  const double eps = kernel().connection_manager.get_stdp_eps();
+  const SpikeHistory::iterator first_not_before = std::partition_point(
+    history_.begin(), history_.end(), [t, eps]( const histentry& entry ) { return t - entry.t_ > eps; } );
+
+  if ( first_not_before == history_.begin() )
+  {
+    return history_.end();
+  }
+  return first_not_before - 1;
+}
+
 void
-nest::ArchivingNode::get_history( double t1,
+nest::ArchivingNode::find_history_range_( double t1,
   double t2,
-  std::deque< histentry >::iterator* start,
-  std::deque< histentry >::iterator* finish )
+  SpikeHistory::iterator* start,
+  SpikeHistory::iterator* finish )
 {
   *finish = history_.end();
   if ( history_.empty() )
@@ -160,20 +173,48 @@ nest::ArchivingNode::get_history( double t1,
     *start = *finish;
     return;
   }
-  std::deque< histentry >::reverse_iterator runner = history_.rbegin();
+
+  // history entries are sorted by time, so we can find the range (t1, t2]
+  // by binary search
   const double t2_lim = t2 + kernel().connection_manager.get_stdp_eps();
   const double t1_lim = t1 + kernel().connection_manager.get_stdp_eps();
-  while ( runner != history_.rend() and runner->t_ >= t2_lim )
-  {
-    ++runner;
-  }
-  *finish = runner.base();
-  while ( runner != history_.rend() and runner->t_ >= t1_lim )
-  {
-    runner->access_counter_++;
-    ++runner;
-  }
-  *start = runner.base();
+  *finish = std::partition_point(
+    history_.begin(), history_.end(), [t2_lim]( const histentry& entry ) { return entry.t_ < t2_lim; } );
+  *start = std::partition_point(
+    history_.begin(), *finish, [t1_lim]( const histentry& entry ) { return entry.t_ < t1_lim; } );
+}
+
+void
+nest::ArchivingNode::get_history( double t1,
+  double t2,
+  SpikeHistory::iterator* start,
+  SpikeHistory::iterator* finish )
+{
+  find_history_range_( t1, t2, start, finish );
+  history_.mark_read( *start, *finish );
+}
+
+void
+nest::ArchivingNode::get_postdriven_history( double t1,
+  double t2,
+  SpikeHistory::iterator* start,
+  SpikeHistory::iterator* finish )
+{
+  find_history_range_( t1, t2, start, finish );
+}
+
+void
+nest::ArchivingNode::register_postdriven_stdp_connection( synindex syn_id, index lcid, double delay )
+{
+  postdriven_connections_.push_back( std::make_pair( syn_id, lcid ) );
+  postdriven_max_delay_ = std::max( delay, postdriven_max_delay_ );
+}
+
+void
+nest::ArchivingNode::clear_postdriven_stdp_connections()
+{
+  postdriven_connections_.clear();
+  postdriven_max_delay_ = 0.0;
 }
 
 void
@@ -183,19 +224,37 @@ nest::ArchivingNode::set_spiketime( Time const& t_sp, double offset )
 
   const double t_sp_ms = t_sp.get_ms() - offset;
 
-  if ( n_incoming_ )
+  if ( n_incoming_ or not postdriven_connections_.empty() )
   {
+    const double eps = kernel().connection_manager.get_stdp_eps();
+
+    // all presynaptic spikes up to the beginning of the current time slice
+    // have been delivered, so postsynaptic-driven connections can take up
+    // all postsynaptic spikes that reach them up to this point
+    double t_applied = 0.0;
+    if ( not postdriven_connections_.empty() )
+    {
+      const double t_slice = kernel().simulation_manager.get_slice_origin().get_ms();
+      kernel().connection_manager.apply_postdriven_stdp( get_thread(), postdriven_connections_, t_slice );
+      t_applied = t_slice - postdriven_max_delay_;
+    }
+
     // prune all spikes from history which are no longer needed
     // only remove a spike if:
     // - its access counter indicates it has been read out by all connected
     //   STDP synapses, and
     // - there is another, later spike, that is strictly more than
-    //   (max_delay_ + eps) away from the new spike (at t_sp_ms)
+    //   (max_delay_ + eps) away from the new spike (at t_sp_ms), and
+    // - the later spike has been applied to all postsynaptic-driven STDP
+    //   synapses, which then only need the latest applied spike to compute
+    //   Kminus
     while ( history_.size() > 1 )
     {
       const double next_t_sp = history_[ 1 ].t_;
-      if ( history_.front().access_counter_ >= n_incoming_
-        and t_sp_ms - next_t_sp > max_delay_ + kernel().connection_manager.get_stdp_eps() )
+      const bool read_by_all = n_incoming_ == 0
+        or ( history_.get_front_access_counter() >= n_incoming_ and t_sp_ms - next_t_sp > max_delay_ + eps );
+      const bool applied_to_all = postdriven_connections_.empty() or next_t_sp < t_applied + eps;
+      if ( read_by_all and applied_to_all )
       {
         history_.pop_front();
       }
@@ -205,10 +264,11 @@ nest::ArchivingNode::set_spiketime( Time const& t_sp, double offset )
       }
     }
     // update spiking history
-    Kminus_ = Kminus_ * std::exp( ( last_spike_ - t_sp_ms ) * tau_minus_inv_ ) + 1.0;
-    Kminus_triplet_ = Kminus_triplet_ * std::exp( ( last_spike_ - t_sp_ms ) * tau_minus_triplet_inv_ ) + 1.0;
+    Kminus_ = Kminus_ * exp_cache_minus_.exp( ( last_spike_ - t_sp_ms ) * tau_minus_inv_ ) + 1.0;
+    Kminus_triplet_ =
+      Kminus_triplet_ * exp_cache_minus_triplet_.exp( ( last_spike_ - t_sp_ms ) * tau_minus_triplet_inv_ ) + 1.0;
     last_spike_ = t_sp_ms;
-    history_.push_back( histentry( last_spike_, Kminus_, Kminus_triplet_, 0 ) );
+    history_.push_back( last_spike_, Kminus_, Kminus_triplet_ );
   }
   else
   {
@@ -223,6 +283,7 @@ nest::ArchivingNode::get_status( DictionaryDatum& d ) const
   def< double >( d, names::tau_minus, tau_minus_ );
   def< double >( d, names::tau_minus_triplet, tau_minus_triplet_ );
   def< double >( d, names::post_trace, trace_ );
+  def< bool >( d, names::use_exp_cache, exp_cache_minus_.is_enabled() );
 #ifdef DEBUG_ARCHIVER
   def< int >( d, names::archiver_length, history_.size() );
 #endif
@@ -239,6 +300,8 @@ nest::ArchivingNode::set_status( const DictionaryDatum& d )
   double new_tau_minus_triplet = tau_minus_triplet_;
   updateValue< double >( d, names::tau_minus, new_tau_minus );
   updateValue< double >( d, names::tau_minus_triplet, new_tau_minus_triplet );
+  bool new_use_exp_cache = exp_cache_minus_.is_enabled();
+  updateValue< bool >( d, names::use_exp_cache, new_use_exp_cache );
 
   if ( new_tau_minus <= 0.0 or new_tau_minus_triplet <= 0.0 )
   {
@@ -247,12 +310,27 @@ nest::ArchivingNode::set_status( const DictionaryDatum& d )
 
   StructuralPlasticityNode::set_status( d );
 
+  // the cache slots are laid out for the time constants, so caches need to
+  // be set up again if these change
+  const bool tau_changed = new_tau_minus != tau_minus_ or new_tau_minus_triplet != tau_minus_triplet_;
+
   // do the actual update
   tau_minus_ = new_tau_minus;
   tau_minus_triplet_ = new_tau_minus_triplet;
   tau_minus_inv_ = 1. / tau_minus_;
   tau_minus_triplet_inv_ = 1. / tau_minus_triplet_;
 
+  if ( new_use_exp_cache and ( tau_changed or not exp_cache_minus_.is_enabled() ) )
+  {
+    exp_cache_minus_.init( tau_minus_ );
+    exp_cache_minus_triplet_.init( tau_minus_triplet_ );
+  }
+  else if ( not new_use_exp_cache )
+  {
+    exp_cache_minus_.release();
+    exp_cache_minus_triplet_.release();
+  }
+
   // check, if to clear spike history and K_minus
   bool clear = false;
   updateValue< bool >( d, names::clear, clear );
@@ -25,13 +25,16 @@
 
 // C++ includes:
 #include <algorithm>
-#include <deque>
+#include <utility>
+#include <vector>
 
 // Includes from nestkernel:
+#include "exp_cache.h"
 #include "histentry.h"
 #include "nest_time.h"
 #include "nest_types.h"
 #include "node.h"
+#include "spike_history.h"
 #include "structural_plasticity_node.h"
 
 // Includes from sli:
@@ -100,22 +103,19 @@ public:
   }
 
   /**
-   * \fn double get_K_triplet_value(std::deque<histentry>::iterator &iter)
+   * \fn double get_K_triplet_value(SpikeHistory::iterator &iter)
    * return the triplet Kminus value for the associated iterator.
    */
-  double get_K_triplet_value( const std::deque< histentry >::iterator& iter );
+  double get_K_triplet_value( const SpikeHistory::iterator& iter );
 
   /**
    * \fn void get_history(long t1, long t2,
-   * std::deque<Archiver::histentry>::iterator* start,
-   * std::deque<Archiver::histentry>::iterator* finish)
+   * SpikeHistory::iterator* start,
+   * SpikeHistory::iterator* finish)
    * return the spike times (in steps) of spikes which occurred in the range
    * (t1,t2].
    */
-  void get_history( double t1,
-    double t2,
-    std::deque< histentry >::iterator* start,
-    std::deque< histentry >::iterator* finish );
+  void get_history( double t1, double t2, SpikeHistory::iterator* start, SpikeHistory::iterator* finish );
 
   /**
    * Register a new incoming STDP connection.
@@ -125,6 +125,26 @@ public:
    */
   void register_stdp_connection( double t_first_read, double delay );
 
+  /**
+   * Return the spike history for (t1,t2] without marking it as read.
+   *
+   * Postsynaptic-driven STDP connections do not take part in the access
+   * counting, since the neuron applies its spikes to them in batches and
+   * then drops the spikes from the history.
+   */
+  void get_postdriven_history( double t1, double t2, SpikeHistory::iterator* start, SpikeHistory::iterator* finish );
+
+  /**
+   * Add an incoming postsynaptic-driven STDP connection, identified by its
+   * synapse type and its local connection id on the thread of the neuron.
+   */
+  void register_postdriven_stdp_connection( synindex syn_id, index lcid, double delay );
+
+  /**
+   * Remove all incoming postsynaptic-driven STDP connections from the index.
+   */
+  void clear_postdriven_stdp_connections();
+
   void get_status( DictionaryDatum& d ) const;
   void set_status( const DictionaryDatum& d );
 
@@ -172,7 +192,29 @@ private:
   double last_spike_;
 
   // spiking history needed by stdp synapses
-  std::deque< histentry > history_;
+  SpikeHistory history_;
+
+  // optional caches for exp(-dt/tau_minus) and exp(-dt/tau_minus_triplet)
+  ExpCache exp_cache_minus_;
+  ExpCache exp_cache_minus_triplet_;
+
+  // incoming postsynaptic-driven stdp connections, which are updated when
+  // the neuron spikes
+  std::vector< std::pair< synindex, index > > postdriven_connections_;
+
+  // maximal delay of incoming postsynaptic-driven stdp connections
+  double postdriven_max_delay_;
+
+  /**
+   * Return the latest entry in the history that lies strictly before t,
+   * or history_.end() if there is none.
+   */
+  SpikeHistory::iterator find_latest_before_( double t );
+
+  /**
+   * Find the range of history entries in (t1,t2].
+   */
+  void find_history_range_( double t1, double t2, SpikeHistory::iterator* start, SpikeHistory::iterator* finish );
 };
 
 inline double
@@ -22,6 +22,13 @@
 
 #include "conn_builder.h"
 
+// C++ includes:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+
 // Includes from libnestutil:
 #include "logging.h"
 
@@ -393,6 +400,106 @@ nest::ConnBuilder::set_post_synaptic_element_name( const std::string& name )
   use_post_synaptic_element_ = not name.empty();
 }
 
+void
+nest::ConnBuilder::batch_connect_( const std::vector< index >& snode_ids,
+  Node& target,
+  thread target_thread,
+  RngPtr rng )
+{
+  const size_t n = snode_ids.size();
+  if ( n == 0 )
+  {
+    return;
+  }
+
+  if ( this->requires_proxies() and not target.has_proxies() )
+  {
+    throw IllegalConnection( "Cannot use this rule to connect to nodes without proxies (usually devices)." );
+  }
+
+  // evaluate weights and delays of all connections, an empty vector
+  // indicates that the default be used
+  std::vector< std::vector< double > > weights( synapse_params_.size() );
+  std::vector< std::vector< double > > delays( synapse_params_.size() );
+  for ( size_t synapse_indx = 0; synapse_indx < synapse_params_.size(); ++synapse_indx )
+  {
+    if ( default_weight_and_delay_[ synapse_indx ] )
+    {
+      continue;
+    }
+    if ( not default_delay_[ synapse_indx ] )
+    {
+      delays[ synapse_indx ].resize( n );
+      delays_[ synapse_indx ]->value_double_batch(
+        target_thread, rng, snode_ids.data(), n, &target, delays[ synapse_indx ].data() );
+    }
+    if ( not default_weight_[ synapse_indx ] )
+    {
+      weights[ synapse_indx ].resize( n );
+      weights_[ synapse_indx ]->value_double_batch(
+        target_thread, rng, snode_ids.data(), n, &target, weights[ synapse_indx ].data() );
+    }
+  }
+
+  for ( size_t i = 0; i < n; ++i )
+  {
+    for ( size_t synapse_indx = 0; synapse_indx < synapse_params_.size(); ++synapse_indx )
+    {
+      update_param_dict_( snode_ids[ i ], target, target_thread, rng, synapse_indx );
+
+      kernel().connection_manager.connect( snode_ids[ i ],
+        &target,
+        target_thread,
+        synapse_model_id_[ synapse_indx ],
+        param_dicts_[ synapse_indx ][ target_thread ],
+        delays[ synapse_indx ].empty() ? numerics::nan : delays[ synapse_indx ][ i ],
+        weights[ synapse_indx ].empty() ? numerics::nan : weights[ synapse_indx ][ i ] );
+    }
+  }
+}
+
+bool
+nest::ConnBuilder::batch_connect_allowed_( const bool rule_draws_random ) const
+{
+  if ( not parameters_requiring_skipping_.empty() )
+  {
+    return false;
+  }
+
+  size_t n_random = 0;
+
+  for ( auto weight : weights_ )
+  {
+    if ( weight and weight->uses_rng() )
+    {
+      ++n_random;
+    }
+  }
+
+  for ( auto delay : delays_ )
+  {
+    if ( delay and delay->uses_rng() )
+    {
+      ++n_random;
+    }
+  }
+
+  for ( auto params : synapse_params_ )
+  {
+    for ( auto synapse_parameter : params )
+    {
+      if ( synapse_parameter.second->uses_rng() )
+      {
+        ++n_random;
+      }
+    }
+  }
+
+  // with a single source of random numbers, their order does not depend on
+  // whether the parameters are evaluated per connection or per batch
+  return n_random + ( rule_draws_random ? 1 : 0 ) <= 1;
+}
+
 bool
 nest::ConnBuilder::all_parameters_scalar_() const
 {
@@ -425,13 +532,6 @@ nest::ConnBuilder::all_parameters_scalar_() const
   return all_scalar;
 }
 
-bool
-nest::ConnBuilder::loop_over_targets_() const
-{
-  return targets_->size() < kernel().node_manager.size() or not targets_->is_range()
-    or parameters_requiring_skipping_.size() > 0;
-}
-
 void
 nest::ConnBuilder::set_synapse_model_( DictionaryDatum syn_params, size_t synapse_indx )
 {
@@ -617,61 +717,32 @@ nest::OneToOneBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      // one-to-one, thus the source is at the position of the target
+      NodeCollection::const_iterator source_it = sources_->begin();
+      size_t next_position = 0;
+      for ( const auto& local_target : targets_->thread_local_nodes( tid ) )
       {
-        // A more efficient way of doing this might be to use NodeCollection's local_begin(). For this to work we would
-        // need to change some of the logic, sources and targets might not be on the same process etc., so therefore
-        // we are not doing it at the moment. This also applies to other ConnBuilders below.
-        NodeCollection::const_iterator target_it = targets_->begin();
-        NodeCollection::const_iterator source_it = sources_->begin();
-        for ( ; target_it < targets_->end(); ++target_it, ++source_it )
+        const size_t position = local_target.first;
+        if ( position > next_position )
         {
-          assert( source_it < sources_->end() );
-
-          const index snode_id = ( *source_it ).node_id;
-          const index tnode_id = ( *target_it ).node_id;
-
-          if ( snode_id == tnode_id and not allow_autapses_ )
-          {
-            continue;
-          }
-
-          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
-          if ( target->is_proxy() )
-          {
-            // skip array parameters handled in other virtual processes
-            skip_conn_parameter_( tid );
-            continue;
-          }
-
-          single_connect_( snode_id, *target, tid, rng );
+          // skip array parameters handled in other virtual processes
+          skip_conn_parameter_( tid, position - next_position );
+          source_it += position - next_position;
         }
-      }
-      else
-      {
-        const SparseNodeArray& local_nodes = kernel().node_manager.get_local_nodes( tid );
-        SparseNodeArray::const_iterator n;
-        for ( n = local_nodes.begin(); n != local_nodes.end(); ++n )
-        {
-          Node* target = n->get_node();
+        next_position = position + 1;
 
-          const index tnode_id = n->get_node_id();
-          const int idx = targets_->find( tnode_id );
-          if ( idx < 0 ) // Is local node in target list?
-          {
-            continue;
-          }
+        const index snode_id = ( *source_it ).node_id;
+        const index tnode_id = local_target.second;
+        ++source_it;
 
-          // one-to-one, thus we can use target idx for source as well
-          const index snode_id = ( *sources_ )[ idx ];
-          if ( not allow_autapses_ and snode_id == tnode_id )
-          {
-            // no skipping required / possible,
-            // as we iterate only over local nodes
-            continue;
-          }
-          single_connect_( snode_id, *target, tid, rng );
+        if ( snode_id == tnode_id and not allow_autapses_ )
+        {
+          skip_conn_parameter_( tid );
+          continue;
         }
+
+        Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+        single_connect_( snode_id, *target, tid, rng );
       }
     }
     catch ( std::exception& err )
@@ -838,6 +909,7 @@ nest::OneToOneBuilder::sp_disconnect_()
 void
 nest::AllToAllBuilder::connect_()
 {
+  const bool batch = batch_connect_allowed_( false );
 
 #pragma omp parallel
   {
@@ -848,37 +920,38 @@ nest::AllToAllBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      // node IDs of all sources, to connect them to each target in one batch
+      std::vector< index > snode_ids;
+      if ( batch )
       {
-        NodeCollection::const_iterator target_it = targets_->begin();
-        for ( ; target_it < targets_->end(); ++target_it )
+        snode_ids.reserve( sources_->size() );
+        NodeCollection::const_iterator source_it = sources_->begin();
+        for ( ; source_it < sources_->end(); ++source_it )
         {
-          const index tnode_id = ( *target_it ).node_id;
-          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
-          if ( target->is_proxy() )
-          {
-            skip_conn_parameter_( tid, sources_->size() );
-            continue;
-          }
-
-          inner_connect_( tid, rng, target, tnode_id, true );
+          snode_ids.push_back( ( *source_it ).node_id );
         }
       }
-      else
+
+      size_t next_position = 0;
+      for ( const auto& local_target : targets_->thread_local_nodes( tid ) )
       {
-        const SparseNodeArray& local_nodes = kernel().node_manager.get_local_nodes( tid );
-        SparseNodeArray::const_iterator n;
-        for ( n = local_nodes.begin(); n != local_nodes.end(); ++n )
+        const size_t position = local_target.first;
+        if ( position > next_position )
         {
-          const index tnode_id = n->get_node_id();
-
-          // Is the local node in the targets list?
-          if ( targets_->find( tnode_id ) < 0 )
-          {
-            continue;
-          }
+          // skip array parameters handled in other virtual processes
+          skip_conn_parameter_( tid, ( position - next_position ) * sources_->size() );
+        }
+        next_position = position + 1;
 
-          inner_connect_( tid, rng, n->get_node(), tnode_id, false );
+        const index tnode_id = local_target.second;
+        Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+        if ( batch )
+        {
+          batch_inner_connect_( tid, rng, target, tnode_id, snode_ids );
+        }
+        else
+        {
+          inner_connect_( tid, rng, target, tnode_id, true );
         }
       }
     }
@@ -924,6 +997,36 @@ nest::AllToAllBuilder::inner_connect_( const int tid, RngPtr rng, Node* target,
   }
 }
 
+void
+nest::AllToAllBuilder::batch_inner_connect_( const int tid,
+  RngPtr rng,
+  Node* target,
+  index tnode_id,
+  const std::vector< index >& snode_ids )
+{
+  const thread target_thread = target->get_thread();
+
+  // check whether the target is on our thread
+  if ( tid != target_thread )
+  {
+    return;
+  }
+
+  if ( not allow_autapses_ )
+  {
+    const auto autapse = std::find( snode_ids.begin(), snode_ids.end(), tnode_id );
+    if ( autapse != snode_ids.end() )
+    {
+      std::vector< index > other_snode_ids( snode_ids.begin(), autapse );
+      other_snode_ids.insert( other_snode_ids.end(), autapse + 1, snode_ids.end() );
+      batch_connect_( other_snode_ids, *target, target_thread, rng );
+      return;
+    }
+  }
+
+  batch_connect_( snode_ids, *target, target_thread, rng );
+}
+
 /**
  * Solves the connection of two nodes on a AllToAll basis with
  * structural plasticity. This means this method is used by the
@@ -1135,6 +1238,11 @@ nest::FixedInDegreeBuilder::FixedInDegreeBuilder( NodeCollectionPTR sources,
 void
 nest::FixedInDegreeBuilder::connect_()
 {
+  // the sources are drawn from the same random numbers as the parameters,
+  // so only deterministic parameters can be evaluated in batches
+  const bool batch = batch_connect_allowed_( true );
+
+  drawn_ids_.resize( kernel().vp_manager.get_num_threads() );
 
 #pragma omp parallel
   {
@@ -1145,8 +1253,10 @@ nest::FixedInDegreeBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      if ( not parameters_requiring_skipping_.empty() )
       {
+        // the number of array entries to skip depends on the indegree of
+        // each target, which is only known when visiting all targets
         NodeCollection::const_iterator target_it = targets_->begin();
         for ( ; target_it < targets_->end(); ++target_it )
         {
@@ -1161,26 +1271,18 @@ nest::FixedInDegreeBuilder::connect_()
             continue;
           }
 
-          inner_connect_( tid, rng, target, tnode_id, true, indegree_value );
+          inner_connect_( tid, rng, target, tnode_id, true, indegree_value, false );
         }
       }
       else
       {
-        const SparseNodeArray& local_nodes = kernel().node_manager.get_local_nodes( tid );
-        SparseNodeArray::const_iterator n;
-        for ( n = local_nodes.begin(); n != local_nodes.end(); ++n )
+        for ( const auto& local_target : targets_->thread_local_nodes( tid ) )
         {
-          const index tnode_id = n->get_node_id();
-
-          // Is the local node in the targets list?
-          if ( targets_->find( tnode_id ) < 0 )
-          {
-            continue;
-          }
-          auto source = n->get_node();
-          const long indegree_value = std::round( indegree_->value( rng, source ) );
+          const index tnode_id = local_target.second;
+          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          const long indegree_value = std::round( indegree_->value( rng, target ) );
 
-          inner_connect_( tid, rng, source, tnode_id, false, indegree_value );
+          inner_connect_( tid, rng, target, tnode_id, false, indegree_value, batch );
         }
       }
     }
@@ -1199,7 +1301,8 @@ nest::FixedInDegreeBuilder::inner_connect_( const int tid,
   Node* target,
   index tnode_id,
   bool skip,
-  long indegree_value )
+  long indegree_value,
+  bool batch )
 {
   const thread target_thread = target->get_thread();
 
@@ -1214,9 +1317,16 @@ nest::FixedInDegreeBuilder::inner_connect_( const int tid,
     return;
   }
 
-  std::set< long > ch_ids;
+  IndexSet& drawn_ids = drawn_ids_[ tid ];
+  if ( not allow_multapses_ )
+  {
+    drawn_ids.clear( std::max( indegree_value, 0L ) );
+  }
   long n_rnd = sources_->size();
 
+  // node IDs of the sources drawn, if connecting in one batch
+  std::vector< index > snode_ids;
+
   for ( long j = 0; j < indegree_value; ++j )
   {
     unsigned long s_id;
@@ -1229,15 +1339,27 @@ nest::FixedInDegreeBuilder::inner_connect_( const int tid,
       s_id = rng->ulrand( n_rnd );
       snode_id = ( *sources_ )[ s_id ];
       skip_autapse = not allow_autapses_ and snode_id == tnode_id;
-      skip_multapse = not allow_multapses_ and ch_ids.find( s_id ) != ch_ids.end();
+      skip_multapse = not allow_multapses_ and drawn_ids.contains( s_id );
     } while ( skip_autapse or skip_multapse );
 
     if ( not allow_multapses_ )
     {
-      ch_ids.insert( s_id );
+      drawn_ids.insert( s_id );
     }
 
-    single_connect_( snode_id, *target, target_thread, rng );
+    if ( batch )
+    {
+      snode_ids.push_back( snode_id );
+    }
+    else
+    {
+      single_connect_( snode_id, *target, target_thread, rng );
+    }
+  }
+
+  if ( batch )
+  {
+    batch_connect_( snode_ids, *target, target_thread, rng );
   }
 }
 
@@ -1304,17 +1426,23 @@ nest::FixedOutDegreeBuilder::connect_()
   // get global rng that is tested for synchronization for all threads
   RngPtr grng = get_rank_synced_rng();
 
+  // targets drawn for the current source, reused for all sources
+  IndexSet drawn_ids;
+
   NodeCollection::const_iterator source_it = sources_->begin();
   for ( ; source_it < sources_->end(); ++source_it )
   {
     const index snode_id = ( *source_it ).node_id;
 
-    std::set< long > ch_ids;
     std::vector< index > tgt_ids_;
     const long n_rnd = targets_->size();
 
     Node* source_node = kernel().node_manager.get_node_or_proxy( snode_id );
     const long outdegree_value = std::round( outdegree_->value( grng, source_node ) );
+    if ( not allow_multapses_ )
+    {
+      drawn_ids.clear( std::max( outdegree_value, 0L ) );
+    }
     for ( long j = 0; j < outdegree_value; ++j )
     {
       unsigned long t_id;
@@ -1327,12 +1455,12 @@ nest::FixedOutDegreeBuilder::connect_()
         t_id = grng->ulrand( n_rnd );
         tnode_id = ( *targets_ )[ t_id ];
         skip_autapse = not allow_autapses_ and tnode_id == snode_id;
-        skip_multapse = not allow_multapses_ and ch_ids.find( t_id ) != ch_ids.end();
+        skip_multapse = not allow_multapses_ and drawn_ids.contains( t_id );
       } while ( skip_autapse or skip_multapse );
 
       if ( not allow_multapses_ )
       {
-        ch_ids.insert( t_id );
+        drawn_ids.insert( t_id );
       }
 
       tgt_ids_.push_back( tnode_id );
@@ -1377,7 +1505,9 @@ nest::FixedTotalNumberBuilder::FixedTotalNumberBuilder( NodeCollectionPTR source
   const std::vector< DictionaryDatum >& syn_specs )
   : ConnBuilder( sources, targets, conn_spec, syn_specs )
   , N_( ( *conn_spec )[ names::N ] )
+  , tree_split_( true )
 {
+  updateValue< bool >( conn_spec, names::tree_split, tree_split_ );
 
   // check for potential errors
 
@@ -1408,9 +1538,21 @@ nest::FixedTotalNumberBuilder::FixedTotalNumberBuilder( NodeCollectionPTR source
 
 void
 nest::FixedTotalNumberBuilder::connect_()
+{
+  if ( tree_split_ )
+  {
+    connect_tree_split_();
+  }
+  else
+  {
+    connect_serial_split_();
+  }
+}
+
+void
+nest::FixedTotalNumberBuilder::connect_serial_split_()
 {
   const int M = kernel().vp_manager.get_num_virtual_processes();
-  const long size_sources = sources_->size();
   const long size_targets = targets_->size();
 
   // drawing connection ids
@@ -1505,31 +1647,102 @@ nest::FixedTotalNumberBuilder::connect_()
 
         assert( thread_local_targets.size() == number_of_targets_on_vp[ vp_id ] );
 
-        while ( num_conns_on_vp[ vp_id ] > 0 )
-        {
+        inner_connect_( tid, rng, thread_local_targets, num_conns_on_vp[ vp_id ] );
+      }
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at
+      // the end of the catch block.
+      exceptions_raised_.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  }
+}
 
-          // draw random numbers for source node from all source neurons
-          const long s_index = rng->ulrand( size_sources );
-          // draw random numbers for target node from
-          // targets_on_vp on this virtual process
-          const long t_index = rng->ulrand( thread_local_targets.size() );
-          // map random number of source node to node ID corresponding to
-          // the source_adr vector
-          const long snode_id = ( *sources_ )[ s_index ];
-          // map random number of target node to node ID using the
-          // targets_on_vp vector
-          const long tnode_id = thread_local_targets[ t_index ];
+void
+nest::FixedTotalNumberBuilder::connect_tree_split_()
+{
+  const size_t M = kernel().vp_manager.get_num_virtual_processes();
+
+  // The number of targets on all virtual processes before each virtual
+  // process allows to compute the number of targets in any range of
+  // virtual processes.
+  const std::vector< size_t > number_of_targets_on_vp = targets_->num_nodes_on_vps();
+  std::vector< size_t > targets_before_vp( M + 1, 0 );
+  std::partial_sum(
+    number_of_targets_on_vp.begin(), number_of_targets_on_vp.end(), targets_before_vp.begin() + 1 );
+
+  // Each node of the tree draws from an RNG seeded by its index, so that
+  // all threads descending through a node draw the same number.
+  RngPtr grng = get_rank_synced_rng();
+  const std::uint32_t seed = grng->ulrand( std::numeric_limits< std::uint32_t >::max() );
 
-          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
-          const thread target_thread = target->get_thread();
+#pragma omp parallel
+  {
+    // get thread id
+    const thread tid = kernel().vp_manager.get_thread_id();
 
-          if ( allow_autapses_ or snode_id != tnode_id )
-          {
-            single_connect_( snode_id, *target, target_thread, rng );
-            num_conns_on_vp[ vp_id ]--;
-          }
+    try
+    {
+      const size_t vp_id = kernel().vp_manager.thread_to_vp( tid );
+
+      // Descend from the root, holding all connections, to the leaf of
+      // the own virtual process. At each node, the connections are split
+      // binomially between the two halves of the range of virtual
+      // processes in proportion to their numbers of targets.
+      std::uint32_t node = 1;
+      size_t vp_begin = 0;
+      size_t vp_end = M;
+      unsigned long num_conns = N_;
+      binomial_distribution bino_dist;
+      while ( vp_end - vp_begin > 1 and num_conns > 0 )
+      {
+        const size_t vp_middle = vp_begin + ( vp_end - vp_begin ) / 2;
+        const size_t targets_in_range = targets_before_vp[ vp_end ] - targets_before_vp[ vp_begin ];
+        const size_t targets_in_first_half = targets_before_vp[ vp_middle ] - targets_before_vp[ vp_begin ];
+
+        unsigned long num_conns_first_half = num_conns;
+        if ( targets_in_first_half == 0 )
+        {
+          num_conns_first_half = 0;
+        }
+        else if ( targets_in_first_half < targets_in_range )
+        {
+          std::unique_ptr< BaseRandomGenerator > node_rng( kernel().random_manager.create_rng( seed, node ) );
+          binomial_distribution::param_type param(
+            num_conns, static_cast< double >( targets_in_first_half ) / targets_in_range );
+          num_conns_first_half = bino_dist( node_rng.get(), param );
+        }
+
+        if ( vp_id < vp_middle )
+        {
+          num_conns = num_conns_first_half;
+          vp_end = vp_middle;
+          node = 2 * node;
+        }
+        else
+        {
+          num_conns -= num_conns_first_half;
+          vp_begin = vp_middle;
+          node = 2 * node + 1;
+        }
+      }
+
+      // nodes without proxies are on every thread, but only count on one
+      // virtual process
+      std::vector< index > thread_local_targets;
+      thread_local_targets.reserve( number_of_targets_on_vp[ vp_id ] );
+      for ( const auto& local_target : targets_->thread_local_nodes( tid ) )
+      {
+        if ( kernel().vp_manager.node_id_to_vp( local_target.second ) == static_cast< thread >( vp_id ) )
+        {
+          thread_local_targets.push_back( local_target.second );
         }
       }
+
+      assert( thread_local_targets.size() == number_of_targets_on_vp[ vp_id ] );
+
+      inner_connect_( tid, get_vp_specific_rng( tid ), thread_local_targets, num_conns );
     }
     catch ( std::exception& err )
     {
@@ -1540,18 +1753,64 @@ nest::FixedTotalNumberBuilder::connect_()
   }
 }
 
+void
+nest::FixedTotalNumberBuilder::inner_connect_( const thread tid,
+  RngPtr rng,
+  const std::vector< index >& thread_local_targets,
+  long num_conns )
+{
+  const long size_sources = sources_->size();
+
+  while ( num_conns > 0 )
+  {
+
+    // draw random numbers for source node from all source neurons
+    const long s_index = rng->ulrand( size_sources );
+    // draw random numbers for target node from
+    // targets_on_vp on this virtual process
+    const long t_index = rng->ulrand( thread_local_targets.size() );
+    // map random number of source node to node ID corresponding to
+    // the source_adr vector
+    const long snode_id = ( *sources_ )[ s_index ];
+    // map random number of target node to node ID using the
+    // targets_on_vp vector
+    const long tnode_id = thread_local_targets[ t_index ];
+
+    Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+    const thread target_thread = target->get_thread();
+
+    if ( allow_autapses_ or snode_id != tnode_id )
+    {
+      single_connect_( snode_id, *target, target_thread, rng );
+      num_conns--;
+    }
+  }
+}
+
 
 nest::BernoulliBuilder::BernoulliBuilder( NodeCollectionPTR sources,
   NodeCollectionPTR targets,
   const DictionaryDatum& conn_spec,
   const std::vector< DictionaryDatum >& syn_specs )
   : ConnBuilder( sources, targets, conn_spec, syn_specs )
+  , geometric_skipping_( true )
+  , p_constant_( -1.0 )
 {
   ParameterDatum* pd = dynamic_cast< ParameterDatum* >( ( *conn_spec )[ names::p ].datum() );
   if ( pd )
   {
     p_ = *pd;
     // TODO: Checks of parameter range
+
+    ConstantParameter* constant = dynamic_cast< ConstantParameter* >( p_.get() );
+    if ( constant )
+    {
+      const double value = constant->value( nullptr, nullptr );
+      if ( 0 <= value and value <= 1 )
+      {
+        p_constant_ = value;
+      }
+    }
   }
   else
   {
@@ -1562,7 +1821,10 @@ nest::BernoulliBuilder::BernoulliBuilder( NodeCollectionPTR sources,
       throw BadProperty( "Connection probability 0 <= p <= 1 required." );
     }
     p_ = std::shared_ptr< Parameter >( new ConstantParameter( value ) );
+    p_constant_ = value;
   }
+
+  updateValue< bool >( conn_spec, names::geometric_skipping, geometric_skipping_ );
 }
 
 
@@ -1578,40 +1840,20 @@ nest::BernoulliBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      size_t next_position = 0;
+      for ( const auto& local_target : targets_->thread_local_nodes( tid ) )
       {
-        NodeCollection::const_iterator target_it = targets_->begin();
-        for ( ; target_it < targets_->end(); ++target_it )
+        const size_t position = local_target.first;
+        if ( position > next_position )
         {
-          const index tnode_id = ( *target_it ).node_id;
-          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
-          if ( target->is_proxy() )
-          {
-            // skip array parameters handled in other virtual processes
-            skip_conn_parameter_( tid );
-            continue;
-          }
-
-          inner_connect_( tid, rng, target, tnode_id );
+          // skip array parameters handled in other virtual processes
+          skip_conn_parameter_( tid, position - next_position );
         }
-      }
-
-      else
-      {
-        const SparseNodeArray& local_nodes = kernel().node_manager.get_local_nodes( tid );
-        SparseNodeArray::const_iterator n;
-        for ( n = local_nodes.begin(); n != local_nodes.end(); ++n )
-        {
-          const index tnode_id = n->get_node_id();
+        next_position = position + 1;
 
-          // Is the local node in the targets list?
-          if ( targets_->find( tnode_id ) < 0 )
-          {
-            continue;
-          }
-
-          inner_connect_( tid, rng, n->get_node(), tnode_id );
-        }
+        const index tnode_id = local_target.second;
+        Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+        inner_connect_( tid, rng, target, tnode_id );
       }
     }
     catch ( std::exception& err )
@@ -1634,6 +1876,12 @@ nest::BernoulliBuilder::inner_connect_( const int tid, RngPtr rng, Node* target,
     return;
   }
 
+  if ( geometric_skipping_ and p_constant_ >= 0 )
+  {
+    inner_connect_geometric_( tid, rng, target, tnode_id );
+    return;
+  }
+
   // It is not possible to create multapses with this type of BernoulliBuilder,
   // hence leave out corresponding checks.
 
@@ -1655,6 +1903,49 @@ nest::BernoulliBuilder::inner_connect_( const int tid, RngPtr rng, Node* target,
   }
 }
 
+void
+nest::BernoulliBuilder::inner_connect_geometric_( const int tid, RngPtr rng, Node* target, index tnode_id )
+{
+  if ( p_constant_ == 0 )
+  {
+    return;
+  }
+
+  // The number of sources skipped before the next connected one is
+  // geometrically distributed, so that each source is still connected
+  // independently with probability p. The work is thus proportional to
+  // the number of connections instead of the number of sources.
+  const size_t n_sources = sources_->size();
+  const bool connect_all = p_constant_ == 1;
+  const double log_q = connect_all ? 0.0 : std::log1p( -p_constant_ );
+
+  size_t i = 0;
+  while ( i < n_sources )
+  {
+    if ( not connect_all )
+    {
+      // 1 - drand() is in ( 0, 1 ], so that the logarithm is finite
+      const double gap = std::floor( std::log( 1.0 - rng->drand() ) / log_q );
+      if ( gap >= n_sources - i )
+      {
+        break;
+      }
+      i += static_cast< size_t >( gap );
+    }
+
+    const index snode_id = ( *sources_ )[ i ];
+    ++i;
+
+    // rejecting an autapse leaves the other pairs independent
+    if ( not allow_autapses_ and snode_id == tnode_id )
+    {
+      continue;
+    }
+
+    single_connect_( snode_id, *target, tid, rng );
+  }
+}
+
 
 nest::SymmetricBernoulliBuilder::SymmetricBernoulliBuilder( NodeCollectionPTR sources,
   NodeCollectionPTR targets,
@@ -35,6 +35,9 @@
 #include <vector>
 #include <set>
 
+// Includes from libnestutil:
+#include "index_set.h"
+
 // Includes from nestkernel:
 #include "conn_parameter.h"
 #include "node_collection.h"
@@ -149,6 +152,29 @@ protected:
 
   //! Create connection between given nodes, fill parameter values
   void single_connect_( index, Node&, thread, RngPtr );
+
+  /**
+   * Create connections from the given sources to one target.
+   *
+   * Evaluates the weights and delays of all connections in one batch per
+   * synapse specification before creating the connections. The result is
+   * the same as calling single_connect_() for each source in turn,
+   * provided that batch_connect_allowed_() returns true.
+   */
+  void batch_connect_( const std::vector< index >&, Node&, thread, RngPtr );
+
+  /**
+   * Check whether batch_connect_() can replace single_connect_().
+   *
+   * This requires that no parameter is given as array and that at most one
+   * of the parameters and the connection rule draws random numbers, so that
+   * evaluating the parameters in batches does not change the order of the
+   * random numbers.
+   *
+   * @param rule_draws_random true if the connection rule draws random
+   * numbers between the connections to a target
+   */
+  bool batch_connect_allowed_( bool rule_draws_random ) const;
   void single_disconnect_( index, Node&, thread );
 
   /**
@@ -162,22 +188,6 @@ protected:
    */
   void skip_conn_parameter_( thread, size_t n_skip = 1 );
 
-  /**
-   * Returns true if conventional looping over targets is indicated.
-   *
-   * Conventional looping over targets must be used if
-   * - any connection parameter requires skipping
-   * - targets are not given as a simple range (lookup otherwise too slow)
-   *
-   * Conventional looping should be used if
-   * - the number of targets is smaller than the number of local nodes
-   *
-   * For background, see Ippen et al (2017).
-   *
-   * @return true if conventional looping is to be used
-   */
-  bool loop_over_targets_() const;
-
   NodeCollectionPTR sources_;
   NodeCollectionPTR targets_;
 
@@ -315,6 +325,7 @@ protected:
 
 private:
   void inner_connect_( const int, RngPtr, Node*, index, bool );
+  void batch_inner_connect_( const int, RngPtr, Node*, index, const std::vector< index >& );
 };
 
 
@@ -330,8 +341,9 @@ protected:
   void connect_();
 
 private:
-  void inner_connect_( const int, RngPtr, Node*, index, bool, long );
+  void inner_connect_( const int, RngPtr, Node*, index, bool, long, bool );
   ParameterDatum indegree_;
+  std::vector< IndexSet > drawn_ids_; //!< sources drawn for the current target, one set per thread
 };
 
 class FixedOutDegreeBuilder : public ConnBuilder
@@ -361,7 +373,29 @@ protected:
   void connect_();
 
 private:
+  /**
+   * Draw the number of connections on each virtual process sequentially,
+   * one binomial draw per virtual process, with the rank-synchronized RNG.
+   */
+  void connect_serial_split_();
+
+  /**
+   * Draw the number of connections on the own virtual process of each
+   * thread by splitting N_ along a binary tree over all virtual processes.
+   * The draw at each node of the tree uses an RNG seeded by the index of
+   * the node, so the result only depends on the number of virtual
+   * processes and each thread only draws along its own path.
+   */
+  void connect_tree_split_();
+
+  /**
+   * Create num_conns connections from randomly drawn sources to randomly
+   * drawn targets among the given targets of the thread.
+   */
+  void inner_connect_( thread tid, RngPtr rng, const std::vector< index >& thread_local_targets, long num_conns );
+
   long N_;
+  bool tree_split_; //!< split N_ over virtual processes along a binary tree
 };
 
 class BernoulliBuilder : public ConnBuilder
@@ -377,7 +411,16 @@ protected:
 
 private:
   void inner_connect_( const int, RngPtr, Node*, index );
-  ParameterDatum p_; //!< connection probability
+
+  /**
+   * Connect the target to the sources selected by drawing the gaps
+   * between them from a geometric distribution. Requires a constant p_.
+   */
+  void inner_connect_geometric_( const int, RngPtr, Node*, index );
+
+  ParameterDatum p_;        //!< connection probability
+  bool geometric_skipping_; //!< skip sources by geometric gaps if p_ is constant
+  double p_constant_;       //!< value of p_ if it is constant, -1 otherwise
 };
 
 class SymmetricBernoulliBuilder : public ConnBuilder
@@ -87,3 +87,14 @@ nest::ParameterConnParameterWrapper::value_double( thread target_thread,
 {
   return parameter_->value( rng, snode_id, target, target_thread );
 }
+
+void
+nest::ParameterConnParameterWrapper::value_double_batch( thread target_thread,
+  RngPtr rng,
+  const index* snode_ids,
+  size_t n,
+  Node* target,
+  double* values ) const
+{
+  parameter_->value_batch( rng, snode_ids, n, target, target_thread, values );
+}
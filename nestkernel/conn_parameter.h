@@ -24,6 +24,7 @@
 #define CONN_PARAMETER_H
 
 // C++ includes:
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -75,6 +76,27 @@ public:
    */
   virtual double value_double( thread, RngPtr, index, Node* ) const = 0;
   virtual long value_int( thread, RngPtr, index, Node* ) const = 0;
+
+  /**
+   * Return parameter values for connections from several sources to one target.
+   *
+   * Fills values[ i ] with the value for the source snode_ids[ i ], for
+   * i < n, in the same way as n calls to value_double().
+   */
+  virtual void
+  value_double_batch( thread target_thread,
+    RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    double* values ) const
+  {
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = value_double( target_thread, rng, snode_ids[ i ], target );
+    }
+  }
+
   virtual void skip( thread, size_t ) const
   {
   }
@@ -92,6 +114,13 @@ public:
     return false;
   }
 
+  //! Return true if the parameter draws random numbers
+  virtual bool
+  uses_rng() const
+  {
+    return false;
+  }
+
   virtual void
   reset() const
   {
@@ -138,6 +167,12 @@ public:
     return value_;
   }
 
+  void
+  value_double_batch( thread, RngPtr, const index*, size_t n, Node*, double* values ) const
+  {
+    std::fill( values, values + n, value_ );
+  }
+
   long
   value_int( thread, RngPtr, index, Node* ) const
   {
@@ -184,6 +219,12 @@ public:
     return static_cast< double >( value_ );
   }
 
+  void
+  value_double_batch( thread, RngPtr, const index*, size_t n, Node*, double* values ) const
+  {
+    std::fill( values, values + n, static_cast< double >( value_ ) );
+  }
+
   long
   value_int( thread, RngPtr, index, Node* ) const
   {
@@ -402,6 +443,13 @@ public:
 
   double value_double( thread target_thread, RngPtr rng, index snode_id, Node* target ) const;
 
+  void value_double_batch( thread target_thread,
+    RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    double* values ) const;
+
   long
   value_int( thread target_thread, RngPtr rng, index snode_id, Node* target ) const
   {
@@ -420,6 +468,12 @@ public:
     return parameter_->returns_int_only();
   }
 
+  bool
+  uses_rng() const
+  {
+    return parameter_->uses_rng();
+  }
+
 private:
   Parameter* parameter_;
 };
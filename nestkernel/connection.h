@@ -231,6 +231,22 @@ public:
     const double,
     const CommonSynapseProperties& );
 
+  /**
+   * Add the connection to the index of incoming connections of its target
+   * if its weight is updated at postsynaptic spikes. Connections updated
+   * only at presynaptic spikes ignore this call.
+   */
+  void
+  register_postdriven_stdp( const thread, const synindex, const index )
+  {
+  }
+
+  /**
+   * Apply all postsynaptic spikes up to the given time to the weight.
+   * This function is needed for postsynaptic-driven STDP.
+   */
+  void apply_postdriven_stdp( const thread, const double, const CommonSynapseProperties& );
+
   Node*
   get_target( const thread tid ) const
   {
@@ -396,6 +412,13 @@ Connection< targetidentifierT >::trigger_update_weight( const thread,
   throw IllegalConnection( "Connection does not support updates that are triggered by a volume transmitter." );
 }
 
+template < typename targetidentifierT >
+inline void
+Connection< targetidentifierT >::apply_postdriven_stdp( const thread, const double, const CommonSynapseProperties& )
+{
+  throw IllegalConnection( "Connection does not support updates that are triggered by the postsynaptic neuron." );
+}
+
 } // namespace nest
 
 #endif // CONNECTION_H
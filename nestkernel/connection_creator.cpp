@@ -39,11 +39,13 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
 {
   Name connection_type;
   long number_of_connections( -1 ); // overwritten by dict entry
+  bool compile_parameters = true;
 
   updateValue< std::string >( dict, names::connection_type, connection_type );
   updateValue< bool >( dict, names::allow_autapses, allow_autapses_ );
   updateValue< bool >( dict, names::allow_multapses, allow_multapses_ );
   updateValue< bool >( dict, names::allow_oversized_mask, allow_oversized_ );
+  updateValue< bool >( dict, names::compile_parameters, compile_parameters );
 
   // Need to store number of connections in a temporary variable to be able to detect negative values.
   if ( updateValue< long >( dict, names::number_of_connections, number_of_connections ) )
@@ -113,6 +115,23 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
     }
   }
 
+  if ( compile_parameters )
+  {
+    // kernel, weights and delays are evaluated for every pair of positions
+    if ( kernel_.get() )
+    {
+      kernel_ = std::shared_ptr< Parameter >( new CompiledParameter( kernel_ ) );
+    }
+    for ( auto& weight : weight_ )
+    {
+      weight = std::shared_ptr< Parameter >( new CompiledParameter( weight ) );
+    }
+    for ( auto& delay : delay_ )
+    {
+      delay = std::shared_ptr< Parameter >( new CompiledParameter( delay ) );
+    }
+  }
+
   if ( connection_type == names::pairwise_bernoulli_on_source )
   {
 
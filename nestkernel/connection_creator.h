@@ -79,6 +79,8 @@ public:
    * - "allow_autapses": Boolean, true if autapses are allowed.
    * - "allow_multapses": Boolean, true if multapses are allowed.
    * - "allow_oversized": Boolean, true if oversized masks are allowed.
+   * - "compile_parameters": Boolean, true (default) if kernel, weights and
+   *   delays are compiled before connecting, see CompiledParameter.
    * - "number_of_connections": Integer, number of connections to make
    *   for each source or target.
    * - "mask": Mask definition (dictionary or masktype).
@@ -39,6 +39,7 @@
 #include "logging.h"
 
 // Includes from nestkernel:
+#include "archiving_node.h"
 #include "clopath_archiving_node.h"
 #include "conn_builder.h"
 #include "conn_builder_factory.h"
@@ -55,7 +56,10 @@
 #include "vp_manager_impl.h"
 
 // Includes from sli:
+#include "arraydatum.h"
 #include "dictutils.h"
+#include "doubledatum.h"
+#include "integerdatum.h"
 #include "sliexceptions.h"
 #include "token.h"
 #include "tokenutils.h"
@@ -134,6 +138,7 @@ nest::ConnectionManager::finalize()
   delete_connections_();
   std::vector< std::vector< ConnectorBase* > >().swap( connections_ );
   std::vector< std::vector< std::vector< size_t > > >().swap( secondary_recv_buffer_pos_ );
+  connection_plan_.stop();
 }
 
 void
@@ -203,6 +208,19 @@ nest::ConnectionManager::get_synapse_status( const index source_node_id,
   ( *dict )[ names::synapse_id ] = syn_id;
   ( *dict )[ names::port ] = lcid;
 
+  get_synapse_status_( source_node_id, target_node_id, tid, syn_id, lcid, dict );
+
+  return dict;
+}
+
+void
+nest::ConnectionManager::get_synapse_status_( const index source_node_id,
+  const index target_node_id,
+  const thread tid,
+  const synindex syn_id,
+  const index lcid,
+  DictionaryDatum& dict ) const
+{
   const Node* source = kernel().node_manager.get_node_or_proxy( source_node_id, tid );
   const Node* target = kernel().node_manager.get_node_or_proxy( target_node_id, tid );
 
@@ -227,8 +245,6 @@ nest::ConnectionManager::get_synapse_status( const index source_node_id,
   {
     assert( false );
   }
-
-  return dict;
 }
 
 void
@@ -503,6 +519,11 @@ nest::ConnectionManager::connect( const index snode_id,
   case NO_CONNECTION:
     return;
   }
+
+  if ( connection_plan_.is_recording() )
+  {
+    connection_plan_.record( target_thread, snode_id, target->get_node_id(), syn_id, params, delay, weight );
+  }
 }
 
 // node_id node_id dict syn_id
@@ -549,6 +570,39 @@ nest::ConnectionManager::connect( const index snode_id,
   return connected;
 }
 
+void
+nest::ConnectionManager::reserve_connections( const thread tid, const synindex syn_id, const size_t count )
+{
+  kernel().model_manager.get_synapse_prototype( syn_id, tid ).reserve_connections( connections_[ tid ], syn_id, count );
+  source_table_.reserve( tid, syn_id, count );
+}
+
+void
+nest::ConnectionManager::start_connection_plan()
+{
+  connection_plan_.start();
+}
+
+DictionaryDatum
+nest::ConnectionManager::end_connection_plan()
+{
+  connection_plan_.stop();
+
+  DictionaryDatum plan( new Dictionary );
+  connection_plan_.get_status( plan );
+  return plan;
+}
+
+void
+nest::ConnectionManager::connect_plan( const DictionaryDatum& plan )
+{
+  if ( connection_plan_.is_recording() )
+  {
+    throw KernelException( "A connection plan cannot be connected while another one is recorded." );
+  }
+  ConnectionPlan::connect( plan );
+}
+
 void
 nest::ConnectionManager::connect_( Node& s,
   Node& r,
@@ -715,6 +769,20 @@ nest::ConnectionManager::trigger_update_weight( const long vt_id,
   }
 }
 
+void
+nest::ConnectionManager::apply_postdriven_stdp( const thread tid,
+  const std::vector< std::pair< synindex, index > >& connections,
+  const double t_lim )
+{
+  const std::vector< ConnectorModel* >& cm = kernel().model_manager.get_synapse_prototypes( tid );
+
+  for ( std::vector< std::pair< synindex, index > >::const_iterator it = connections.begin(); it != connections.end();
+        ++it )
+  {
+    connections_[ tid ][ it->first ]->apply_postdriven_stdp( tid, it->second, t_lim, cm );
+  }
+}
+
 size_t
 nest::ConnectionManager::get_num_target_data( const thread tid ) const
 {
@@ -759,31 +827,30 @@ nest::ConnectionManager::get_num_connections( const synindex syn_id ) const
   return num_connections;
 }
 
-ArrayDatum
-nest::ConnectionManager::get_connections( const DictionaryDatum& params )
+std::vector< nest::synindex >
+nest::ConnectionManager::prepare_get_connections_( const DictionaryDatum& params,
+  NodeCollectionPTR& source,
+  NodeCollectionPTR& target,
+  long& synapse_label )
 {
-  std::deque< ConnectionID > connectome;
   const Token& source_t = params->lookup( names::source );
   const Token& target_t = params->lookup( names::target );
   const Token& syn_model_t = params->lookup( names::synapse_model );
-  NodeCollectionPTR source_a = NodeCollectionPTR( 0 );
-  NodeCollectionPTR target_a = NodeCollectionPTR( 0 );
 
-  long synapse_label = UNLABELED_CONNECTION;
   updateValue< long >( params, names::synapse_label, synapse_label );
 
   if ( not source_t.empty() )
   {
-    source_a = getValue< NodeCollectionDatum >( source_t );
-    if ( not source_a->valid() )
+    source = getValue< NodeCollectionDatum >( source_t );
+    if ( not source->valid() )
     {
       throw KernelException( "GetConnection requires valid source NodeCollection." );
     }
   }
   if ( not target_t.empty() )
   {
-    target_a = getValue< NodeCollectionDatum >( target_t );
-    if ( not target_a->valid() )
+    target = getValue< NodeCollectionDatum >( target_t );
+    if ( not target->valid() )
     {
       throw KernelException( "GetConnection requires valid target NodeCollection." );
     }
@@ -804,7 +871,7 @@ nest::ConnectionManager::get_connections( const DictionaryDatum& params )
     }
   }
 
-  size_t syn_id = 0;
+  std::vector< synindex > syn_ids;
 
   // First we check, whether a synapse model is given.
   // If not, we will iterate all.
@@ -814,22 +881,38 @@ nest::ConnectionManager::get_connections( const DictionaryDatum& params )
     const Token synmodel = kernel().model_manager.get_synapsedict()->lookup( synmodel_name );
     if ( not synmodel.empty() )
     {
-      syn_id = static_cast< size_t >( synmodel );
+      syn_ids.push_back( static_cast< size_t >( synmodel ) );
     }
     else
     {
       throw UnknownModelName( synmodel_name.toString() );
     }
-    get_connections( connectome, source_a, target_a, syn_id, synapse_label );
   }
   else
   {
-    for ( syn_id = 0; syn_id < kernel().model_manager.get_num_synapse_prototypes(); ++syn_id )
+    for ( synindex syn_id = 0; syn_id < kernel().model_manager.get_num_synapse_prototypes(); ++syn_id )
     {
-      get_connections( connectome, source_a, target_a, syn_id, synapse_label );
+      syn_ids.push_back( syn_id );
     }
   }
 
+  return syn_ids;
+}
+
+ArrayDatum
+nest::ConnectionManager::get_connections( const DictionaryDatum& params )
+{
+  std::deque< ConnectionID > connectome;
+  NodeCollectionPTR source_a = NodeCollectionPTR( 0 );
+  NodeCollectionPTR target_a = NodeCollectionPTR( 0 );
+  long synapse_label = UNLABELED_CONNECTION;
+
+  const std::vector< synindex > syn_ids = prepare_get_connections_( params, source_a, target_a, synapse_label );
+  for ( const synindex syn_id : syn_ids )
+  {
+    get_connections( connectome, source_a, target_a, syn_id, synapse_label );
+  }
+
   ArrayDatum result;
   result.reserve( connectome.size() );
 
@@ -844,6 +927,218 @@ nest::ConnectionManager::get_connections( const DictionaryDatum& params )
   return result;
 }
 
+// Returns the value of key in dict as double, or NaN if dict has no such
+// entry.
+static inline double
+get_numerical_value( const DictionaryDatum& dict, const Name& key )
+{
+  const Token& value = dict->lookup( key );
+  if ( value.empty() )
+  {
+    return std::numeric_limits< double >::quiet_NaN();
+  }
+
+  const IntegerDatum* integer_value = dynamic_cast< IntegerDatum* >( value.datum() );
+  if ( integer_value != nullptr )
+  {
+    return integer_value->get();
+  }
+  return getValue< double >( value );
+}
+
+DictionaryDatum
+nest::ConnectionManager::get_connection_arrays( const DictionaryDatum& params )
+{
+  NodeCollectionPTR source_a = NodeCollectionPTR( 0 );
+  NodeCollectionPTR target_a = NodeCollectionPTR( 0 );
+  long synapse_label = UNLABELED_CONNECTION;
+
+  const std::vector< synindex > syn_ids = prepare_get_connections_( params, source_a, target_a, synapse_label );
+
+  if ( is_source_table_cleared() )
+  {
+    throw KernelException(
+      "Invalid attempt to access connection information: source table was "
+      "cleared." );
+  }
+
+  const thread num_threads = kernel().vp_manager.get_num_threads();
+
+  long target_thread = -1;
+  if ( updateValue< long >( params, names::target_thread, target_thread )
+    and ( target_thread < 0 or target_thread >= num_threads ) )
+  {
+    throw BadProperty( String::compose( "target_thread must be between 0 and %1.", num_threads - 1 ) );
+  }
+
+  std::vector< Name > keys;
+  if ( params->known( names::keys ) )
+  {
+    const ArrayDatum key_array = getValue< ArrayDatum >( params, names::keys );
+    for ( const Token& key : key_array )
+    {
+      keys.push_back( Name( getValue< std::string >( key ) ) );
+    }
+  }
+
+  std::vector< long >* sources = new std::vector< long >();
+  std::vector< long >* targets = new std::vector< long >();
+  std::vector< long >* target_threads = new std::vector< long >();
+  std::vector< long >* synapse_ids = new std::vector< long >();
+  std::vector< long >* ports = new std::vector< long >();
+
+  DictionaryDatum result( new Dictionary );
+  ( *result )[ names::source ] = IntVectorDatum( sources );
+  ( *result )[ names::target ] = IntVectorDatum( targets );
+  ( *result )[ names::target_thread ] = IntVectorDatum( target_threads );
+  ( *result )[ names::synapse_id ] = IntVectorDatum( synapse_ids );
+  ( *result )[ names::port ] = IntVectorDatum( ports );
+
+  ArrayDatum synapse_models;
+  for ( synindex syn_id = 0; syn_id < kernel().model_manager.get_num_synapse_prototypes(); ++syn_id )
+  {
+    synapse_models.push_back( new LiteralDatum( kernel().model_manager.get_synapse_prototype( syn_id ).get_name() ) );
+  }
+  ( *result )[ names::synapse_models ] = synapse_models;
+
+  // Each thread collects the connections it stores and writes the
+  // connections of each synapse type to its own contiguous range of the
+  // columns, starting at offsets[ s * num_threads + tid ] for the s-th
+  // synapse type. As for get_connections(), the columns hold the
+  // connections grouped by synapse type.
+  const size_t num_syn_ids = syn_ids.size();
+  std::vector< size_t > offsets( num_syn_ids * num_threads + 1, 0 );
+
+#pragma omp parallel
+  {
+    const thread tid = kernel().vp_manager.get_thread_id();
+
+    std::vector< std::deque< ConnectionID > > conns_in_thread( num_syn_ids );
+    if ( target_thread < 0 or target_thread == tid )
+    {
+      for ( size_t s = 0; s < num_syn_ids; ++s )
+      {
+        get_connections_in_thread_( tid, conns_in_thread[ s ], source_a, target_a, syn_ids[ s ], synapse_label );
+        offsets[ s * num_threads + tid + 1 ] = conns_in_thread[ s ].size();
+      }
+    }
+
+#pragma omp barrier
+#pragma omp single
+    {
+      for ( size_t i = 1; i < offsets.size(); ++i )
+      {
+        offsets[ i ] += offsets[ i - 1 ];
+      }
+      const size_t num_connections = offsets.back();
+      sources->resize( num_connections );
+      targets->resize( num_connections );
+      target_threads->resize( num_connections );
+      synapse_ids->resize( num_connections );
+      ports->resize( num_connections );
+    } // of omp single; implicit barrier
+
+    for ( size_t s = 0; s < num_syn_ids; ++s )
+    {
+      size_t i = offsets[ s * num_threads + tid ];
+      for ( const ConnectionID& conn : conns_in_thread[ s ] )
+      {
+        ( *sources )[ i ] = conn.get_source_node_id();
+        ( *targets )[ i ] = conn.get_target_node_id();
+        ( *target_threads )[ i ] = conn.get_target_thread();
+        ( *synapse_ids )[ i ] = conn.get_synapse_model_id();
+        ( *ports )[ i ] = conn.get_port();
+        ++i;
+      }
+    }
+  } // of omp parallel
+
+  for ( const Name& key : keys )
+  {
+    ( *result )[ key ] = DoubleVectorDatum( new std::vector< double >( sources->size() ) );
+  }
+  get_connection_values_( result, keys, result );
+
+  set_has_get_connections_been_called( true );
+
+  return result;
+}
+
+DictionaryDatum
+nest::ConnectionManager::get_connection_values( const DictionaryDatum& connections, const ArrayDatum& keys )
+{
+  const IntVectorDatum sources = getValue< IntVectorDatum >( connections, names::source );
+  const IntVectorDatum targets = getValue< IntVectorDatum >( connections, names::target );
+  const IntVectorDatum target_threads = getValue< IntVectorDatum >( connections, names::target_thread );
+  const IntVectorDatum synapse_ids = getValue< IntVectorDatum >( connections, names::synapse_id );
+  const IntVectorDatum ports = getValue< IntVectorDatum >( connections, names::port );
+
+  const size_t num_connections = sources->size();
+  if ( targets->size() != num_connections or target_threads->size() != num_connections
+    or synapse_ids->size() != num_connections or ports->size() != num_connections )
+  {
+    throw DimensionMismatch( "All columns of the connections must have the same length." );
+  }
+
+  const thread num_threads = kernel().vp_manager.get_num_threads();
+  for ( size_t i = 0; i < num_connections; ++i )
+  {
+    if ( ( *target_threads )[ i ] < 0 or ( *target_threads )[ i ] >= num_threads )
+    {
+      throw BadProperty( String::compose( "target_thread must be between 0 and %1.", num_threads - 1 ) );
+    }
+    kernel().model_manager.assert_valid_syn_id( ( *synapse_ids )[ i ] );
+  }
+
+  std::vector< Name > key_names;
+  DictionaryDatum result( new Dictionary );
+  for ( const Token& key : keys )
+  {
+    key_names.push_back( Name( getValue< std::string >( key ) ) );
+    ( *result )[ key_names.back() ] = DoubleVectorDatum( new std::vector< double >( num_connections ) );
+  }
+  get_connection_values_( connections, key_names, result );
+
+  return result;
+}
+
+void
+nest::ConnectionManager::get_connection_values_( const DictionaryDatum& connections,
+  const std::vector< Name >& keys,
+  DictionaryDatum& values ) const
+{
+  if ( keys.empty() )
+  {
+    return;
+  }
+
+  const IntVectorDatum sources = getValue< IntVectorDatum >( connections, names::source );
+  const IntVectorDatum targets = getValue< IntVectorDatum >( connections, names::target );
+  const IntVectorDatum target_threads = getValue< IntVectorDatum >( connections, names::target_thread );
+  const IntVectorDatum synapse_ids = getValue< IntVectorDatum >( connections, names::synapse_id );
+  const IntVectorDatum ports = getValue< IntVectorDatum >( connections, names::port );
+
+  std::vector< DoubleVectorDatum > columns;
+  for ( const Name& key : keys )
+  {
+    columns.push_back( getValue< DoubleVectorDatum >( values, key ) );
+  }
+
+  // The status dictionaries are filled serially, as the SLI datums they
+  // hold are allocated from memory pools that are not thread-safe.
+  DictionaryDatum status( new Dictionary );
+  for ( size_t i = 0; i < sources->size(); ++i )
+  {
+    status->clear();
+    get_synapse_status_(
+      ( *sources )[ i ], ( *targets )[ i ], ( *target_threads )[ i ], ( *synapse_ids )[ i ], ( *ports )[ i ], status );
+    for ( size_t k = 0; k < keys.size(); ++k )
+    {
+      ( *columns[ k ] )[ i ] = get_numerical_value( status, keys[ k ] );
+    }
+  }
+}
+
 // Helper method which removes ConnectionIDs from input deque and
 // appends them to output deque.
 static inline std::deque< nest::ConnectionID >&
@@ -904,168 +1199,144 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
     return;
   }
 
-  if ( not source.get() and not target.get() )
-  {
 #pragma omp parallel
-    {
-      thread tid = kernel().vp_manager.get_thread_id();
+  {
+    thread tid = kernel().vp_manager.get_thread_id();
 
-      std::deque< ConnectionID > conns_in_thread;
+    std::deque< ConnectionID > conns_in_thread;
 
-      ConnectorBase* connections = connections_[ tid ][ syn_id ];
-      if ( connections != NULL )
-      {
-        // Passing target_node_id = 0 ignores target_node_id while getting connections.
-        const size_t num_connections_in_thread = connections->size();
-        for ( index lcid = 0; lcid < num_connections_in_thread; ++lcid )
-        {
-          const index source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
-          connections->get_connection( source_node_id, 0, tid, lcid, synapse_label, conns_in_thread );
-        }
-      }
+    get_connections_in_thread_( tid, conns_in_thread, source, target, syn_id, synapse_label );
 
-      target_table_devices_.get_connections( 0, 0, tid, syn_id, synapse_label, conns_in_thread );
-
-      if ( conns_in_thread.size() > 0 )
-      {
+    if ( conns_in_thread.size() > 0 )
+    {
 #pragma omp critical( get_connections )
-        {
-          extend_connectome( connectome, conns_in_thread );
-        }
+      {
+        extend_connectome( connectome, conns_in_thread );
       }
-    } // of omp parallel
-    return;
-  } // if
-  else if ( not source.get() and target.get() )
+    }
+  } // of omp parallel
+}
+
+void
+nest::ConnectionManager::get_connections_in_thread_( const thread tid,
+  std::deque< ConnectionID >& conns_in_thread,
+  NodeCollectionPTR source,
+  NodeCollectionPTR target,
+  synindex syn_id,
+  long synapse_label ) const
+{
+  if ( not source.get() and not target.get() )
   {
-#pragma omp parallel
+    ConnectorBase* connections = connections_[ tid ][ syn_id ];
+    if ( connections != NULL )
     {
-      thread tid = kernel().vp_manager.get_thread_id();
-
-      std::deque< ConnectionID > conns_in_thread;
-
-      // Split targets into neuron- and device-vectors.
-      std::vector< index > target_neuron_node_ids;
-      std::vector< index > target_device_node_ids;
-      split_to_neuron_device_vectors_( tid, target, target_neuron_node_ids, target_device_node_ids );
-
-      // Getting regular connections, if they exist.
-      ConnectorBase* connections = connections_[ tid ][ syn_id ];
-      if ( connections != nullptr )
+      // Passing target_node_id = 0 ignores target_node_id while getting connections.
+      const size_t num_connections_in_thread = connections->size();
+      for ( index lcid = 0; lcid < num_connections_in_thread; ++lcid )
       {
-        const size_t num_connections_in_thread = connections->size();
-        for ( index lcid = 0; lcid < num_connections_in_thread; ++lcid )
-        {
-          const index source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
-          connections->get_connection_with_specified_targets(
-            source_node_id, target_neuron_node_ids, tid, lcid, synapse_label, conns_in_thread );
-        }
+        const index source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
+        connections->get_connection( source_node_id, 0, tid, lcid, synapse_label, conns_in_thread );
       }
+    }
 
-      // Getting connections from devices.
-      for ( auto t_node_id : target_neuron_node_ids )
-      {
-        target_table_devices_.get_connections_from_devices_(
-          0, t_node_id, tid, syn_id, synapse_label, conns_in_thread );
-      }
+    target_table_devices_.get_connections( 0, 0, tid, syn_id, synapse_label, conns_in_thread );
+  }
+  else if ( not source.get() and target.get() )
+  {
+    // Split targets into neuron- and device-vectors.
+    std::vector< index > target_neuron_node_ids;
+    std::vector< index > target_device_node_ids;
+    split_to_neuron_device_vectors_( tid, target, target_neuron_node_ids, target_device_node_ids );
 
-      // Getting connections to devices.
-      for ( auto t_device_id : target_device_node_ids )
+    // Getting regular connections, if they exist.
+    ConnectorBase* connections = connections_[ tid ][ syn_id ];
+    if ( connections != nullptr )
+    {
+      const size_t num_connections_in_thread = connections->size();
+      for ( index lcid = 0; lcid < num_connections_in_thread; ++lcid )
       {
-        target_table_devices_.get_connections_to_devices_(
-          0, t_device_id, tid, syn_id, synapse_label, conns_in_thread );
+        const index source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
+        connections->get_connection_with_specified_targets(
+          source_node_id, target_neuron_node_ids, tid, lcid, synapse_label, conns_in_thread );
       }
+    }
 
-      if ( conns_in_thread.size() > 0 )
-      {
-#pragma omp critical( get_connections )
-        {
-          extend_connectome( connectome, conns_in_thread );
-        }
-      }
-    } // of omp parallel
-    return;
-  } // else if
+    // Getting connections from devices.
+    for ( auto t_node_id : target_neuron_node_ids )
+    {
+      target_table_devices_.get_connections_from_devices_( 0, t_node_id, tid, syn_id, synapse_label, conns_in_thread );
+    }
+
+    // Getting connections to devices.
+    for ( auto t_device_id : target_device_node_ids )
+    {
+      target_table_devices_.get_connections_to_devices_( 0, t_device_id, tid, syn_id, synapse_label, conns_in_thread );
+    }
+  }
   else if ( source.get() )
   {
-#pragma omp parallel
+    // Split targets into neuron- and device-vectors.
+    std::vector< index > target_neuron_node_ids;
+    std::vector< index > target_device_node_ids;
+    if ( target.get() )
     {
-      thread tid = kernel().vp_manager.get_thread_id();
-
-      std::deque< ConnectionID > conns_in_thread;
-
-      // Split targets into neuron- and device-vectors.
-      std::vector< index > target_neuron_node_ids;
-      std::vector< index > target_device_node_ids;
-      if ( target.get() )
-      {
-        split_to_neuron_device_vectors_( tid, target, target_neuron_node_ids, target_device_node_ids );
-      }
-
-      const ConnectorBase* connections = connections_[ tid ][ syn_id ];
-      if ( connections != NULL )
-      {
-        const size_t num_connections_in_thread = connections->size();
-        for ( index lcid = 0; lcid < num_connections_in_thread; ++lcid )
-        {
-          const index source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
-          if ( source->contains( source_node_id ) )
-          {
-            if ( not target.get() )
-            {
-              // Passing target_node_id = 0 ignores target_node_id while getting
-              // connections.
-              connections->get_connection( source_node_id, 0, tid, lcid, synapse_label, conns_in_thread );
-            }
-            else
-            {
-              connections->get_connection_with_specified_targets(
-                source_node_id, target_neuron_node_ids, tid, lcid, synapse_label, conns_in_thread );
-            }
-          }
-        }
-      }
+      split_to_neuron_device_vectors_( tid, target, target_neuron_node_ids, target_device_node_ids );
+    }
 
-      NodeCollection::const_iterator s_id = source->begin();
-      for ( ; s_id < source->end(); ++s_id )
+    const ConnectorBase* connections = connections_[ tid ][ syn_id ];
+    if ( connections != NULL )
+    {
+      const size_t num_connections_in_thread = connections->size();
+      for ( index lcid = 0; lcid < num_connections_in_thread; ++lcid )
       {
-        const index source_node_id = ( *s_id ).node_id;
-        if ( not target.get() )
-        {
-          target_table_devices_.get_connections( source_node_id, 0, tid, syn_id, synapse_label, conns_in_thread );
-        }
-        else
+        const index source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
+        if ( source->contains( source_node_id ) )
         {
-          for ( std::vector< index >::const_iterator t_node_id = target_neuron_node_ids.begin();
-                t_node_id != target_neuron_node_ids.end();
-                ++t_node_id )
+          if ( not target.get() )
           {
-            // target_table_devices_ contains connections both to and from
-            // devices. First we get connections from devices.
-            target_table_devices_.get_connections_from_devices_(
-              source_node_id, *t_node_id, tid, syn_id, synapse_label, conns_in_thread );
+            // Passing target_node_id = 0 ignores target_node_id while getting
+            // connections.
+            connections->get_connection( source_node_id, 0, tid, lcid, synapse_label, conns_in_thread );
           }
-          for ( std::vector< index >::const_iterator t_node_id = target_device_node_ids.begin();
-                t_node_id != target_device_node_ids.end();
-                ++t_node_id )
+          else
           {
-            // Then, we get connections to devices.
-            target_table_devices_.get_connections_to_devices_(
-              source_node_id, *t_node_id, tid, syn_id, synapse_label, conns_in_thread );
+            connections->get_connection_with_specified_targets(
+              source_node_id, target_neuron_node_ids, tid, lcid, synapse_label, conns_in_thread );
           }
         }
       }
+    }
 
-      if ( conns_in_thread.size() > 0 )
+    NodeCollection::const_iterator s_id = source->begin();
+    for ( ; s_id < source->end(); ++s_id )
+    {
+      const index source_node_id = ( *s_id ).node_id;
+      if ( not target.get() )
       {
-#pragma omp critical( get_connections )
+        target_table_devices_.get_connections( source_node_id, 0, tid, syn_id, synapse_label, conns_in_thread );
+      }
+      else
+      {
+        for ( std::vector< index >::const_iterator t_node_id = target_neuron_node_ids.begin();
+              t_node_id != target_neuron_node_ids.end();
+              ++t_node_id )
         {
-          extend_connectome( connectome, conns_in_thread );
+          // target_table_devices_ contains connections both to and from
+          // devices. First we get connections from devices.
+          target_table_devices_.get_connections_from_devices_(
+            source_node_id, *t_node_id, tid, syn_id, synapse_label, conns_in_thread );
+        }
+        for ( std::vector< index >::const_iterator t_node_id = target_device_node_ids.begin();
+              t_node_id != target_device_node_ids.end();
+              ++t_node_id )
+        {
+          // Then, we get connections to devices.
+          target_table_devices_.get_connections_to_devices_(
+            source_node_id, *t_node_id, tid, syn_id, synapse_label, conns_in_thread );
         }
       }
-    } // of omp parallel
-    return;
-  } // else if
+    }
+  }
 }
 
 void
@@ -1144,6 +1415,29 @@ nest::ConnectionManager::sort_connections( const thread tid )
   }
 }
 
+void
+nest::ConnectionManager::register_postdriven_stdp( const thread tid )
+{
+  for ( SparseNodeArray::const_iterator i = kernel().node_manager.get_local_nodes( tid ).begin();
+        i != kernel().node_manager.get_local_nodes( tid ).end();
+        ++i )
+  {
+    ArchivingNode* node = dynamic_cast< ArchivingNode* >( i->get_node() );
+    if ( node != NULL )
+    {
+      node->clear_postdriven_stdp_connections();
+    }
+  }
+
+  for ( synindex syn_id = 0; syn_id < connections_[ tid ].size(); ++syn_id )
+  {
+    if ( connections_[ tid ][ syn_id ] != NULL )
+    {
+      connections_[ tid ][ syn_id ]->register_postdriven_stdp( tid );
+    }
+  }
+}
+
 void
 nest::ConnectionManager::compute_target_data_buffer_size()
 {
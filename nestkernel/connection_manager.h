@@ -33,6 +33,7 @@
 // Includes from nestkernel:
 #include "conn_builder.h"
 #include "connection_id.h"
+#include "connection_plan.h"
 #include "connector_base.h"
 #include "node_collection.h"
 #include "nest_time.h"
@@ -146,6 +147,30 @@ public:
    */
   bool connect( const index snode_id, const index target, const DictionaryDatum& params, const synindex syn_id );
 
+  /**
+   * Make room for count further connections of synapse type syn_id on
+   * thread tid, so that inserting many connections at once does not
+   * allocate block after block.
+   */
+  void reserve_connections( const thread tid, const synindex syn_id, const size_t count );
+
+  /**
+   * Clear the connection plan and record all connections created from now
+   * on into it.
+   */
+  void start_connection_plan();
+
+  /**
+   * Stop recording and return the connection plan.
+   */
+  DictionaryDatum end_connection_plan();
+
+  /**
+   * Create the connections of a connection plan returned by
+   * end_connection_plan(), without running any connection builder.
+   */
+  void connect_plan( const DictionaryDatum& plan );
+
   index find_connection( const thread tid, const synindex syn_id, const index snode_id, const index tnode_id );
 
   void disconnect( const thread tid, const synindex syn_id, const index snode_id, const index tnode_id );
@@ -196,6 +221,33 @@ public:
     synindex syn_id,
     long synapse_label ) const;
 
+  /**
+   * Return the connections selected by params as columns.
+   *
+   * params takes the same entries as get_connections(). The result holds
+   * the integer vectors 'source', 'target', 'target_thread', 'synapse_id'
+   * and 'port' with one entry per connection, and the names of all synapse
+   * models indexed by synapse ID in 'synapse_models'. The connections of
+   * each thread are collected and written in parallel; the columns hold
+   * them grouped by synapse type and, within each type, by thread.
+   * 'keys' array of names of numerical synapse parameters, e.g. weight and
+   * delay, for which double vectors are added, see get_connection_values().
+   * 'target_thread' only returns the connections stored on the given
+   * thread, which allows iterating over large networks in chunks.
+   */
+  DictionaryDatum get_connection_arrays( const DictionaryDatum& params );
+
+  /**
+   * Return the values of numerical synapse parameters for connections
+   * given as columns.
+   *
+   * connections holds the columns 'source', 'target', 'target_thread',
+   * 'synapse_id' and 'port' as returned by get_connection_arrays(). The
+   * result maps each of the keys to a double vector. Connections which do
+   * not have the parameter get NaN.
+   */
+  DictionaryDatum get_connection_values( const DictionaryDatum& connections, const ArrayDatum& keys );
+
   /**
    * Returns the number of connections in the network.
    */
@@ -226,6 +278,16 @@ public:
   void
   trigger_update_weight( const long vt_node_id, const std::vector< spikecounter >& dopa_spikes, const double t_trig );
 
+  /**
+   * Triggered by a neuron when it spikes.
+   * Applies all postsynaptic spikes up to t_lim to the given incoming
+   * postsynaptic-driven STDP connections of the neuron, which are
+   * identified by synapse type and local connection id.
+   */
+  void apply_postdriven_stdp( const thread tid,
+    const std::vector< std::pair< synindex, index > >& connections,
+    const double t_lim );
+
   /**
    * Return minimal connection delay, which is precomputed by
    * update_delay_extrema_().
@@ -321,6 +383,13 @@ public:
    */
   void sort_connections( const thread tid );
 
+  /**
+   * Rebuilds the indices of incoming postsynaptic-driven STDP connections
+   * of all nodes on the given thread. Needs to be called after connections
+   * have been sorted, since sorting changes local connection ids.
+   */
+  void register_postdriven_stdp( const thread tid );
+
   /**
    * Removes disabled connections (of structural plasticity)
    */
@@ -414,6 +483,46 @@ private:
     std::vector< index >& neuron_node_ids,
     std::vector< index >& device_node_ids ) const;
 
+  /**
+   * Reads the selection of get_connections() and get_connection_arrays()
+   * from params and returns the IDs of the synapse models to search.
+   * Updates the connection infrastructure if connections have changed.
+   */
+  std::vector< synindex > prepare_get_connections_( const DictionaryDatum& params,
+    NodeCollectionPTR& source,
+    NodeCollectionPTR& target,
+    long& synapse_label );
+
+  /**
+   * Appends the connections of the given synapse type stored on thread tid
+   * to conns_in_thread.
+   */
+  void get_connections_in_thread_( const thread tid,
+    std::deque< ConnectionID >& conns_in_thread,
+    NodeCollectionPTR source,
+    NodeCollectionPTR target,
+    synindex syn_id,
+    long synapse_label ) const;
+
+  /**
+   * Writes the values of the given synapse parameters for the connections
+   * in the columns of connections to the double vectors of the same names
+   * in values.
+   */
+  void get_connection_values_( const DictionaryDatum& connections,
+    const std::vector< Name >& keys,
+    DictionaryDatum& values ) const;
+
+  /**
+   * Adds the status of the given connection to dict.
+   */
+  void get_synapse_status_( const index source_node_id,
+    const index target_node_id,
+    const thread tid,
+    const synindex syn_id,
+    const index lcid,
+    DictionaryDatum& dict ) const;
+
   /**
    * Update delay extrema to current values.
    *
@@ -559,6 +668,9 @@ private:
 
   std::vector< DelayChecker > delay_checkers_;
 
+  //! Connections recorded between start_ and end_connection_plan().
+  ConnectionPlan connection_plan_;
+
   /**
    * A structure to count the number of synapses of a specific
    * type. Arranged in a 2d structure: threads|synapsetypes.
@@ -0,0 +1,332 @@
+/*
+ *  connection_plan.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "connection_plan.h"
+
+// C++ includes:
+#include <cmath>
+#include <memory>
+
+// Includes from libnestutil:
+#include "compose.hpp"
+#include "numerics.h"
+
+// Includes from nestkernel:
+#include "connector_model.h"
+#include "exceptions.h"
+#include "kernel_manager.h"
+#include "nest_names.h"
+#include "vp_manager_impl.h"
+
+// Includes from sli:
+#include "arraydatum.h"
+#include "dict.h"
+#include "dictutils.h"
+#include "doubledatum.h"
+#include "integerdatum.h"
+
+nest::ConnectionPlan::ConnectionPlan()
+  : recording_( false )
+{
+}
+
+void
+nest::ConnectionPlan::start()
+{
+  thread_plans_.clear();
+  thread_plans_.resize( kernel().vp_manager.get_num_threads() );
+  recording_ = true;
+}
+
+void
+nest::ConnectionPlan::stop()
+{
+  recording_ = false;
+}
+
+void
+nest::ConnectionPlan::record( const thread tid,
+  const index snode_id,
+  const index tnode_id,
+  const synindex syn_id,
+  const DictionaryDatum& params,
+  const double delay,
+  const double weight )
+{
+  ThreadPlan& plan = thread_plans_[ tid ];
+  const size_t n = plan.sources.size();
+
+  plan.sources.push_back( snode_id );
+  plan.targets.push_back( tnode_id );
+  plan.synapse_models.push_back( syn_id );
+  plan.weights.push_back( weight );
+  plan.delays.push_back( delay );
+
+  if ( params.valid() )
+  {
+    for ( Dictionary::const_iterator param = params->begin(); param != params->end(); ++param )
+    {
+      std::vector< double >& values = plan.parameters[ param->first ];
+      values.resize( n, numerics::nan );
+
+      // connection builders only pass integer and double parameters
+      IntegerDatum* id = dynamic_cast< IntegerDatum* >( param->second.datum() );
+      values.push_back( id ? id->get() : getValue< double >( param->second ) );
+    }
+  }
+}
+
+void
+nest::ConnectionPlan::get_status( DictionaryDatum& d ) const
+{
+  def< long >( d, names::num_processes, kernel().mpi_manager.get_num_processes() );
+  def< long >( d, names::total_num_virtual_procs, kernel().vp_manager.get_num_virtual_processes() );
+
+  ArrayDatum synapse_models;
+  for ( synindex syn_id = 0; syn_id < kernel().model_manager.get_num_synapse_prototypes(); ++syn_id )
+  {
+    synapse_models.push_back( new LiteralDatum( kernel().model_manager.get_synapse_prototype( syn_id ).get_name() ) );
+  }
+  ( *d )[ names::synapse_models ] = synapse_models;
+
+  ArrayDatum vps;
+  ArrayDatum sources;
+  ArrayDatum targets;
+  ArrayDatum synapse_model;
+  ArrayDatum weights;
+  ArrayDatum delays;
+  DictionaryDatum parameters( new Dictionary );
+
+  // names of the parameters recorded on any thread
+  for ( const auto& plan : thread_plans_ )
+  {
+    for ( const auto& param : plan.parameters )
+    {
+      ( *parameters )[ param.first ] = ArrayDatum();
+    }
+  }
+
+  for ( thread tid = 0; tid < static_cast< thread >( thread_plans_.size() ); ++tid )
+  {
+    const ThreadPlan& plan = thread_plans_[ tid ];
+    const size_t n = plan.sources.size();
+
+    vps.push_back( kernel().vp_manager.thread_to_vp( tid ) );
+    sources.push_back( new IntVectorDatum( new std::vector< long >( plan.sources ) ) );
+    targets.push_back( new IntVectorDatum( new std::vector< long >( plan.targets ) ) );
+    synapse_model.push_back( new IntVectorDatum( new std::vector< long >( plan.synapse_models ) ) );
+    weights.push_back( new DoubleVectorDatum( new std::vector< double >( plan.weights ) ) );
+    delays.push_back( new DoubleVectorDatum( new std::vector< double >( plan.delays ) ) );
+
+    for ( auto& param : *parameters )
+    {
+      std::vector< double >* values = new std::vector< double >( n, numerics::nan );
+      const auto recorded = plan.parameters.find( param.first );
+      if ( recorded != plan.parameters.end() )
+      {
+        std::copy( recorded->second.begin(), recorded->second.end(), values->begin() );
+      }
+      ArrayDatum* values_on_vps = static_cast< ArrayDatum* >( param.second.datum() );
+      values_on_vps->push_back( new DoubleVectorDatum( values ) );
+    }
+  }
+
+  ( *d )[ names::virtual_processes ] = vps;
+  ( *d )[ names::sources ] = sources;
+  ( *d )[ names::targets ] = targets;
+  ( *d )[ names::synapse_model ] = synapse_model;
+  ( *d )[ names::weights ] = weights;
+  ( *d )[ names::delays ] = delays;
+  ( *d )[ names::synapse_parameters ] = parameters;
+}
+
+void
+nest::ConnectionPlan::connect( const DictionaryDatum& plan )
+{
+  const long num_processes = getValue< long >( plan, names::num_processes );
+  const long num_vps = getValue< long >( plan, names::total_num_virtual_procs );
+  if ( num_processes != kernel().mpi_manager.get_num_processes()
+    or num_vps != kernel().vp_manager.get_num_virtual_processes() )
+  {
+    throw BadProperty( String::compose(
+      "The connection plan was recorded with %1 MPI processes and %2 virtual processes, "
+      "but the kernel uses %3 MPI processes and %4 virtual processes.",
+      num_processes,
+      num_vps,
+      kernel().mpi_manager.get_num_processes(),
+      kernel().vp_manager.get_num_virtual_processes() ) );
+  }
+
+  // synapse models are identified by name, as their IDs may differ
+  const ArrayDatum synapse_model_names = getValue< ArrayDatum >( plan, names::synapse_models );
+  std::vector< synindex > syn_ids;
+  for ( const Token& name : synapse_model_names )
+  {
+    const Token syn_id = kernel().model_manager.get_synapsedict()->lookup( getValue< std::string >( name ) );
+    if ( syn_id.empty() )
+    {
+      throw UnknownSynapseType( getValue< std::string >( name ) );
+    }
+    syn_ids.push_back( static_cast< synindex >( getValue< long >( syn_id ) ) );
+  }
+
+  const ArrayDatum vps = getValue< ArrayDatum >( plan, names::virtual_processes );
+  const ArrayDatum sources = getValue< ArrayDatum >( plan, names::sources );
+  const ArrayDatum targets = getValue< ArrayDatum >( plan, names::targets );
+  const ArrayDatum synapse_model = getValue< ArrayDatum >( plan, names::synapse_model );
+  const ArrayDatum weights = getValue< ArrayDatum >( plan, names::weights );
+  const ArrayDatum delays = getValue< ArrayDatum >( plan, names::delays );
+  const DictionaryDatum parameters = getValue< DictionaryDatum >( plan, names::synapse_parameters );
+
+  const thread num_threads = kernel().vp_manager.get_num_threads();
+  if ( static_cast< thread >( vps.size() ) != num_threads )
+  {
+    throw BadProperty( "The connection plan must contain the connections of all threads." );
+  }
+
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
+
+#pragma omp parallel
+  {
+    const thread tid = kernel().vp_manager.get_thread_id();
+
+    try
+    {
+      const thread vp = kernel().vp_manager.thread_to_vp( tid );
+
+      // the entries of the plan are ordered by thread on each MPI process
+      if ( getValue< long >( vps[ tid ] ) != vp )
+      {
+        throw BadProperty( "The connection plan was recorded on a different MPI process." );
+      }
+
+      // the datums share the arrays of the plan
+      const IntVectorDatum vp_sources = getValue< IntVectorDatum >( sources[ tid ] );
+      const IntVectorDatum vp_targets = getValue< IntVectorDatum >( targets[ tid ] );
+      const IntVectorDatum vp_synapse_model = getValue< IntVectorDatum >( synapse_model[ tid ] );
+      const DoubleVectorDatum vp_weights = getValue< DoubleVectorDatum >( weights[ tid ] );
+      const DoubleVectorDatum vp_delays = getValue< DoubleVectorDatum >( delays[ tid ] );
+
+      const size_t n = vp_sources->size();
+      if ( vp_targets->size() != n or vp_synapse_model->size() != n or vp_weights->size() != n
+        or vp_delays->size() != n )
+      {
+        throw BadProperty( "All arrays of a virtual process in a connection plan must have the same length." );
+      }
+
+      std::vector< std::pair< Name, DoubleVectorDatum > > vp_parameters;
+      for ( const auto& param : *parameters )
+      {
+        const ArrayDatum values_on_vps = getValue< ArrayDatum >( param.second );
+        const DoubleVectorDatum values = getValue< DoubleVectorDatum >( values_on_vps[ tid ] );
+        if ( values->size() != n )
+        {
+          throw BadProperty( "All arrays of a virtual process in a connection plan must have the same length." );
+        }
+        vp_parameters.push_back( std::make_pair( param.first, values ) );
+      }
+
+      const DictionaryDatum no_params( new Dictionary );
+      const index max_node_id = kernel().node_manager.size();
+
+      // the connection builders record the connections to a target one
+      // after another, so the target is only looked up when it changes
+      long last_tnode_id = 0;
+      Node* target = nullptr;
+
+      for ( size_t i = 0; i < n; ++i )
+      {
+        const long snode_id = ( *vp_sources )[ i ];
+        const long tnode_id = ( *vp_targets )[ i ];
+        const long synapse_model_index = ( *vp_synapse_model )[ i ];
+
+        if ( snode_id <= 0 or static_cast< index >( snode_id ) > max_node_id )
+        {
+          throw UnknownNode( snode_id );
+        }
+        if ( tnode_id <= 0 or static_cast< index >( tnode_id ) > max_node_id )
+        {
+          throw UnknownNode( tnode_id );
+        }
+        if ( synapse_model_index < 0 or static_cast< size_t >( synapse_model_index ) >= syn_ids.size() )
+        {
+          throw BadProperty( "Synapse model index in connection plan out of range." );
+        }
+
+        if ( tnode_id != last_tnode_id )
+        {
+          target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          if ( target->is_proxy() )
+          {
+            throw BadProperty( String::compose(
+              "The connection plan contains a connection to node %1 for virtual process %2, which does not own it.",
+              tnode_id,
+              vp ) );
+          }
+          last_tnode_id = tnode_id;
+        }
+
+        // only the parameters given for this connection are passed on
+        DictionaryDatum params = no_params;
+        bool has_params = false;
+        for ( const auto& param : vp_parameters )
+        {
+          const double value = ( *param.second )[ i ];
+          if ( std::isnan( value ) )
+          {
+            continue;
+          }
+          if ( not has_params )
+          {
+            params = DictionaryDatum( new Dictionary );
+            has_params = true;
+          }
+          if ( param.first == names::receptor_type )
+          {
+            ( *params )[ param.first ] = Token( new IntegerDatum( static_cast< long >( value ) ) );
+          }
+          else
+          {
+            ( *params )[ param.first ] = Token( new DoubleDatum( value ) );
+          }
+        }
+
+        kernel().connection_manager.connect(
+          snode_id, target, tid, syn_ids[ synapse_model_index ], params, ( *vp_delays )[ i ], ( *vp_weights )[ i ] );
+      }
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at
+      // the end of the catch block.
+      exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  }
+
+  for ( thread tid = 0; tid < num_threads; ++tid )
+  {
+    if ( exceptions_raised.at( tid ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised.at( tid ) ) );
+    }
+  }
+}
@@ -0,0 +1,124 @@
+/*
+ *  connection_plan.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CONNECTION_PLAN_H
+#define CONNECTION_PLAN_H
+
+// C++ includes:
+#include <map>
+#include <vector>
+
+// Includes from nestkernel:
+#include "nest_types.h"
+
+// Includes from sli:
+#include "dictdatum.h"
+#include "name.h"
+
+namespace nest
+{
+
+/**
+ * Connections recorded while connecting, to be created again later
+ * without running the connection builders.
+ *
+ * While recording, ConnectionManager::connect() passes every connection
+ * it creates to record(). The connections are stored per thread, i.e.,
+ * per virtual process, as arrays of sources, targets, synapse models,
+ * weights, delays and further synapse parameters. Weights and delays
+ * that were not given are stored as NaN and replaced by the defaults of
+ * the synapse model when the plan is connected.
+ *
+ * get_status() exports the connections of the virtual processes of
+ * this MPI process as a dictionary, which persists across ResetKernel.
+ * connect() creates the connections of such a dictionary on each thread,
+ * provided the number of MPI processes and virtual processes are the
+ * same as when recording.
+ */
+class ConnectionPlan
+{
+public:
+  ConnectionPlan();
+
+  //! Clear the plan and start recording with the current number of threads
+  void start();
+
+  //! Stop recording
+  void stop();
+
+  bool is_recording() const;
+
+  /**
+   * Record a connection created on thread tid.
+   */
+  void record( thread tid,
+    index snode_id,
+    index tnode_id,
+    synindex syn_id,
+    const DictionaryDatum& params,
+    double delay,
+    double weight );
+
+  /**
+   * Export the recorded connections.
+   *
+   * The dictionary contains the number of MPI processes and virtual
+   * processes, the virtual processes of this MPI process, the names of
+   * the synapse models used and, for each virtual process, the arrays of
+   * sources, targets, indices into the synapse models, weights, delays
+   * and other synapse parameters.
+   */
+  void get_status( DictionaryDatum& d ) const;
+
+  /**
+   * Create the connections of a plan exported by get_status().
+   *
+   * @throws BadProperty if the plan was recorded with different numbers
+   * of MPI processes or virtual processes, or if a connection does not
+   * belong to the virtual process it is stored for.
+   */
+  static void connect( const DictionaryDatum& plan );
+
+private:
+  struct ThreadPlan
+  {
+    std::vector< long > sources;
+    std::vector< long > targets;
+    std::vector< long > synapse_models;
+    std::vector< double > weights;
+    std::vector< double > delays;
+    std::map< Name, std::vector< double > > parameters; //!< NaN if not given
+  };
+
+  bool recording_;
+  std::vector< ThreadPlan > thread_plans_;
+};
+
+inline bool
+ConnectionPlan::is_recording() const
+{
+  return recording_;
+}
+
+} // namespace nest
+
+#endif /* CONNECTION_PLAN_H */
@@ -169,6 +169,21 @@ public:
     const double t_trig,
     const std::vector< ConnectorModel* >& cm ) = 0;
 
+  /**
+   * Add all connections that are updated by their postsynaptic neuron to the
+   * index of incoming connections of the neuron.
+   */
+  virtual void register_postdriven_stdp( const thread tid ) = 0;
+
+  /**
+   * Update the weight of the postsynaptic-driven STDP connection at position
+   * lcid with all postsynaptic spikes up to t_lim.
+   */
+  virtual void apply_postdriven_stdp( const thread tid,
+    const index lcid,
+    const double t_lim,
+    const std::vector< ConnectorModel* >& cm ) = 0;
+
   /**
    * Sort connections according to source node IDs.
    */
@@ -268,6 +283,13 @@ public:
     C_.push_back( c );
   }
 
+  //! Make room for count further connections
+  void
+  reserve( const size_t count )
+  {
+    C_.reserve( C_.size() + count );
+  }
+
   void
   get_connection( const index source_node_id,
     const index target_node_id,
@@ -435,6 +457,28 @@ public:
     }
   }
 
+  void
+  register_postdriven_stdp( const thread tid )
+  {
+    for ( index lcid = 0; lcid < C_.size(); ++lcid )
+    {
+      if ( not C_[ lcid ].is_disabled() )
+      {
+        C_[ lcid ].register_postdriven_stdp( tid, syn_id_, lcid );
+      }
+    }
+  }
+
+  void
+  apply_postdriven_stdp( const thread tid,
+    const index lcid,
+    const double t_lim,
+    const std::vector< ConnectorModel* >& cm )
+  {
+    C_[ lcid ].apply_postdriven_stdp(
+      tid, t_lim, static_cast< GenericConnectorModel< ConnectionT >* >( cm[ syn_id_ ] )->get_common_properties() );
+  }
+
   void
   sort_connections( BlockVector< Source >& sources )
   {
@@ -85,6 +85,12 @@ public:
     const double delay = NAN,
     const double weight = NAN ) = 0;
 
+  /**
+   * Make room for count further connections in the connector of this
+   * synapse model, creating the connector if needed.
+   */
+  virtual void reserve_connections( std::vector< ConnectorBase* >& hetconn, const synindex syn_id, const size_t count ) = 0;
+
   virtual ConnectorModel* clone( std::string ) const = 0;
 
   virtual void calibrate( const TimeConverter& tc ) = 0;
@@ -215,6 +221,8 @@ public:
     const double delay,
     const double weight );
 
+  void reserve_connections( std::vector< ConnectorBase* >& hetconn, const synindex syn_id, const size_t count );
+
   ConnectorModel* clone( std::string ) const;
 
   void calibrate( const TimeConverter& tc );
@@ -252,6 +252,22 @@ GenericConnectorModel< ConnectionT >::add_connection( Node& src,
 }
 
 
+template < typename ConnectionT >
+void
+GenericConnectorModel< ConnectionT >::reserve_connections( std::vector< ConnectorBase* >& thread_local_connectors,
+  const synindex syn_id,
+  const size_t count )
+{
+  assert( syn_id != invalid_synindex );
+
+  if ( thread_local_connectors[ syn_id ] == NULL )
+  {
+    thread_local_connectors[ syn_id ] = new Connector< ConnectionT >( syn_id );
+  }
+
+  static_cast< Connector< ConnectionT >* >( thread_local_connectors[ syn_id ] )->reserve( count );
+}
+
 template < typename ConnectionT >
 void
 GenericConnectorModel< ConnectionT >::add_connection_( Node& src,
@@ -23,7 +23,7 @@
 #include "event_delivery_manager.h"
 
 // C++ includes:
-#include <algorithm> // rotate
+#include <algorithm> // find, remove, rotate
 #include <iostream>
 #include <numeric> // accumulate
 
@@ -34,8 +34,10 @@
 #include "connection_manager.h"
 #include "connection_manager_impl.h"
 #include "event_delivery_manager_impl.h"
+#include "exceptions.h"
 #include "kernel_manager.h"
 #include "mpi_manager_impl.h"
+#include "recording_device.h"
 #include "send_buffer_position.h"
 #include "source.h"
 #include "vp_manager.h"
@@ -48,10 +50,13 @@ namespace nest
 {
 EventDeliveryManager::EventDeliveryManager()
   : off_grid_spiking_( false )
+  , sparse_input_buffers_( false )
   , moduli_()
   , slice_moduli_()
   , spike_register_()
   , off_grid_spike_register_()
+  , emitted_spikes_()
+  , spike_recorders_()
   , send_buffer_secondary_events_()
   , recv_buffer_secondary_events_()
   , local_spike_counter_()
@@ -84,9 +89,12 @@ EventDeliveryManager::initialize()
   reset_timers_for_dynamics();
   spike_register_.resize( num_threads );
   off_grid_spike_register_.resize( num_threads );
+  emitted_spikes_.resize( num_threads );
+  spike_recorders_.resize( num_threads );
   gather_completed_checker_.initialize( num_threads, false );
   // Ensures that ResetKernel resets off_grid_spiking_
   off_grid_spiking_ = false;
+  sparse_input_buffers_ = false;
   buffer_size_target_data_has_changed_ = false;
   buffer_size_spike_data_has_changed_ = false;
   decrease_buffer_size_spike_data_ = true;
@@ -109,6 +117,8 @@ EventDeliveryManager::finalize()
   // clear the spike buffers
   std::vector< std::vector< std::vector< std::vector< Target > > > >().swap( spike_register_ );
   std::vector< std::vector< std::vector< std::vector< OffGridTarget > > > >().swap( off_grid_spike_register_ );
+  std::vector< std::vector< EmittedSpike > >().swap( emitted_spikes_ );
+  std::vector< std::vector< RecordingDevice* > >().swap( spike_recorders_ );
 
   send_buffer_secondary_events_.clear();
   recv_buffer_secondary_events_.clear();
@@ -118,16 +128,65 @@ EventDeliveryManager::finalize()
   recv_buffer_off_grid_spike_data_.clear();
 }
 
+void
+EventDeliveryManager::register_spike_recorder( const thread tid, RecordingDevice& recorder )
+{
+  std::vector< RecordingDevice* >& recorders = spike_recorders_[ tid ];
+  if ( std::find( recorders.begin(), recorders.end(), &recorder ) == recorders.end() )
+  {
+    recorders.push_back( &recorder );
+  }
+}
+
+void
+EventDeliveryManager::unregister_spike_recorder( const thread tid, RecordingDevice& recorder )
+{
+  std::vector< RecordingDevice* >& recorders = spike_recorders_[ tid ];
+  recorders.erase( std::remove( recorders.begin(), recorders.end(), &recorder ), recorders.end() );
+
+  if ( recorders.empty() )
+  {
+    emitted_spikes_[ tid ].clear();
+  }
+}
+
+void
+EventDeliveryManager::record_emitted_spikes( const thread tid )
+{
+  if ( emitted_spikes_[ tid ].empty() )
+  {
+    return;
+  }
+
+  for ( auto recorder : spike_recorders_[ tid ] )
+  {
+    recorder->record_emitted_spikes( emitted_spikes_[ tid ] );
+  }
+  emitted_spikes_[ tid ].clear();
+}
+
 void
 EventDeliveryManager::set_status( const DictionaryDatum& dict )
 {
   updateValue< bool >( dict, names::off_grid_spiking, off_grid_spiking_ );
+
+  bool sparse_input_buffers = sparse_input_buffers_;
+  if ( updateValue< bool >( dict, names::sparse_input_buffers, sparse_input_buffers )
+    and sparse_input_buffers != sparse_input_buffers_ )
+  {
+    if ( kernel().simulation_manager.has_been_prepared() or kernel().simulation_manager.has_been_simulated() )
+    {
+      throw KernelException( "sparse_input_buffers can only be changed before the first call to Simulate or Prepare." );
+    }
+    sparse_input_buffers_ = sparse_input_buffers;
+  }
 }
 
 void
 EventDeliveryManager::get_status( DictionaryDatum& dict )
 {
   def< bool >( dict, names::off_grid_spiking, off_grid_spiking_ );
+  def< bool >( dict, names::sparse_input_buffers, sparse_input_buffers_ );
   def< unsigned long >(
     dict, names::local_spike_counter, std::accumulate( local_spike_counter_.begin(), local_spike_counter_.end(), 0 ) );
 
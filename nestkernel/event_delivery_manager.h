@@ -52,6 +52,7 @@ typedef MPIManager::OffGridSpike OffGridSpike;
 
 class TargetData;
 class SendBufferPosition;
+class RecordingDevice;
 
 class EventDeliveryManager : public ManagerInterface
 {
@@ -127,6 +128,27 @@ public:
    */
   void send_off_grid_remote( thread tid, SpikeEvent& e, const long lag = 0 );
 
+  /**
+   * Register a spike recorder that records spikes of nodes on thread
+   * tid without being connected to them.
+   *
+   * While any spike recorder is registered for a thread, all spikes
+   * emitted by the nodes of the thread are collected during each slice
+   * and passed to the spike recorders in bulk by record_emitted_spikes().
+   */
+  void register_spike_recorder( const thread tid, RecordingDevice& recorder );
+
+  /**
+   * Remove a spike recorder registered by register_spike_recorder().
+   */
+  void unregister_spike_recorder( const thread tid, RecordingDevice& recorder );
+
+  /**
+   * Pass the spikes emitted by the nodes of thread tid during the
+   * current slice to the registered spike recorders.
+   */
+  void record_emitted_spikes( const thread tid );
+
   /**
    * Send event e directly to its target node. This should be
    * used only where necessary, e.g. if a node wants to reply
@@ -145,6 +167,12 @@ public:
    */
   void set_off_grid_communication( bool off_grid_spiking );
 
+  /**
+   * Return true if input buffers of type CompactRingBuffer should store
+   * only those time steps that received input.
+   */
+  bool get_sparse_input_buffers() const;
+
   /**
    * Return 0 for even, 1 for odd time slices.
    *
@@ -358,6 +386,9 @@ private:
   bool off_grid_spiking_; //!< indicates whether spikes are not constrained to
                           //!< the grid
 
+  bool sparse_input_buffers_; //!< indicates whether input buffers only store
+                              //!< time steps that received input
+
   /**
    * Table of pre-computed modulos.
    * This table is used to map time steps, given as offset from now,
@@ -404,6 +435,19 @@ private:
    */
   std::vector< std::vector< std::vector< std::vector< OffGridTarget > > > > off_grid_spike_register_;
 
+  /**
+   * Spikes emitted by the nodes of each thread during the current
+   * slice, collected only if spike recorders are registered for the
+   * thread.
+   */
+  std::vector< std::vector< EmittedSpike > > emitted_spikes_;
+
+  /**
+   * Spike recorders that record spikes of the nodes of each thread
+   * from emitted_spikes_.
+   */
+  std::vector< std::vector< RecordingDevice* > > spike_recorders_;
+
   /**
    * Buffer to collect the secondary events
    * after serialization.
@@ -519,6 +563,12 @@ EventDeliveryManager::set_off_grid_communication( bool off_grid_spiking )
   off_grid_spiking_ = off_grid_spiking;
 }
 
+inline bool
+EventDeliveryManager::get_sparse_input_buffers() const
+{
+  return sparse_input_buffers_;
+}
+
 inline size_t
 EventDeliveryManager::read_toggle() const
 {
@@ -85,6 +85,11 @@ EventDeliveryManager::send< SpikeEvent >( Node& source, SpikeEvent& e, const lon
       send_remote( tid, e, lag );
     }
     kernel().connection_manager.send_to_devices( tid, source_node_id, e );
+
+    if ( not spike_recorders_[ tid ].empty() )
+    {
+      emitted_spikes_[ tid ].push_back( EmittedSpike( source_node_id, lag, e.get_offset(), e.get_multiplicity() ) );
+    }
   }
   else
   {
@@ -0,0 +1,58 @@
+/*
+ *  exp_cache.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "exp_cache.h"
+
+// C++ includes:
+#include <limits>
+
+// Includes from nestkernel:
+#include "nest_time.h"
+
+namespace nest
+{
+
+ExpCache::ExpCache()
+  : entries_()
+  , steps_per_arg_( 0.0 )
+{
+}
+
+void
+ExpCache::init( const double tau )
+{
+  steps_per_arg_ = tau / Time::get_resolution().get_ms();
+
+  // NaN never compares equal, so that all slots are initially empty
+  Entry_ empty;
+  empty.arg_ = std::numeric_limits< double >::quiet_NaN();
+  empty.value_ = 0.0;
+  entries_.assign( num_slots_, empty );
+}
+
+void
+ExpCache::release()
+{
+  std::vector< Entry_ >().swap( entries_ );
+}
+
+} // namespace nest
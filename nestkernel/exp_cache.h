@@ -0,0 +1,118 @@
+/*
+ *  exp_cache.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef EXP_CACHE_H
+#define EXP_CACHE_H
+
+// C++ includes:
+#include <cmath>
+#include <vector>
+
+namespace nest
+{
+
+/**
+ * Cache for exponentials exp( dt / tau ) of a single time constant tau.
+ *
+ * STDP rules evaluate exponentials of spike time differences. With spikes
+ * and delays on the simulation grid, these take few distinct values, e.g.,
+ * all synapses onto one neuron that transmit a spike in the same step query
+ * the postsynaptic trace with the same argument.
+ *
+ * The cache is direct-mapped: the slot for an argument x = dt / tau is
+ * given by the time difference dt in simulation steps. A slot stores the
+ * last argument and its exponential, and a lookup is a hit only if the
+ * argument is identical to the stored one. Results are thus always
+ * bit-identical to std::exp( x ), also for arguments that are not on the
+ * grid, which merely cause cache misses.
+ *
+ * A cache that has not been enabled with init() computes all exponentials
+ * directly.
+ */
+class ExpCache
+{
+public:
+  ExpCache();
+
+  /**
+   * Enable the cache for time constant tau (in ms) and forget all entries.
+   */
+  void init( const double tau );
+
+  /**
+   * Disable the cache and free its memory.
+   */
+  void release();
+
+  /**
+   * Return true if exponentials are cached.
+   */
+  bool
+  is_enabled() const
+  {
+    return not entries_.empty();
+  }
+
+  /**
+   * Return std::exp( x ) for x = dt / tau.
+   */
+  double exp( const double x );
+
+private:
+  struct Entry_
+  {
+    double arg_;
+    double value_;
+  };
+
+  //! Number of slots, must be a power of two
+  static const size_t num_slots_ = 64;
+
+  std::vector< Entry_ > entries_;
+
+  //! Factor converting arguments to time steps, tau / resolution
+  double steps_per_arg_;
+};
+
+inline double
+ExpCache::exp( const double x )
+{
+  if ( entries_.empty() )
+  {
+    return std::exp( x );
+  }
+
+  // arguments are usually negative, -x * steps_per_arg_ is then the number of
+  // steps between the two spikes involved
+  const long steps = std::lround( -x * steps_per_arg_ );
+  Entry_& entry = entries_[ static_cast< size_t >( steps ) & ( num_slots_ - 1 ) ];
+  if ( entry.arg_ != x )
+  {
+    entry.arg_ = x;
+    entry.value_ = std::exp( x );
+  }
+  return entry.value_;
+}
+
+} // namespace nest
+
+#endif /* #ifndef EXP_CACHE_H */
@@ -40,14 +40,19 @@
 // Includes from nestkernel:
 #include "kernel_manager.h"
 #include "recording_backend_ascii.h"
+#include "recording_backend_binary.h"
 #include "recording_backend_memory.h"
 #include "recording_backend_screen.h"
+#include "recording_backend_spike_archive.h"
 #ifdef HAVE_RECORDINGBACKEND_ARBOR
 #include "recording_backend_arbor.h"
 #endif
 #ifdef HAVE_SIONLIB
 #include "recording_backend_sionlib.h"
 #endif
+#ifdef HAVE_MPI
+#include "recording_backend_mpiio.h"
+#endif
 
 // Includes from sli:
 #include "dictutils.h"
@@ -260,6 +265,12 @@ IOManager::write( Name backend_name,
   recording_backends_[ backend_name ]->write( device, event, double_values, long_values );
 }
 
+void
+IOManager::write_batch( Name backend_name, const RecordingDevice& device, const RecordBatch& batch )
+{
+  recording_backends_[ backend_name ]->write_batch( device, batch );
+}
+
 void
 IOManager::enroll_recorder( Name backend_name, const RecordingDevice& device, const DictionaryDatum& params )
 {
@@ -307,14 +318,19 @@ void
 IOManager::register_recording_backends_()
 {
   recording_backends_.insert( std::make_pair( "ascii", new RecordingBackendASCII() ) );
+  recording_backends_.insert( std::make_pair( "binary", new RecordingBackendBinary() ) );
   recording_backends_.insert( std::make_pair( "memory", new RecordingBackendMemory() ) );
   recording_backends_.insert( std::make_pair( "screen", new RecordingBackendScreen() ) );
+  recording_backends_.insert( std::make_pair( "spike_archive", new RecordingBackendSpikeArchive() ) );
 #ifdef HAVE_RECORDINGBACKEND_ARBOR
   recording_backends_.insert( std::make_pair( "arbor", new RecordingBackendArbor() ) );
 #endif
 #ifdef HAVE_SIONLIB
   recording_backends_.insert( std::make_pair( "sionlib", new RecordingBackendSIONlib() ) );
 #endif
+#ifdef HAVE_MPI
+  recording_backends_.insert( std::make_pair( "mpiio", new RecordingBackendMPIIO() ) );
+#endif
 }
 
 } // namespace nest
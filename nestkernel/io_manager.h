@@ -101,6 +101,8 @@ public:
 
   void write( Name, const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& );
 
+  void write_batch( Name, const RecordingDevice&, const RecordBatch& );
+
   void enroll_recorder( Name, const RecordingDevice&, const DictionaryDatum& );
 
   void set_recording_value_names( Name backend_name,
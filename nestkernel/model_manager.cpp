@@ -36,6 +36,7 @@
 #include "kernel_manager.h"
 #include "model_manager_impl.h"
 #include "proxynode.h"
+#include "ring_buffer.h"
 #include "vp_manager_impl.h"
 
 
@@ -527,6 +528,15 @@ ModelManager::memory_info() const
     }
   }
 
+  std::cout << sep << std::endl;
+
+  // Compare memory per input buffer for both layouts of CompactRingBuffer
+  std::cout << std::setw( 25 ) << "Input buffers"
+            << ( kernel().event_delivery_manager.get_sparse_input_buffers() ? "sparse" : "dense" ) << std::endl;
+  std::cout << std::setw( 25 ) << "  dense" << CompactRingBuffer::dense_memory() << " per buffer" << std::endl;
+  std::cout << std::setw( 25 ) << "  sparse" << CompactRingBuffer::sparse_memory_per_entry()
+            << " per time step with input" << std::endl;
+
   std::cout << sep << std::endl;
   std::cout.unsetf( std::ios::left );
 }
@@ -30,6 +30,7 @@
 #include "kernel_manager.h"
 #include "mpi_manager_impl.h"
 #include "parameter.h"
+#include "vp_manager_impl.h"
 
 // Includes from sli:
 #include "sliexceptions.h"
@@ -208,6 +209,8 @@ connect_arrays( long* sources,
   // only place, where stopwatch sw_construction_connect is needed in addition to nestmodule.cpp
   kernel().connection_manager.sw_construction_connect.start();
 
+  const thread num_threads = kernel().vp_manager.get_num_threads();
+
   // Mapping pointers to the first parameter value of each parameter to their respective names.
   std::map< Name, double* > param_pointers;
   if ( p_keys.size() != 0 )
@@ -223,8 +226,8 @@ connect_arrays( long* sources,
 
   // Dictionary holding additional synapse parameters, passed to the connect call.
   std::vector< DictionaryDatum > param_dicts;
-  param_dicts.reserve( kernel().vp_manager.get_num_threads() );
-  for ( thread i = 0; i < kernel().vp_manager.get_num_threads(); ++i )
+  param_dicts.reserve( num_threads );
+  for ( thread i = 0; i < num_threads; ++i )
   {
     param_dicts.emplace_back( new Dictionary );
     for ( auto& param_keys : p_keys )
@@ -241,97 +244,161 @@ connect_arrays( long* sources,
   }
 
   index synapse_model_id( kernel().model_manager.get_synapsedict()->lookup( syn_model ) );
+  kernel().model_manager.assert_valid_syn_id( synapse_model_id );
 
-  // Increments pointers to weight and delay, if they are specified.
-  auto increment_wd = [weights, delays]( decltype( weights ) & w, decltype( delays ) & d )
+  // Nodes with proxies exist only on the thread of their virtual process,
+  // nodes without proxies, e.g. devices, may exist on every thread.
+  std::vector< bool > model_has_proxies;
+  for ( index model_id = 0; model_id < kernel().model_manager.get_num_node_models(); ++model_id )
   {
-    if ( weights != nullptr )
-    {
-      ++w;
-    }
-    if ( delays != nullptr )
-    {
-      ++d;
-    }
-  };
+    model_has_proxies.push_back( kernel().model_manager.get_model( model_id )->has_proxies() );
+  }
+
+  // Indices of the edges to be created by each thread, as edges[ chunk ][ tid ].
+  // Each thread partitions one chunk of the edges, so each thread creates its
+  // edges in the order in which they are given.
+  std::vector< std::vector< std::vector< size_t > > > edges(
+    num_threads, std::vector< std::vector< size_t > >( num_threads ) );
 
   // Vector for storing exceptions raised by threads.
-  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( kernel().vp_manager.get_num_threads() );
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
 
 #pragma omp parallel
   {
-    const auto tid = kernel().vp_manager.get_thread_id();
+    const auto chunk = kernel().vp_manager.get_thread_id();
     try
     {
-      auto s = sources;
-      auto t = targets;
-      auto w = weights;
-      auto d = delays;
-      double weight_buffer = numerics::nan;
-      double delay_buffer = numerics::nan;
-      int index_counter = 0;
-
-      for ( ; s != sources + n; ++s, ++t, ++index_counter )
+      const index max_node_id = kernel().node_manager.size();
+      std::vector< std::vector< size_t > >& chunk_edges = edges[ chunk ];
+
+      for ( size_t i = chunk * n / num_threads; i < ( chunk + 1 ) * n / num_threads; ++i )
       {
-        if ( 0 >= *s or static_cast< index >( *s ) > kernel().node_manager.size() )
+        if ( 0 >= sources[ i ] or static_cast< index >( sources[ i ] ) > max_node_id )
+        {
+          throw UnknownNode( sources[ i ] );
+        }
+        if ( 0 >= targets[ i ] or static_cast< index >( targets[ i ] ) > max_node_id )
         {
-          throw UnknownNode( *s );
+          throw UnknownNode( targets[ i ] );
         }
-        if ( 0 >= *t or static_cast< index >( *t ) > kernel().node_manager.size() )
+
+        if ( model_has_proxies[ kernel().modelrange_manager.get_model_id( targets[ i ] ) ] )
         {
-          throw UnknownNode( *t );
+          const thread vp = kernel().vp_manager.node_id_to_vp( targets[ i ] );
+          if ( kernel().vp_manager.is_local_vp( vp ) )
+          {
+            chunk_edges[ kernel().vp_manager.vp_to_thread( vp ) ].push_back( i );
+          }
         }
-        auto target_node = kernel().node_manager.get_node_or_proxy( *t, tid );
-        if ( target_node->is_proxy() )
+        else
         {
-          increment_wd( w, d );
-          continue;
+          for ( auto& thread_edges : chunk_edges )
+          {
+            thread_edges.push_back( i );
+          }
         }
+      }
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at the end of the catch block.
+      exceptions_raised.at( chunk ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  }
+  // check if any exceptions have been raised
+  for ( thread tid = 0; tid < num_threads; ++tid )
+  {
+    if ( exceptions_raised.at( tid ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised.at( tid ) ) );
+    }
+  }
 
-        // If weights or delays are specified, the buffers are replaced with the values.
-        // If not, the buffers will be NaN and replaced by a default value by the connect function.
-        if ( weights != nullptr )
+#pragma omp parallel
+  {
+    const auto tid = kernel().vp_manager.get_thread_id();
+    try
+    {
+      // Typed access to the values of the additional synapse parameters, which
+      // are written into the entries of the dictionary of this thread.
+      std::vector< std::pair< const double*, DoubleDatum* > > param_columns;
+      const double* receptor_types = nullptr;
+      IntegerDatum* receptor_type = nullptr;
+      for ( auto& param_pointer_pair : param_pointers )
+      {
+        Datum* datum = ( *param_dicts[ tid ] )[ param_pointer_pair.first ].datum();
+        if ( param_pointer_pair.first == names::receptor_type )
         {
-          weight_buffer = *w;
+          receptor_types = param_pointer_pair.second;
+          receptor_type = static_cast< IntegerDatum* >( datum );
         }
-        if ( delays != nullptr )
+        else
         {
-          delay_buffer = *d;
+          param_columns.emplace_back( param_pointer_pair.second, static_cast< DoubleDatum* >( datum ) );
         }
+      }
+
+      size_t num_edges = 0;
+      for ( const auto& chunk_edges : edges )
+      {
+        num_edges += chunk_edges[ tid ].size();
+      }
+      kernel().connection_manager.reserve_connections( tid, synapse_model_id, num_edges );
 
-        // Store the key-value pair of each parameter in the Dictionary.
-        for ( auto& param_pointer_pair : param_pointers )
+      // Edges are often sorted by target, so the target is only looked up when it changes.
+      long last_target = 0;
+      Node* target_node = nullptr;
+
+      for ( const auto& chunk_edges : edges )
+      {
+        for ( const size_t i : chunk_edges[ tid ] )
         {
-          // Increment the pointer to the parameter value.
-          auto* param = param_pointer_pair.second + index_counter;
+          if ( targets[ i ] != last_target )
+          {
+            target_node = kernel().node_manager.get_node_or_proxy( targets[ i ], tid );
+            last_target = targets[ i ];
+          }
+          // Only nodes without proxies may not exist on this thread.
+          if ( target_node->is_proxy() )
+          {
+            continue;
+          }
+
+          for ( auto& param_column : param_columns )
+          {
+            ( *param_column.second ) = param_column.first[ i ];
+          }
 
           // Receptor type must be an integer.
-          if ( param_pointer_pair.first == names::receptor_type )
+          if ( receptor_types != nullptr )
           {
-            const auto rtype_as_long = static_cast< long >( *param );
+            const double rtype = receptor_types[ i ];
+            const auto rtype_as_long = static_cast< long >( rtype );
 
-            if ( *param > 1L << 31 or std::abs( *param - rtype_as_long ) > 0 ) // To avoid rounding errors
+            if ( rtype > 1L << 31 or std::abs( rtype - rtype_as_long ) > 0 ) // To avoid rounding errors
             {
               throw BadParameter( "Receptor types must be integers." );
             }
 
-            // Change value of dictionary entry without allocating new datum.
-            auto id = static_cast< IntegerDatum* >( ( ( *param_dicts[ tid ] )[ param_pointer_pair.first ] ).datum() );
-            ( *id ) = rtype_as_long;
-          }
-          else
-          {
-            auto dd = static_cast< DoubleDatum* >( ( ( *param_dicts[ tid ] )[ param_pointer_pair.first ] ).datum() );
-            ( *dd ) = *param;
+            ( *receptor_type ) = rtype_as_long;
           }
-        }
 
-        kernel().connection_manager.connect(
-          *s, target_node, tid, synapse_model_id, param_dicts[ tid ], delay_buffer, weight_buffer );
+          // If weights or delays are not specified, NaN is passed and replaced by a default value by the connect
+          // function.
+          kernel().connection_manager.connect( sources[ i ],
+            target_node,
+            tid,
+            synapse_model_id,
+            param_dicts[ tid ],
+            delays != nullptr ? delays[ i ] : numerics::nan,
+            weights != nullptr ? weights[ i ] : numerics::nan );
+        }
+      }
 
+      // The same entries are read for every edge, so checking once suffices.
+      if ( num_edges > 0 )
+      {
         ALL_ENTRIES_ACCESSED( *param_dicts[ tid ], "connect_arrays", "Unread dictionary entries: " );
-
-        increment_wd( w, d );
       }
     }
     catch ( std::exception& err )
@@ -341,7 +408,7 @@ connect_arrays( long* sources,
     }
   }
   // check if any exceptions have been raised
-  for ( thread tid = 0; tid < kernel().vp_manager.get_num_threads(); ++tid )
+  for ( thread tid = 0; tid < num_threads; ++tid )
   {
     if ( exceptions_raised.at( tid ).get() )
     {
@@ -364,6 +431,42 @@ get_connections( const DictionaryDatum& dict )
   return array;
 }
 
+DictionaryDatum
+get_connection_arrays( const DictionaryDatum& dict )
+{
+  dict->clear_access_flags();
+
+  DictionaryDatum connections = kernel().connection_manager.get_connection_arrays( dict );
+
+  ALL_ENTRIES_ACCESSED( *dict, "GetConnectionArrays", "Unread dictionary entries: " );
+
+  return connections;
+}
+
+DictionaryDatum
+get_connection_values( const DictionaryDatum& connections, const ArrayDatum& keys )
+{
+  return kernel().connection_manager.get_connection_values( connections, keys );
+}
+
+void
+start_connection_plan()
+{
+  kernel().connection_manager.start_connection_plan();
+}
+
+DictionaryDatum
+end_connection_plan()
+{
+  return kernel().connection_manager.end_connection_plan();
+}
+
+void
+connect_plan( const DictionaryDatum& plan )
+{
+  kernel().connection_manager.connect_plan( plan );
+}
+
 void
 simulate( const double& t )
 {
@@ -143,6 +143,42 @@ void connect_arrays( long* sources,
 
 ArrayDatum get_connections( const DictionaryDatum& dict );
 
+/**
+ * @brief Return the connections selected by dict as columns
+ *
+ * See ConnectionManager::get_connection_arrays().
+ */
+DictionaryDatum get_connection_arrays( const DictionaryDatum& dict );
+
+/**
+ * @brief Return numerical synapse parameters of connections given as columns
+ *
+ * See ConnectionManager::get_connection_values().
+ */
+DictionaryDatum get_connection_values( const DictionaryDatum& connections, const ArrayDatum& keys );
+
+/**
+ * @brief Record all connections created from now on into a connection plan
+ */
+void start_connection_plan();
+
+/**
+ * @brief Stop recording and return the connection plan
+ *
+ * The plan holds the connections created on the virtual processes of
+ * this MPI process since start_connection_plan() was called.
+ */
+DictionaryDatum end_connection_plan();
+
+/**
+ * @brief Create the connections of a connection plan
+ *
+ * The connections are created without running any connection builder.
+ * The plan must have been recorded with the same numbers of MPI processes
+ * and virtual processes.
+ */
+void connect_plan( const DictionaryDatum& plan );
+
 void simulate( const double& t );
 
 /**
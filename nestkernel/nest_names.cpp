@@ -75,6 +75,7 @@ const Name azimuth_angle( "azimuth_angle" );
 const Name b( "b" );
 const Name beta( "beta" );
 const Name beta_Ca( "beta_Ca" );
+const Name bin_width( "bin_width" );
 const Name biological_time( "biological_time" );
 const Name box( "box" );
 const Name buffer_size( "buffer_size" );
@@ -89,9 +90,11 @@ const Name c_2( "c_2" );
 const Name c_3( "c_3" );
 const Name capacity( "capacity" );
 const Name center( "center" );
+const Name chunk_size( "chunk_size" );
 const Name circular( "circular" );
 const Name clear( "clear" );
 const Name comparator( "comparator" );
+const Name compile_parameters( "compile_parameters" );
 const Name configbit_0( "configbit_0" );
 const Name configbit_1( "configbit_1" );
 const Name connection_count( "connection_count" );
@@ -101,6 +104,7 @@ const Name continuous( "continuous" );
 const Name count_covariance( "count_covariance" );
 const Name count_histogram( "count_histogram" );
 const Name covariance( "covariance" );
+const Name cv( "cv" );
 
 const Name Delta_T( "Delta_T" );
 const Name Delta_V( "Delta_V" );
@@ -115,6 +119,7 @@ const Name dead_time( "dead_time" );
 const Name dead_time_random( "dead_time_random" );
 const Name dead_time_shape( "dead_time_shape" );
 const Name delay( "delay" );
+const Name delays( "delays" );
 const Name delay_u_bars( "delay_u_bars" );
 const Name deliver_interval( "deliver_interval" );
 const Name delta( "delta" );
@@ -166,9 +171,11 @@ const Name eta( "eta" );
 const Name events( "events" );
 const Name extent( "extent" );
 
+const Name fano_factor( "fano_factor" );
 const Name file_extension( "file_extension" );
 const Name filename( "filename" );
 const Name filenames( "filenames" );
+const Name flush_interval( "flush_interval" );
 const Name frequency( "frequency" );
 const Name frozen( "frozen" );
 
@@ -205,6 +212,7 @@ const Name g_sfa( "g_sfa" );
 const Name g_sp( "g_sp" );
 const Name gamma_shape( "gamma_shape" );
 const Name gaussian( "gaussian" );
+const Name geometric_skipping( "geometric_skipping" );
 const Name global_id( "global_id" );
 const Name grid( "grid" );
 const Name grid3d( "grid3d" );
@@ -244,11 +252,14 @@ const Name instant_unblock_NMDA( "instant_unblock_NMDA" );
 const Name instantiations( "instantiations" );
 const Name interval( "interval" );
 const Name is_refractory( "is_refractory" );
+const Name isi_mean( "isi_mean" );
+const Name isi_variance( "isi_variance" );
 
 const Name Kplus( "Kplus" );
 const Name Kplus_triplet( "Kplus_triplet" );
 const Name keep_source_table( "keep_source_table" );
 const Name kernel( "kernel" );
+const Name keys( "keys" );
 
 const Name label( "label" );
 const Name lambda( "lambda" );
@@ -297,6 +308,7 @@ const Name n_events( "n_events" );
 const Name n_messages( "n_messages" );
 const Name n_proc( "n_proc" );
 const Name n_receptors( "n_receptors" );
+const Name n_spikes( "n_spikes" );
 const Name n_synapses( "n_synapses" );
 const Name network_size( "network_size" );
 const Name neuron( "neuron" );
@@ -330,6 +342,7 @@ const Name phase( "phase" );
 const Name phi_max( "phi_max" );
 const Name polar_angle( "polar_angle" );
 const Name polar_axis( "polar_axis" );
+const Name population_histogram( "population_histogram" );
 const Name port( "port" );
 const Name port_name( "port_name" );
 const Name port_width( "port_width" );
@@ -357,6 +370,7 @@ const Name rate( "rate" );
 const Name rate_slope( "rate_slope" );
 const Name rate_times( "rate_times" );
 const Name rate_values( "rate_values" );
+const Name rates( "rates" );
 const Name readout_cycle_duration( "readout_cycle_duration" );
 const Name receptor_type( "receptor_type" );
 const Name receptor_types( "receptor_types" );
@@ -403,6 +417,8 @@ const Name soma_exc( "soma_exc" );
 const Name soma_inh( "soma_inh" );
 const Name sort_connections_by_source( "sort_connections_by_source" );
 const Name source( "source" );
+const Name sources( "sources" );
+const Name sparse_input_buffers( "sparse_input_buffers" );
 const Name spherical( "spherical" );
 const Name spike_dependent_threshold( "spike_dependent_threshold" );
 const Name spike_multiplicities( "spike_multiplicities" );
@@ -421,6 +437,7 @@ const Name synapse_id( "synapse_id" );
 const Name synapse_label( "synapse_label" );
 const Name synapse_model( "synapse_model" );
 const Name synapse_modelid( "synapse_modelid" );
+const Name synapse_models( "synapse_models" );
 const Name synapse_parameters( "synapse_parameters" );
 const Name synapses_per_driver( "synapses_per_driver" );
 const Name synaptic_elements( "synaptic_elements" );
@@ -429,6 +446,7 @@ const Name synaptic_endpoint( "synaptic_endpoint" );
 
 const Name T_max( "T_max" );
 const Name T_min( "T_min" );
+const Name tree_split( "tree_split" );
 const Name Tstart( "Tstart" );
 const Name Tstop( "Tstop" );
 const Name t_clamp( "t_clamp" );
@@ -538,6 +556,7 @@ const Name u_bar_minus( "u_bar_minus" );
 const Name u_bar_plus( "u_bar_plus" );
 const Name u_ref_squared( "u_ref_squared" );
 const Name upper_right( "upper_right" );
+const Name use_exp_cache( "use_exp_cache" );
 const Name use_wfr( "use_wfr" );
 
 const Name V_T( "V_T" );
@@ -557,6 +576,7 @@ const Name V_th_max( "V_th_max" );
 const Name V_th_rest( "V_th_rest" );
 const Name V_th_v( "V_th_v" );
 const Name val_eta( "val_eta" );
+const Name virtual_processes( "virtual_processes" );
 const Name voltage_clamp( "voltage_clamp" );
 const Name voltage_reset_add( "voltage_reset_add" );
 const Name voltage_reset_fraction( "voltage_reset_fraction" );
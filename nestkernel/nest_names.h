@@ -99,6 +99,7 @@ extern const Name azimuth_angle;
 extern const Name b;
 extern const Name beta;
 extern const Name beta_Ca;
+extern const Name bin_width;
 extern const Name biological_time;
 extern const Name box;
 extern const Name buffer_size;
@@ -113,9 +114,11 @@ extern const Name c_2;
 extern const Name c_3;
 extern const Name capacity;
 extern const Name center;
+extern const Name chunk_size;
 extern const Name circular;
 extern const Name clear;
 extern const Name comparator;
+extern const Name compile_parameters;
 extern const Name configbit_0;
 extern const Name configbit_1;
 extern const Name connection_count;
@@ -125,6 +128,7 @@ extern const Name continuous;
 extern const Name count_covariance;
 extern const Name count_histogram;
 extern const Name covariance;
+extern const Name cv;
 
 extern const Name Delta_T;
 extern const Name Delta_V;
@@ -139,6 +143,7 @@ extern const Name dead_time;
 extern const Name dead_time_random;
 extern const Name dead_time_shape;
 extern const Name delay;
+extern const Name delays;
 extern const Name delay_u_bars;
 extern const Name deliver_interval;
 extern const Name delta;
@@ -190,9 +195,11 @@ extern const Name eta;
 extern const Name events;
 extern const Name extent;
 
+extern const Name fano_factor;
 extern const Name file_extension;
 extern const Name filename;
 extern const Name filenames;
+extern const Name flush_interval;
 extern const Name frequency;
 extern const Name frozen;
 
@@ -229,6 +236,7 @@ extern const Name g_sfa;
 extern const Name g_sp;
 extern const Name gamma_shape;
 extern const Name gaussian;
+extern const Name geometric_skipping;
 extern const Name global_id;
 extern const Name grid3d;
 extern const Name grid;
@@ -268,11 +276,14 @@ extern const Name instant_unblock_NMDA;
 extern const Name instantiations;
 extern const Name interval;
 extern const Name is_refractory;
+extern const Name isi_mean;
+extern const Name isi_variance;
 
 extern const Name Kplus;
 extern const Name Kplus_triplet;
 extern const Name keep_source_table;
 extern const Name kernel;
+extern const Name keys;
 
 extern const Name label;
 extern const Name lambda;
@@ -321,6 +332,7 @@ extern const Name n_events;
 extern const Name n_messages;
 extern const Name n_proc;
 extern const Name n_receptors;
+extern const Name n_spikes;
 extern const Name n_synapses;
 extern const Name network_size;
 extern const Name neuron;
@@ -354,6 +366,7 @@ extern const Name phase;
 extern const Name phi_max;
 extern const Name polar_angle;
 extern const Name polar_axis;
+extern const Name population_histogram;
 extern const Name port;
 extern const Name port_name;
 extern const Name port_width;
@@ -381,6 +394,7 @@ extern const Name rate;
 extern const Name rate_slope;
 extern const Name rate_times;
 extern const Name rate_values;
+extern const Name rates;
 extern const Name readout_cycle_duration;
 extern const Name receptor_type;
 extern const Name receptor_types;
@@ -427,6 +441,8 @@ extern const Name soma_exc;
 extern const Name soma_inh;
 extern const Name sort_connections_by_source;
 extern const Name source;
+extern const Name sources;
+extern const Name sparse_input_buffers;
 extern const Name spherical;
 extern const Name spike_dependent_threshold;
 extern const Name spike_multiplicities;
@@ -445,6 +461,7 @@ extern const Name synapse_id;
 extern const Name synapse_label;
 extern const Name synapse_model;
 extern const Name synapse_modelid;
+extern const Name synapse_models;
 extern const Name synapse_parameters;
 extern const Name synapses_per_driver;
 extern const Name synaptic_elements;
@@ -453,6 +470,7 @@ extern const Name synaptic_endpoint;
 
 extern const Name T_max;
 extern const Name T_min;
+extern const Name tree_split;
 extern const Name Tstart;
 extern const Name Tstop;
 extern const Name t_clamp;
@@ -562,6 +580,7 @@ extern const Name u_bar_minus;
 extern const Name u_bar_plus;
 extern const Name u_ref_squared;
 extern const Name upper_right;
+extern const Name use_exp_cache;
 extern const Name use_wfr;
 
 extern const Name V_T;
@@ -581,6 +600,7 @@ extern const Name V_th_max;
 extern const Name V_th_rest;
 extern const Name V_th_v;
 extern const Name val_eta;
+extern const Name virtual_processes;
 extern const Name voltage_clamp;
 extern const Name voltage_reset_add;
 extern const Name voltage_reset_fraction;
@@ -658,6 +658,72 @@ NestModule::GetConnections_DFunction::execute( SLIInterpreter* i ) const
   i->EStack.pop();
 }
 
+/** @BeginDocumentation
+   Name: GetConnectionArrays - Retrieve connections as arrays
+
+   Synopsis:
+   << /source     nodecollection
+      /target     nodecollection
+      /synapse_model /name
+      /synapse_label label
+      /keys [/name ...]
+      /target_thread tid >> GetConnectionArrays -> dict
+
+   Description:
+   Selects connections like GetConnections, but returns them as a
+   dictionary of integer vectors source, target, target_thread,
+   synapse_id and port, with one entry per connection, instead of an
+   array of connection objects. synapse_models holds the names of all
+   synapse models indexed by synapse_id. For each name in keys, a vector
+   with the values of this synapse parameter is added; connections without
+   the parameter get NaN. If target_thread is given, only the connections
+   stored on this thread are returned.
+
+   SeeAlso: GetConnections, GetConnectionValues
+*/
+void
+NestModule::GetConnectionArrays_DFunction::execute( SLIInterpreter* i ) const
+{
+  i->assert_stack_load( 1 );
+
+  DictionaryDatum dict = getValue< DictionaryDatum >( i->OStack.pick( 0 ) );
+
+  DictionaryDatum connections = get_connection_arrays( dict );
+
+  i->OStack.pop();
+  i->OStack.push( connections );
+  i->EStack.pop();
+}
+
+/** @BeginDocumentation
+   Name: GetConnectionValues - Retrieve synapse parameters of connections given as arrays
+
+   Synopsis:
+   dict [/name ...] GetConnectionValues -> dict
+
+   Description:
+   Returns a dictionary with a vector of values for each of the given
+   synapse parameters. The connections are given by the vectors source,
+   target, target_thread, synapse_id and port of a dictionary as returned
+   by GetConnectionArrays. Connections without the parameter get NaN.
+
+   SeeAlso: GetConnectionArrays, GetStatus
+*/
+void
+NestModule::GetConnectionValues_D_aFunction::execute( SLIInterpreter* i ) const
+{
+  i->assert_stack_load( 2 );
+
+  DictionaryDatum connections = getValue< DictionaryDatum >( i->OStack.pick( 1 ) );
+  ArrayDatum keys = getValue< ArrayDatum >( i->OStack.pick( 0 ) );
+
+  DictionaryDatum values = get_connection_values( connections, keys );
+
+  i->OStack.pop( 2 );
+  i->OStack.push( values );
+  i->EStack.pop();
+}
+
 /** @BeginDocumentation
    Name: Simulate - simulate n milliseconds
 
@@ -949,6 +1015,81 @@ NestModule::Connect_g_g_D_aFunction::execute( SLIInterpreter* i ) const
   kernel().connection_manager.sw_construction_connect.stop();
 }
 
+/** @BeginDocumentation
+   Name: StartConnectionPlan - Record connections into a connection plan
+
+   Synopsis:
+   StartConnectionPlan -> -
+
+   Description:
+   All connections created after StartConnectionPlan are recorded until
+   EndConnectionPlan is called, which returns them as a connection plan.
+   ConnectPlan creates the connections of the plan again, e.g., after
+   ResetKernel, without drawing them anew.
+
+   SeeAlso: EndConnectionPlan, ConnectPlan, Connect
+*/
+void
+NestModule::StartConnectionPlanFunction::execute( SLIInterpreter* i ) const
+{
+  start_connection_plan();
+  i->EStack.pop();
+}
+
+/** @BeginDocumentation
+   Name: EndConnectionPlan - Stop recording and return the connection plan
+
+   Synopsis:
+   EndConnectionPlan -> dict
+
+   Description:
+   Returns the connections recorded since StartConnectionPlan on the
+   virtual processes of this MPI process. The arrays of sources, targets,
+   synapse models, weights, delays and synapse parameters hold one entry
+   per virtual process. Weights, delays and parameters that were not given
+   are NaN.
+
+   SeeAlso: StartConnectionPlan, ConnectPlan
+*/
+void
+NestModule::EndConnectionPlanFunction::execute( SLIInterpreter* i ) const
+{
+  DictionaryDatum plan = end_connection_plan();
+
+  i->OStack.push( plan );
+  i->EStack.pop();
+}
+
+/** @BeginDocumentation
+   Name: ConnectPlan - Create the connections of a connection plan
+
+   Synopsis:
+   dict ConnectPlan -> -
+
+   Description:
+   Creates the connections of a plan returned by EndConnectionPlan. The
+   number of MPI processes and virtual processes must be the same as when
+   the plan was recorded.
+
+   SeeAlso: StartConnectionPlan, EndConnectionPlan
+*/
+void
+NestModule::ConnectPlan_DFunction::execute( SLIInterpreter* i ) const
+{
+  kernel().connection_manager.sw_construction_connect.start();
+
+  i->assert_stack_load( 1 );
+
+  DictionaryDatum plan = getValue< DictionaryDatum >( i->OStack.pick( 0 ) );
+
+  connect_plan( plan );
+
+  i->OStack.pop();
+  i->EStack.pop();
+
+  kernel().connection_manager.sw_construction_connect.stop();
+}
+
 /** @BeginDocumentation
    Name: MemoryInfo - Report current memory usage.
    Description:
@@ -2909,6 +3050,8 @@ NestModule::init( SLIInterpreter* i )
   i->createcommand( "GetKernelStatus", &getkernelstatus_function );
 
   i->createcommand( "GetConnections_D", &getconnections_Dfunction );
+  i->createcommand( "GetConnectionArrays_D", &getconnectionarrays_Dfunction );
+  i->createcommand( "GetConnectionValues_D_a", &getconnectionvalues_D_afunction );
   i->createcommand( "cva_C", &cva_cfunction );
 
   i->createcommand( "Simulate_d", &simulatefunction );
@@ -2953,6 +3096,9 @@ NestModule::init( SLIInterpreter* i )
 
   i->createcommand( "Connect_g_g_D_D", &connect_g_g_D_Dfunction );
   i->createcommand( "Connect_g_g_D_a", &connect_g_g_D_afunction );
+  i->createcommand( "StartConnectionPlan", &startconnectionplanfunction );
+  i->createcommand( "EndConnectionPlan", &endconnectionplanfunction );
+  i->createcommand( "ConnectPlan_D", &connectplan_Dfunction );
 
   i->createcommand( "ResetKernel", &resetkernelfunction );
 
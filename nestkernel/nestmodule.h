@@ -289,6 +289,18 @@ public:
     void execute( SLIInterpreter* ) const;
   } getconnections_Dfunction;
 
+  class GetConnectionArrays_DFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const;
+  } getconnectionarrays_Dfunction;
+
+  class GetConnectionValues_D_aFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const;
+  } getconnectionvalues_D_afunction;
+
   class SimulateFunction : public SLIFunction
   {
   public:
@@ -343,6 +355,24 @@ public:
     void execute( SLIInterpreter* ) const;
   } connect_g_g_D_afunction;
 
+  class StartConnectionPlanFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const;
+  } startconnectionplanfunction;
+
+  class EndConnectionPlanFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const;
+  } endconnectionplanfunction;
+
+  class ConnectPlan_DFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const;
+  } connectplan_Dfunction;
+
   class ResetKernelFunction : public SLIFunction
   {
   public:
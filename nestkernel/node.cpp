@@ -433,7 +433,7 @@ Node::get_K_values( double, double&, double&, double& )
 }
 
 void
-nest::Node::get_history( double, double, std::deque< histentry >::iterator*, std::deque< histentry >::iterator* )
+nest::Node::get_history( double, double, SpikeHistory::iterator*, SpikeHistory::iterator* )
 {
   throw UnexpectedEvent();
 }
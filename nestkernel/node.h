@@ -38,6 +38,7 @@
 #include "nest_time.h"
 #include "nest_types.h"
 #include "node_collection.h"
+#include "spike_history.h"
 
 #include "deprecation_warning.h"
 
@@ -688,10 +689,7 @@ public:
   * return the spike history for (t1,t2].
   * @throws UnexpectedEvent
   */
-  virtual void get_history( double t1,
-    double t2,
-    std::deque< histentry >::iterator* start,
-    std::deque< histentry >::iterator* finish );
+  virtual void get_history( double t1, double t2, SpikeHistory::iterator* start, SpikeHistory::iterator* finish );
 
   // for Clopath synapse
   virtual void get_LTP_history( double t1,
@@ -473,6 +473,78 @@ NodeCollectionPrimitive::overlapping( const NodeCollectionPrimitive& rhs ) const
   return ( ( rhs.first_ <= last_ and rhs.first_ >= first_ ) or ( rhs.last_ <= last_ and rhs.last_ >= first_ ) );
 }
 
+std::vector< std::pair< size_t, index > >
+NodeCollectionPrimitive::thread_local_nodes( thread tid ) const
+{
+  std::vector< std::pair< size_t, index > > nodes;
+  append_thread_local_nodes( tid, 0, size(), 0, nodes );
+  return nodes;
+}
+
+std::vector< size_t >
+NodeCollectionPrimitive::num_nodes_on_vps() const
+{
+  std::vector< size_t > counts( kernel().vp_manager.get_num_virtual_processes(), 0 );
+  add_num_nodes_on_vps( 0, size(), counts );
+  return counts;
+}
+
+void
+NodeCollectionPrimitive::add_num_nodes_on_vps( size_t begin, size_t end, std::vector< size_t >& counts ) const
+{
+  if ( begin >= end )
+  {
+    return;
+  }
+
+  // consecutive node IDs are assigned to consecutive virtual processes
+  const size_t num_vps = counts.size();
+  const size_t vp_begin = kernel().vp_manager.node_id_to_vp( first_ + begin );
+  const size_t num_rounds = ( end - begin ) / num_vps;
+  const size_t num_remaining = ( end - begin ) % num_vps;
+  for ( size_t i = 0; i < num_vps; ++i )
+  {
+    counts[ ( vp_begin + i ) % num_vps ] += num_rounds + ( i < num_remaining ? 1 : 0 );
+  }
+}
+
+void
+NodeCollectionPrimitive::append_thread_local_nodes( thread tid,
+  size_t begin,
+  size_t end,
+  size_t position,
+  std::vector< std::pair< size_t, index > >& nodes ) const
+{
+  if ( begin >= end )
+  {
+    return;
+  }
+
+  Model* model = kernel().model_manager.get_model( model_id_ );
+  if ( not model->has_proxies() )
+  {
+    // devices are replicated on all threads, music nodes only exist on thread 0
+    if ( model->one_node_per_process() and tid != 0 )
+    {
+      return;
+    }
+    for ( size_t i = begin; i < end; ++i )
+    {
+      nodes.push_back( std::make_pair( position + i - begin, first_ + i ) );
+    }
+    return;
+  }
+
+  // every num_vps-th node ID lives on the virtual process of the thread
+  const size_t num_vps = kernel().vp_manager.get_num_virtual_processes();
+  const size_t vp = kernel().vp_manager.thread_to_vp( tid );
+  const size_t vp_begin = kernel().vp_manager.node_id_to_vp( first_ + begin );
+  for ( size_t i = begin + ( vp - vp_begin + num_vps ) % num_vps; i < end; i += num_vps )
+  {
+    nodes.push_back( std::make_pair( position + i - begin, first_ + i ) );
+  }
+}
+
 NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionPrimitive& primitive,
   size_t start,
   size_t stop,
@@ -719,6 +791,77 @@ NodeCollectionComposite::local_begin( NodeCollectionPTR cp ) const
   return const_iterator( cp, *this, current_part, current_offset, num_vps * step_ );
 }
 
+std::vector< std::pair< size_t, index > >
+NodeCollectionComposite::thread_local_nodes( thread tid ) const
+{
+  std::vector< std::pair< size_t, index > > nodes;
+
+  if ( step_ > 1 )
+  {
+    // check every element, as the step may cross the boundaries of parts
+    size_t position = 0;
+    for ( const_iterator it = begin(); it < end(); ++it, ++position )
+    {
+      const NodeIDTriple node_id_triple = *it;
+      Model* model = kernel().model_manager.get_model( node_id_triple.model_id );
+      bool is_thread_local = tid == 0 or not model->one_node_per_process();
+      if ( model->has_proxies() )
+      {
+        is_thread_local =
+          kernel().vp_manager.node_id_to_vp( node_id_triple.node_id ) == kernel().vp_manager.thread_to_vp( tid );
+      }
+      if ( is_thread_local )
+      {
+        nodes.push_back( std::make_pair( position, node_id_triple.node_id ) );
+      }
+    }
+    return nodes;
+  }
+
+  const bool is_sliced = stop_part_ != 0 or stop_offset_ != 0;
+  size_t position = 0;
+  for ( size_t part = start_part_; part < parts_.size() and ( not is_sliced or part <= stop_part_ ); ++part )
+  {
+    const size_t part_begin = part == start_part_ ? start_offset_ : 0;
+    const size_t part_end = is_sliced and part == stop_part_ ? stop_offset_ : parts_[ part ].size();
+    if ( part_begin >= part_end )
+    {
+      continue;
+    }
+
+    parts_[ part ].append_thread_local_nodes( tid, part_begin, part_end, position, nodes );
+    position += part_end - part_begin;
+  }
+
+  return nodes;
+}
+
+std::vector< size_t >
+NodeCollectionComposite::num_nodes_on_vps() const
+{
+  std::vector< size_t > counts( kernel().vp_manager.get_num_virtual_processes(), 0 );
+
+  if ( step_ > 1 )
+  {
+    // count every element, as the step may cross the boundaries of parts
+    for ( const_iterator it = begin(); it < end(); ++it )
+    {
+      ++counts[ kernel().vp_manager.node_id_to_vp( ( *it ).node_id ) ];
+    }
+    return counts;
+  }
+
+  const bool is_sliced = stop_part_ != 0 or stop_offset_ != 0;
+  for ( size_t part = start_part_; part < parts_.size() and ( not is_sliced or part <= stop_part_ ); ++part )
+  {
+    const size_t part_begin = part == start_part_ ? start_offset_ : 0;
+    const size_t part_end = is_sliced and part == stop_part_ ? stop_offset_ : parts_[ part ].size();
+    parts_[ part ].add_num_nodes_on_vps( part_begin, part_end, counts );
+  }
+
+  return counts;
+}
+
 NodeCollectionComposite::const_iterator
 NodeCollectionComposite::MPI_local_begin( NodeCollectionPTR cp ) const
 {
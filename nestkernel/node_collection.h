@@ -363,6 +363,33 @@ public:
    */
   virtual long find( const index ) const = 0;
 
+  /**
+   * Returns the nodes that have an instance on the given thread of this
+   * MPI process.
+   *
+   * The nodes are determined from their node IDs using the distribution of
+   * nodes over virtual processes, without looking up any node. Nodes
+   * without proxies are included on every thread they are replicated on.
+   * Connection builders use this to visit only the targets on their own
+   * thread.
+   *
+   * @param tid Thread of this MPI process
+   * @return Pairs of position in the NodeCollection and node ID, in
+   * ascending order
+   */
+  virtual std::vector< std::pair< size_t, index > > thread_local_nodes( thread tid ) const = 0;
+
+  /**
+   * Returns the number of nodes assigned to each virtual process.
+   *
+   * Every node is counted on the virtual process given by its node ID,
+   * also nodes without proxies. For NodeCollections without a step, the
+   * numbers are computed from the ranges of node IDs.
+   *
+   * @return Vector with one entry per virtual process
+   */
+  virtual std::vector< size_t > num_nodes_on_vps() const = 0;
+
 private:
   unsigned long fingerprint_; //!< Unique identity of the kernel that created the NodeCollection
   static NodeCollectionPTR create_();
@@ -462,6 +489,35 @@ public:
 
   long find( const index ) const override;
 
+  std::vector< std::pair< size_t, index > > thread_local_nodes( thread tid ) const override;
+
+  std::vector< size_t > num_nodes_on_vps() const override;
+
+  /**
+   * Adds the number of nodes on each virtual process among the elements
+   * begin to end - 1 to counts.
+   *
+   * @param begin First element to consider
+   * @param end Element after the last one to consider
+   * @param counts Vector with one entry per virtual process
+   */
+  void add_num_nodes_on_vps( size_t begin, size_t end, std::vector< size_t >& counts ) const;
+
+  /**
+   * Appends the thread local nodes among the elements begin to end - 1.
+   *
+   * @param tid Thread of this MPI process
+   * @param begin First element to consider
+   * @param end Element after the last one to consider
+   * @param position Position of element begin in the enclosing NodeCollection
+   * @param nodes Vector to append the positions and node IDs to
+   */
+  void append_thread_local_nodes( thread tid,
+    size_t begin,
+    size_t end,
+    size_t position,
+    std::vector< std::pair< size_t, index > >& nodes ) const;
+
   /**
    * Checks if node IDs in another primitive is a continuation of node IDs in this
    * primitive.
@@ -588,6 +644,10 @@ public:
   bool empty() const override;
 
   long find( const index ) const override;
+
+  std::vector< std::pair< size_t, index > > thread_local_nodes( thread tid ) const override;
+
+  std::vector< size_t > num_nodes_on_vps() const override;
 };
 
 inline bool NodeCollection::operator!=( NodeCollectionPTR rhs ) const
@@ -39,6 +39,42 @@ Parameter::node_id_to_node_ptr_( const index node_id, const thread t ) const
   return kernel().node_manager.get_node_or_proxy( node_id, t );
 }
 
+void
+Parameter::value_batch( RngPtr rng,
+  const index* snode_ids,
+  size_t n,
+  Node* target,
+  thread target_thread,
+  double* values )
+{
+  for ( size_t i = 0; i < n; ++i )
+  {
+    values[ i ] = value( rng, snode_ids[ i ], target, target_thread );
+  }
+}
+
+bool
+Parameter::value_batch_pair_( Parameter* p1,
+  Parameter* p2,
+  RngPtr rng,
+  const index* snode_ids,
+  size_t n,
+  Node* target,
+  thread target_thread,
+  double* values,
+  std::vector< double >& values2 )
+{
+  if ( p1->uses_rng() and p2->uses_rng() )
+  {
+    return false;
+  }
+
+  values2.resize( n );
+  p1->value_batch( rng, snode_ids, n, target, target_thread, values );
+  p2->value_batch( rng, snode_ids, n, target, target_thread, values2.data() );
+  return true;
+}
+
 std::vector< double >
 Parameter::apply( const NodeCollectionPTR& nc, const TokenArray& token_array )
 {
@@ -100,6 +136,7 @@ NormalParameter::NormalParameter( const DictionaryDatum& d )
   dist.param( param );
   assert( normal_dists_.size() == 0 );
   normal_dists_.resize( kernel().vp_manager.get_num_threads(), dist );
+  parameter_uses_rng_ = true;
 }
 
 double
@@ -108,6 +145,16 @@ NormalParameter::value( RngPtr rng, Node* )
   return normal_dists_[ kernel().vp_manager.get_thread_id() ]( rng );
 }
 
+void
+NormalParameter::value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values )
+{
+  normal_distribution& dist = normal_dists_[ kernel().vp_manager.get_thread_id() ];
+  for ( size_t i = 0; i < n; ++i )
+  {
+    values[ i ] = dist( rng );
+  }
+}
+
 
 LognormalParameter::LognormalParameter( const DictionaryDatum& d )
   : Parameter( d )
@@ -125,6 +172,7 @@ LognormalParameter::LognormalParameter( const DictionaryDatum& d )
   dist.param( param );
   assert( lognormal_dists_.size() == 0 );
   lognormal_dists_.resize( kernel().vp_manager.get_num_threads(), dist );
+  parameter_uses_rng_ = true;
 }
 
 double
@@ -133,6 +181,16 @@ LognormalParameter::value( RngPtr rng, Node* )
   return lognormal_dists_[ kernel().vp_manager.get_thread_id() ]( rng );
 }
 
+void
+LognormalParameter::value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values )
+{
+  lognormal_distribution& dist = lognormal_dists_[ kernel().vp_manager.get_thread_id() ];
+  for ( size_t i = 0; i < n; ++i )
+  {
+    values[ i ] = dist( rng );
+  }
+}
+
 
 double
 NodePosParameter::get_node_pos_( RngPtr, Node* node ) const
@@ -211,6 +269,7 @@ RedrawParameter::RedrawParameter( const Parameter& p, const double min, const do
   , max_redraws_( 1000 )
 {
   parameter_is_spatial_ = p_->is_spatial();
+  parameter_uses_rng_ = p_->uses_rng();
   if ( min > max )
   {
     throw BadParameterValue( "min <= max required." );
@@ -273,4 +332,334 @@ RedrawParameter::value( RngPtr rng,
   return value;
 }
 
+size_t
+Parameter::compile( CompiledParameter& program )
+{
+  return program.add_call( this );
+}
+
+size_t
+ConstantParameter::compile( CompiledParameter& program )
+{
+  return program.add_constant( value_ );
+}
+
+size_t
+NodePosParameter::compile( CompiledParameter& program )
+{
+  if ( synaptic_endpoint_ == 0 )
+  {
+    // the value() function throws the appropriate exception
+    return Parameter::compile( program );
+  }
+  return program.add_position( synaptic_endpoint_ == 1, dimension_ );
+}
+
+size_t
+SpatialDistanceParameter::compile( CompiledParameter& program )
+{
+  if ( dimension_ != 0 )
+  {
+    return Parameter::compile( program );
+  }
+  return program.add_distance();
+}
+
+size_t
+ProductParameter::compile( CompiledParameter& program )
+{
+  const size_t a = parameter1_->compile( program );
+  const size_t b = parameter2_->compile( program );
+  return program.add_instruction( CompiledParameter::MULTIPLY, a, b );
+}
+
+size_t
+QuotientParameter::compile( CompiledParameter& program )
+{
+  const size_t a = parameter1_->compile( program );
+  const size_t b = parameter2_->compile( program );
+  return program.add_instruction( CompiledParameter::DIVIDE, a, b );
+}
+
+size_t
+SumParameter::compile( CompiledParameter& program )
+{
+  const size_t a = parameter1_->compile( program );
+  const size_t b = parameter2_->compile( program );
+  return program.add_instruction( CompiledParameter::ADD, a, b );
+}
+
+size_t
+DifferenceParameter::compile( CompiledParameter& program )
+{
+  const size_t a = parameter1_->compile( program );
+  const size_t b = parameter2_->compile( program );
+  return program.add_instruction( CompiledParameter::SUBTRACT, a, b );
+}
+
+size_t
+ConverseParameter::compile( CompiledParameter& program )
+{
+  return p_->compile( program );
+}
+
+size_t
+ComparingParameter::compile( CompiledParameter& program )
+{
+  const size_t a = parameter1_->compile( program );
+  const size_t b = parameter2_->compile( program );
+  return program.add_comparison( comparator_, a, b );
+}
+
+size_t
+ConditionalParameter::compile( CompiledParameter& program )
+{
+  const size_t condition = condition_->compile( program );
+  const size_t result = program.add_register();
+
+  const size_t jump_to_if_false = program.add_jump( CompiledParameter::JUMP_IF_ZERO, condition );
+  program.add_copy( result, if_true_->compile( program ) );
+  const size_t jump_to_end = program.add_jump( CompiledParameter::JUMP );
+
+  program.set_jump_target( jump_to_if_false );
+  program.add_copy( result, if_false_->compile( program ) );
+
+  program.set_jump_target( jump_to_end );
+  return result;
+}
+
+size_t
+MinParameter::compile( CompiledParameter& program )
+{
+  return program.add_instruction( CompiledParameter::MIN, p_->compile( program ), 0, other_value_ );
+}
+
+size_t
+MaxParameter::compile( CompiledParameter& program )
+{
+  return program.add_instruction( CompiledParameter::MAX, p_->compile( program ), 0, other_value_ );
+}
+
+size_t
+ExpParameter::compile( CompiledParameter& program )
+{
+  return program.add_instruction( CompiledParameter::EXP, p_->compile( program ) );
+}
+
+size_t
+SinParameter::compile( CompiledParameter& program )
+{
+  return program.add_instruction( CompiledParameter::SIN, p_->compile( program ) );
+}
+
+size_t
+CosParameter::compile( CompiledParameter& program )
+{
+  return program.add_instruction( CompiledParameter::COS, p_->compile( program ) );
+}
+
+size_t
+PowParameter::compile( CompiledParameter& program )
+{
+  return program.add_instruction( CompiledParameter::POW, p_->compile( program ), 0, exponent_ );
+}
+
+CompiledParameter::CompiledParameter( const std::shared_ptr< Parameter >& p )
+  : Parameter( *p )
+  , parameter_( p )
+{
+  compile_();
+}
+
+CompiledParameter::CompiledParameter( const CompiledParameter& p )
+  : Parameter( p )
+  , parameter_( p.parameter_->clone() )
+{
+  compile_();
+}
+
+void
+CompiledParameter::compile_()
+{
+  instructions_.clear();
+  constants_.clear();
+  num_registers_ = 0;
+  distance_ = -1;
+
+  result_ = parameter_->compile( *this );
+
+  std::vector< double > registers( num_registers_, 0.0 );
+  for ( const auto& constant : constants_ )
+  {
+    registers[ constant.first ] = constant.second;
+  }
+  registers_.assign( kernel().vp_manager.get_num_threads(), registers );
+}
+
+size_t
+CompiledParameter::compile( CompiledParameter& program )
+{
+  return parameter_->compile( program );
+}
+
+double
+CompiledParameter::value( RngPtr rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer )
+{
+  double* const registers = registers_[ kernel().vp_manager.get_thread_id() ].data();
+
+  if ( distance_ >= 0 )
+  {
+    registers[ distance_ ] = layer.compute_distance( source_pos, target_pos );
+  }
+
+  size_t next = 0;
+  while ( next < instructions_.size() )
+  {
+    const Instruction& instruction = instructions_[ next++ ];
+    double& result = registers[ instruction.result ];
+    const double a = registers[ instruction.a ];
+    const double b = registers[ instruction.b ];
+
+    switch ( instruction.opcode )
+    {
+    case CALL:
+      result = instruction.parameter->value( rng, source_pos, target_pos, layer );
+      break;
+    case SOURCE_POSITION:
+      result = source_pos[ instruction.argument ];
+      break;
+    case TARGET_POSITION:
+      result = target_pos[ instruction.argument ];
+      break;
+    case ADD:
+      result = a + b;
+      break;
+    case SUBTRACT:
+      result = a - b;
+      break;
+    case MULTIPLY:
+      result = a * b;
+      break;
+    case DIVIDE:
+      result = a / b;
+      break;
+    case COMPARE:
+      result = ComparingParameter::compare( instruction.argument, a, b );
+      break;
+    case MIN:
+      result = std::min( a, instruction.constant );
+      break;
+    case MAX:
+      result = std::max( a, instruction.constant );
+      break;
+    case EXP:
+      result = std::exp( a );
+      break;
+    case SIN:
+      result = std::sin( a );
+      break;
+    case COS:
+      result = std::cos( a );
+      break;
+    case POW:
+      result = std::pow( a, instruction.constant );
+      break;
+    case COPY:
+      result = a;
+      break;
+    case JUMP_IF_ZERO:
+      if ( a == 0 )
+      {
+        next = instruction.argument;
+      }
+      break;
+    case JUMP:
+      next = instruction.argument;
+      break;
+    }
+  }
+
+  return registers[ result_ ];
+}
+
+size_t
+CompiledParameter::add_register()
+{
+  return num_registers_++;
+}
+
+size_t
+CompiledParameter::add_constant( const double value )
+{
+  const size_t result = add_register();
+  constants_.push_back( std::make_pair( result, value ) );
+  return result;
+}
+
+size_t
+CompiledParameter::add_distance()
+{
+  if ( distance_ < 0 )
+  {
+    distance_ = add_register();
+  }
+  return distance_;
+}
+
+size_t
+CompiledParameter::add_instruction( const Opcode opcode, const size_t a, const size_t b, const double constant )
+{
+  const size_t result = add_register();
+  instructions_.push_back( { opcode, result, a, b, 0, constant, nullptr } );
+  return result;
+}
+
+size_t
+CompiledParameter::add_position( const bool source, const long dimension )
+{
+  const size_t result = add_register();
+  instructions_.push_back( { source ? SOURCE_POSITION : TARGET_POSITION, result, 0, 0, dimension, 0.0, nullptr } );
+  return result;
+}
+
+size_t
+CompiledParameter::add_comparison( const int comparator, const size_t a, const size_t b )
+{
+  const size_t result = add_register();
+  instructions_.push_back( { COMPARE, result, a, b, comparator, 0.0, nullptr } );
+  return result;
+}
+
+size_t
+CompiledParameter::add_call( Parameter* p )
+{
+  const size_t result = add_register();
+  instructions_.push_back( { CALL, result, 0, 0, 0, 0.0, p } );
+  return result;
+}
+
+void
+CompiledParameter::add_copy( const size_t result, const size_t a )
+{
+  instructions_.push_back( { COPY, result, a, 0, 0, 0.0, nullptr } );
+}
+
+size_t
+CompiledParameter::add_jump( const Opcode opcode, const size_t a )
+{
+  assert( opcode == JUMP or opcode == JUMP_IF_ZERO );
+  // the result register is not written by jumps
+  instructions_.push_back( { opcode, 0, a, 0, -1, 0.0, nullptr } );
+  return instructions_.size() - 1;
+}
+
+void
+CompiledParameter::set_jump_target( const size_t jump )
+{
+  instructions_[ jump ].argument = instructions_.size();
+}
+
 } /* namespace nest */
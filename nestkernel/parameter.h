@@ -24,6 +24,7 @@
 #define PARAMETER_H_
 
 // C++ includes:
+#include <algorithm>
 #include <limits>
 #include <cmath>
 
@@ -41,6 +42,7 @@ namespace nest
 {
 
 class AbstractLayer;
+class CompiledParameter;
 
 /**
  * Abstract base class for parameters.
@@ -84,6 +86,27 @@ public:
     return value( rng, nullptr );
   }
 
+  /**
+   * Generates values for connections from several sources to one target.
+   * Fills values[ i ] with the value for the source with node ID
+   * snode_ids[ i ], for i < n. Random numbers are drawn in the same order
+   * as when calling value() for each source in turn.
+   */
+  virtual void value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values );
+
+  /**
+   * Add instructions computing the value of the parameter for a pair of
+   * positions to a compiled parameter. By default, the instructions call
+   * the value() function of the parameter.
+   * @returns the register holding the value.
+   */
+  virtual size_t compile( CompiledParameter& program );
+
   /**
    * Create a copy of the parameter.
    * @returns dynamically allocated copy of parameter object
@@ -184,9 +207,33 @@ public:
    */
   bool returns_int_only() const;
 
+  /**
+   * Check if the Parameter draws random numbers.
+   * @returns true if the Parameter draws random numbers, false otherwise.
+   */
+  bool uses_rng() const;
+
 protected:
   bool parameter_is_spatial_{ false };
   bool parameter_returns_int_only_{ false };
+  bool parameter_uses_rng_{ false };
+
+  /**
+   * Evaluates two parameters for a batch of connections, the first into
+   * values and the second into values2, which is resized to n.
+   * @returns false without evaluating if both parameters draw random
+   *          numbers, as evaluating them one after the other would change
+   *          the order of the random numbers.
+   */
+  static bool value_batch_pair_( Parameter* p1,
+    Parameter* p2,
+    RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values,
+    std::vector< double >& values2 );
 
   Node* node_id_to_node_ptr_( const index, const thread ) const;
   bool value_is_integer_( const double value ) const;
@@ -235,6 +282,14 @@ public:
     return value_;
   }
 
+  void
+  value_batch( RngPtr, const index*, size_t n, Node*, thread, double* values ) override
+  {
+    std::fill( values, values + n, value_ );
+  }
+
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -277,6 +332,7 @@ public:
     }
 
     range_ -= lower_;
+    parameter_uses_rng_ = true;
   }
 
   double
@@ -285,6 +341,15 @@ public:
     return lower_ + rng->drand() * range_;
   }
 
+  void
+  value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values ) override
+  {
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = lower_ + rng->drand() * range_;
+    }
+  }
+
   Parameter*
   clone() const override
   {
@@ -320,6 +385,7 @@ public:
       throw BadProperty( "nest::UniformIntParameter: max > 0 required." );
     }
     parameter_returns_int_only_ = true;
+    parameter_uses_rng_ = true;
   }
 
   double
@@ -328,6 +394,15 @@ public:
     return rng->ulrand( max_ );
   }
 
+  void
+  value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values ) override
+  {
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = rng->ulrand( max_ );
+    }
+  }
+
   Parameter*
   clone() const override
   {
@@ -358,6 +433,7 @@ public:
   NormalParameter( const DictionaryDatum& d );
 
   double value( RngPtr rng, Node* ) override;
+  void value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values ) override;
 
   Parameter*
   clone() const override
@@ -390,6 +466,7 @@ public:
   LognormalParameter( const DictionaryDatum& d );
 
   double value( RngPtr rng, Node* ) override;
+  void value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values ) override;
 
   Parameter*
   clone() const override
@@ -423,6 +500,7 @@ public:
     , beta_( 1.0 )
   {
     updateValue< double >( d, names::beta, beta_ );
+    parameter_uses_rng_ = true;
   }
 
   double
@@ -431,6 +509,15 @@ public:
     return beta_ * ( -std::log( 1 - rng->drand() ) );
   }
 
+  void
+  value_batch( RngPtr rng, const index*, size_t n, Node*, thread, double* values ) override
+  {
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = beta_ * ( -std::log( 1 - rng->drand() ) );
+    }
+  }
+
   Parameter*
   clone() const override
   {
@@ -517,6 +604,8 @@ public:
     throw KernelException( "Wrong synaptic_endpoint_." );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -566,6 +655,8 @@ public:
     const std::vector< double >& target_pos,
     const AbstractLayer& layer ) override;
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -593,6 +684,7 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -605,6 +697,7 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -630,6 +723,27 @@ public:
       * parameter2_->value( rng, snode_id, target, target_thread );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    std::vector< double > values2;
+    if ( not value_batch_pair_(
+           parameter1_, parameter2_, rng, snode_ids, n, target, target_thread, values, values2 ) )
+    {
+      Parameter::value_batch( rng, snode_ids, n, target, target_thread, values );
+      return;
+    }
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = values[ i ] * values2[ i ];
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -640,6 +754,8 @@ public:
       * parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -666,6 +782,7 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -678,6 +795,7 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -703,6 +821,27 @@ public:
       / parameter2_->value( rng, snode_id, target, target_thread );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    std::vector< double > values2;
+    if ( not value_batch_pair_(
+           parameter1_, parameter2_, rng, snode_ids, n, target, target_thread, values, values2 ) )
+    {
+      Parameter::value_batch( rng, snode_ids, n, target, target_thread, values );
+      return;
+    }
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = values[ i ] / values2[ i ];
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -713,6 +852,8 @@ public:
       / parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -739,6 +880,7 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -751,6 +893,7 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -776,6 +919,27 @@ public:
       + parameter2_->value( rng, snode_id, target, target_thread );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    std::vector< double > values2;
+    if ( not value_batch_pair_(
+           parameter1_, parameter2_, rng, snode_ids, n, target, target_thread, values, values2 ) )
+    {
+      Parameter::value_batch( rng, snode_ids, n, target, target_thread, values );
+      return;
+    }
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = values[ i ] + values2[ i ];
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -786,6 +950,8 @@ public:
       + parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -812,6 +978,7 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -824,6 +991,7 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = parameter1_->returns_int_only() and parameter2_->returns_int_only();
   }
 
@@ -849,6 +1017,27 @@ public:
       - parameter2_->value( rng, snode_id, target, target_thread );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    std::vector< double > values2;
+    if ( not value_batch_pair_(
+           parameter1_, parameter2_, rng, snode_ids, n, target, target_thread, values, values2 ) )
+    {
+      Parameter::value_batch( rng, snode_ids, n, target, target_thread, values );
+      return;
+    }
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = values[ i ] - values2[ i ];
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -859,6 +1048,8 @@ public:
       - parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -884,6 +1075,7 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only();
   }
 
@@ -895,6 +1087,7 @@ public:
     , p_( p.p_->clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
   }
 
   ~ConverseParameter() override
@@ -917,6 +1110,17 @@ public:
     return p_->value( rng, snode_id, target, target_thread );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -926,6 +1130,8 @@ public:
     return p_->value( rng, source_pos, target_pos, layer );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -971,6 +1177,7 @@ public:
       throw BadParameter( "Comparator specification has to be in the range 0-5." );
     }
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_uses_rng_ = parameter1_->uses_rng() or parameter2_->uses_rng();
     parameter_returns_int_only_ = true;
   }
 
@@ -1007,6 +1214,27 @@ public:
       parameter2_->value( rng, snode_id, target, target_thread ) );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    std::vector< double > values2;
+    if ( not value_batch_pair_(
+           parameter1_, parameter2_, rng, snode_ids, n, target, target_thread, values, values2 ) )
+    {
+      Parameter::value_batch( rng, snode_ids, n, target, target_thread, values );
+      return;
+    }
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = compare_( values[ i ], values2[ i ] );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1017,20 +1245,21 @@ public:
       parameter2_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
     return new ComparingParameter( *this );
   }
 
-protected:
-  Parameter* parameter1_, *parameter2_;
-
-private:
-  bool
-  compare_( double value_a, double value_b ) const
+  /**
+   * @returns the result of comparing two values with the given comparator.
+   */
+  static bool
+  compare( const int comparator, const double value_a, const double value_b )
   {
-    switch ( comparator_ )
+    switch ( comparator )
     {
     case 0:
       return value_a < value_b;
@@ -1048,6 +1277,16 @@ private:
     throw KernelException( "Wrong comparison operator." );
   }
 
+protected:
+  Parameter* parameter1_, *parameter2_;
+
+private:
+  bool
+  compare_( double value_a, double value_b ) const
+  {
+    return compare( comparator_, value_a, value_b );
+  }
+
   int comparator_;
 };
 
@@ -1069,6 +1308,7 @@ public:
     , if_false_( if_false.clone() )
   {
     parameter_is_spatial_ = condition_->is_spatial() or if_true_->is_spatial() or if_false_->is_spatial();
+    parameter_uses_rng_ = condition_->uses_rng() or if_true_->uses_rng() or if_false_->uses_rng();
     parameter_returns_int_only_ = if_true_->returns_int_only() and if_false_->returns_int_only();
   }
 
@@ -1082,6 +1322,7 @@ public:
     , if_false_( p.if_false_->clone() )
   {
     parameter_is_spatial_ = condition_->is_spatial() or if_true_->is_spatial() or if_false_->is_spatial();
+    parameter_uses_rng_ = condition_->uses_rng() or if_true_->uses_rng() or if_false_->uses_rng();
     parameter_returns_int_only_ = if_true_->returns_int_only() and if_false_->returns_int_only();
   }
 
@@ -1121,6 +1362,31 @@ public:
     }
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    if ( if_true_->uses_rng() or if_false_->uses_rng() )
+    {
+      // only one branch is evaluated per connection
+      Parameter::value_batch( rng, snode_ids, n, target, target_thread, values );
+      return;
+    }
+    std::vector< double > values_true( n );
+    std::vector< double > values_false( n );
+    condition_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    if_true_->value_batch( rng, snode_ids, n, target, target_thread, values_true.data() );
+    if_false_->value_batch( rng, snode_ids, n, target, target_thread, values_false.data() );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = values[ i ] ? values_true[ i ] : values_false[ i ];
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1137,6 +1403,8 @@ public:
     }
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1164,6 +1432,7 @@ public:
     , other_value_( other_value )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only() and value_is_integer_( other_value_ );
   }
 
@@ -1176,6 +1445,7 @@ public:
     , other_value_( p.other_value_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only() and value_is_integer_( other_value_ );
   }
 
@@ -1199,6 +1469,21 @@ public:
     return std::min( p_->value( rng, snode_id, target, target_thread ), other_value_ );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = std::min( values[ i ], other_value_ );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1208,6 +1493,8 @@ public:
     return std::min( p_->value( rng, source_pos, target_pos, layer ), other_value_ );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1236,6 +1523,7 @@ public:
     , other_value_( other_value )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only() and value_is_integer_( other_value_ );
   }
 
@@ -1248,6 +1536,7 @@ public:
     , other_value_( p.other_value_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only() and value_is_integer_( other_value_ );
   }
 
@@ -1271,6 +1560,21 @@ public:
     return std::max( p_->value( rng, snode_id, target, target_thread ), other_value_ );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = std::max( values[ i ], other_value_ );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1280,6 +1584,8 @@ public:
     return std::max( p_->value( rng, source_pos, target_pos, layer ), other_value_ );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1315,6 +1621,7 @@ public:
     , max_redraws_( p.max_redraws_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only();
   }
 
@@ -1362,6 +1669,7 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
   }
 
   /**
@@ -1393,6 +1701,21 @@ public:
     return std::exp( p_->value( rng, snode_id, target, target_thread ) );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = std::exp( values[ i ] );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1402,6 +1725,8 @@ public:
     return std::exp( p_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1428,6 +1753,7 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
   }
 
   /**
@@ -1438,6 +1764,7 @@ public:
     , p_( p.p_->clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
   }
 
   ~SinParameter() override
@@ -1460,6 +1787,21 @@ public:
     return std::sin( p_->value( rng, snode_id, target, target_thread ) );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = std::sin( values[ i ] );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1469,6 +1811,8 @@ public:
     return std::sin( p_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1494,6 +1838,7 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
   }
 
   /**
@@ -1504,6 +1849,7 @@ public:
     , p_( p.p_->clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
   }
 
   ~CosParameter() override
@@ -1526,6 +1872,21 @@ public:
     return std::cos( p_->value( rng, snode_id, target, target_thread ) );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = std::cos( values[ i ] );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1535,6 +1896,8 @@ public:
     return std::cos( p_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1562,6 +1925,7 @@ public:
     , exponent_( exponent )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only();
   }
 
@@ -1574,6 +1938,7 @@ public:
     , exponent_( p.exponent_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_uses_rng_ = p_->uses_rng();
     parameter_returns_int_only_ = p_->returns_int_only();
   }
 
@@ -1597,6 +1962,21 @@ public:
     return std::pow( p_->value( rng, snode_id, target, target_thread ), exponent_ );
   }
 
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    p_->value_batch( rng, snode_ids, n, target, target_thread, values );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      values[ i ] = std::pow( values[ i ], exponent_ );
+    }
+  }
+
   double
   value( RngPtr rng,
     const std::vector< double >& source_pos,
@@ -1606,6 +1986,8 @@ public:
     return std::pow( p_->value( rng, source_pos, target_pos, layer ), exponent_ );
   }
 
+  size_t compile( CompiledParameter& program ) override;
+
   Parameter*
   clone() const override
   {
@@ -1723,6 +2105,142 @@ protected:
   Parameter* pz_;
 };
 
+/**
+ * Parameter evaluating a compiled form of another parameter for pairs of
+ * positions.
+ *
+ * The tree of parameters is flattened into a sequence of instructions
+ * operating on a register file, one register per node of the tree. The
+ * value for a pair of positions is then computed in a single loop,
+ * without virtual calls for arithmetic, comparing, conditional and
+ * mathematical parameters and without allocations. Constants are stored
+ * in the register file when compiling, and the distance between the
+ * positions is computed only once per pair. Parameters without a
+ * compiled form, such as random parameters, are called from the
+ * instructions.
+ *
+ * Operands are evaluated from left to right and only the chosen branch
+ * of a conditional parameter is evaluated, so that random numbers are
+ * drawn as when evaluating the tree. The other value() functions are
+ * forwarded to the parameter.
+ */
+class CompiledParameter : public Parameter
+{
+public:
+  enum Opcode
+  {
+    CALL,
+    SOURCE_POSITION,
+    TARGET_POSITION,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    COMPARE,
+    MIN,
+    MAX,
+    EXP,
+    SIN,
+    COS,
+    POW,
+    COPY,
+    JUMP_IF_ZERO,
+    JUMP
+  };
+
+  /**
+   * Compile the given parameter, which is shared and not copied.
+   */
+  CompiledParameter( const std::shared_ptr< Parameter >& p );
+
+  /**
+   * Copy constructor, compiling a copy of the parameter.
+   */
+  CompiledParameter( const CompiledParameter& p );
+
+  double
+  value( RngPtr rng, Node* node ) override
+  {
+    return parameter_->value( rng, node );
+  }
+
+  double
+  value( RngPtr rng, index snode_id, Node* target, thread target_thread ) override
+  {
+    return parameter_->value( rng, snode_id, target, target_thread );
+  }
+
+  /**
+   * @returns the value of the parameter, computed by executing the instructions.
+   */
+  double value( RngPtr rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer ) override;
+
+  void
+  value_batch( RngPtr rng,
+    const index* snode_ids,
+    size_t n,
+    Node* target,
+    thread target_thread,
+    double* values ) override
+  {
+    parameter_->value_batch( rng, snode_ids, n, target, target_thread, values );
+  }
+
+  size_t compile( CompiledParameter& program ) override;
+
+  Parameter*
+  clone() const override
+  {
+    return new CompiledParameter( *this );
+  }
+
+  /**
+   * Functions used by Parameter::compile() to add instructions.
+   * Functions creating a value return the register holding it.
+   */
+  size_t add_register();
+  size_t add_constant( double value );
+  size_t add_distance();
+  size_t add_instruction( Opcode opcode, size_t a = 0, size_t b = 0, double constant = 0.0 );
+  size_t add_position( bool source, long dimension );
+  size_t add_comparison( int comparator, size_t a, size_t b );
+  size_t add_call( Parameter* p );
+  void add_copy( size_t result, size_t a );
+
+  //! Add a jump, to be completed by set_jump_target(), and return its index
+  size_t add_jump( Opcode opcode, size_t a = 0 );
+
+  //! Let the jump with the given index continue after the last instruction added
+  void set_jump_target( size_t jump );
+
+private:
+  struct Instruction
+  {
+    Opcode opcode;
+    size_t result;
+    size_t a;
+    size_t b;
+    long argument; //!< dimension, comparator or index of next instruction
+    double constant;
+    Parameter* parameter;
+  };
+
+  void compile_();
+
+  std::shared_ptr< Parameter > parameter_;
+  std::vector< Instruction > instructions_;
+  std::vector< std::pair< size_t, double > > constants_;
+  size_t result_;
+  size_t num_registers_;
+  long distance_; //!< register holding the distance, -1 if not needed
+
+  //! register files, one per thread
+  std::vector< std::vector< double > > registers_;
+};
+
 
 inline Parameter*
 Parameter::multiply_parameter( const Parameter& other ) const
@@ -1826,6 +2344,12 @@ Parameter::returns_int_only() const
   return parameter_returns_int_only_;
 }
 
+inline bool
+Parameter::uses_rng() const
+{
+  return parameter_uses_rng_;
+}
+
 inline bool
 Parameter::value_is_integer_( const double value ) const
 {
@@ -44,6 +44,7 @@ const std::uint32_t nest::RandomManager::DEFAULT_BASE_SEED_ = 143202461;
 const std::uint32_t nest::RandomManager::RANK_SYNCED_SEEDER_ = 0xc229212d;
 const std::uint32_t nest::RandomManager::THREAD_SYNCED_SEEDER_ = 0x37722d5e;
 const std::uint32_t nest::RandomManager::THREAD_SPECIFIC_SEEDER_ = 0xb84c9bae;
+const std::uint32_t nest::RandomManager::CREATED_SEEDER_ = 0x5e3d6f91;
 
 
 nest::RandomManager::RandomManager()
@@ -124,6 +125,12 @@ nest::RandomManager::reset_rngs_()
   }
 }
 
+nest::RngPtr
+nest::RandomManager::create_rng( const std::uint32_t seed, const std::uint32_t stream ) const
+{
+  return rng_types_.at( current_rng_type_ )->create( { base_seed_, CREATED_SEEDER_, seed, stream } );
+}
+
 void
 nest::RandomManager::get_status( DictionaryDatum& d )
 {
@@ -94,6 +94,17 @@ public:
    */
   RngPtr get_vp_specific_rng( thread tid ) const;
 
+  /**
+   * Create a new random number generator of the current type.
+   *
+   * The generator is seeded from the base seed and the given seed and
+   * stream, so all threads on all ranks creating it with the same seed
+   * and stream receive the same random number sequence. The seed should
+   * be drawn from the rank-synchronized generator. The caller owns the
+   * generator and must delete it.
+   */
+  RngPtr create_rng( std::uint32_t seed, std::uint32_t stream ) const;
+
   /**
    * Confirm that rank- and thread-synchronized RNGs are in sync.
    *
@@ -152,6 +163,9 @@ private:
 
   /** Thread-specific seed-sequence initializer component. */
   static const std::uint32_t THREAD_SPECIFIC_SEEDER_;
+
+  /** Seed-sequence initializer component of generators created on demand. */
+  static const std::uint32_t CREATED_SEEDER_;
 };
 
 inline RngPtr
@@ -22,7 +22,36 @@
 
 #include "recording_backend.h"
 
+// C++ includes:
+#include <algorithm>
+
+// Includes from nestkernel:
+#include "event.h"
+
 const std::vector< Name > nest::RecordingBackend::NO_DOUBLE_VALUE_NAMES;
 const std::vector< Name > nest::RecordingBackend::NO_LONG_VALUE_NAMES;
 const std::vector< double > nest::RecordingBackend::NO_DOUBLE_VALUES;
 const std::vector< long > nest::RecordingBackend::NO_LONG_VALUES;
+
+void
+nest::RecordingBackend::write_batch( const RecordingDevice& device, const RecordBatch& batch )
+{
+  // backends only use the sender, the stamp and the offset of an event
+  SpikeEvent event;
+  std::vector< double > double_values( batch.n_double_values_ );
+  std::vector< long > long_values( batch.n_long_values_ );
+
+  for ( size_t i = 0; i < batch.size_; ++i )
+  {
+    event.set_sender_node_id( batch.senders_[ i ] );
+    event.set_stamp( batch.stamps_[ i ] );
+    event.set_offset( batch.get_offset( i ) );
+
+    const double* doubles = batch.double_values_ + i * batch.n_double_values_;
+    std::copy( doubles, doubles + batch.n_double_values_, double_values.begin() );
+    const long* longs = batch.long_values_ + i * batch.n_long_values_;
+    std::copy( longs, longs + batch.n_long_values_, long_values.begin() );
+
+    write( device, event, double_values, long_values );
+  }
+}
@@ -26,6 +26,10 @@
 // C++ includes:
 #include <vector>
 
+// Includes from nestkernel:
+#include "nest_time.h"
+#include "nest_types.h"
+
 // Includes from sli:
 #include "dictdatum.h"
 #include "name.h"
@@ -36,6 +40,63 @@ namespace nest
 class RecordingDevice;
 class Event;
 
+/**
+ * Records of a number of events, which a recording device writes at once.
+ *
+ * The batch does not own its data, but refers to arrays held by the
+ * device, which have one entry per record. The values of record i are
+ * stored contiguously, starting at double_values_[ i * n_double_values_ ]
+ * and long_values_[ i * n_long_values_ ], respectively.
+ */
+struct RecordBatch
+{
+  RecordBatch( size_t size,
+    const index* senders,
+    const Time* stamps,
+    const double* offsets,
+    size_t n_double_values,
+    const double* double_values,
+    size_t n_long_values,
+    const long* long_values );
+
+  //! Offset of record i, which is 0 if the batch has no offsets
+  double get_offset( size_t i ) const;
+
+  size_t size_;                 //!< number of records
+  const index* senders_;        //!< node IDs of the senders
+  const Time* stamps_;          //!< time stamps of the events
+  const double* offsets_;       //!< offsets of the events, nullptr if all are 0
+  size_t n_double_values_;      //!< number of double values per record
+  const double* double_values_; //!< double values of all records
+  size_t n_long_values_;        //!< number of long values per record
+  const long* long_values_;     //!< long values of all records
+};
+
+inline RecordBatch::RecordBatch( size_t size,
+  const index* senders,
+  const Time* stamps,
+  const double* offsets,
+  size_t n_double_values,
+  const double* double_values,
+  size_t n_long_values,
+  const long* long_values )
+  : size_( size )
+  , senders_( senders )
+  , stamps_( stamps )
+  , offsets_( offsets )
+  , n_double_values_( n_double_values )
+  , double_values_( double_values )
+  , n_long_values_( n_long_values )
+  , long_values_( long_values )
+{
+}
+
+inline double
+RecordBatch::get_offset( size_t i ) const
+{
+  return offsets_ == nullptr ? 0.0 : offsets_[ i ];
+}
+
 /**
  * Abstract base class for all NESTio recording backends
  *
@@ -246,6 +307,22 @@ public:
     const std::vector< double >& double_values,
     const std::vector< long >& long_values ) = 0;
 
+  /**
+   * Write all records of the batch to the backend specific channel.
+   *
+   * The result has to be the same as if write() was called for each
+   * record in turn. This default implementation does exactly that.
+   * Backends should override it if they can handle the records of a
+   * batch more efficiently, e.g., by looking up the data of the device
+   * only once.
+   *
+   * @param device the RecordingDevice, backend-specific channel to write to
+   * @param batch the records to write
+   *
+   * @ingroup NESTio
+   */
+  virtual void write_batch( const RecordingDevice& device, const RecordBatch& batch );
+
   /**
    * Set the status of the recording backend using the key-value pairs
    * contained in the params dictionary.
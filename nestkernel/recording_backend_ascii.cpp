@@ -153,6 +153,21 @@ nest::RecordingBackendASCII::write( const RecordingDevice& device,
   device_data->second.write( event, double_values, long_values );
 }
 
+void
+nest::RecordingBackendASCII::write_batch( const RecordingDevice& device, const RecordBatch& batch )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( batch );
+}
+
 const std::string
 nest::RecordingBackendASCII::compute_vp_node_id_string_( const RecordingDevice& device ) const
 {
@@ -299,24 +314,57 @@ nest::RecordingBackendASCII::DeviceData::write( const Event& event,
   const std::vector< double >& double_values,
   const std::vector< long >& long_values )
 {
-  file_ << event.get_sender_node_id() << "\t";
+  write_record_( event.get_sender_node_id(),
+    event.get_stamp(),
+    event.get_offset(),
+    double_values.data(),
+    double_values.size(),
+    long_values.data(),
+    long_values.size() );
+}
+
+void
+nest::RecordingBackendASCII::DeviceData::write( const RecordBatch& batch )
+{
+  for ( size_t i = 0; i < batch.size_; ++i )
+  {
+    write_record_( batch.senders_[ i ],
+      batch.stamps_[ i ],
+      batch.get_offset( i ),
+      batch.double_values_ + i * batch.n_double_values_,
+      batch.n_double_values_,
+      batch.long_values_ + i * batch.n_long_values_,
+      batch.n_long_values_ );
+  }
+}
+
+void
+nest::RecordingBackendASCII::DeviceData::write_record_( const index sender,
+  const Time& stamp,
+  const double offset,
+  const double* double_values,
+  const size_t n_double_values,
+  const long* long_values,
+  const size_t n_long_values )
+{
+  file_ << sender << "\t";
 
   if ( time_in_steps_ )
   {
-    file_ << event.get_stamp().get_steps() << "\t" << event.get_offset();
+    file_ << stamp.get_steps() << "\t" << offset;
   }
   else
   {
-    file_ << ( event.get_stamp().get_ms() - event.get_offset() );
+    file_ << ( stamp.get_ms() - offset );
   }
 
-  for ( auto& val : double_values )
+  for ( size_t i = 0; i < n_double_values; ++i )
   {
-    file_ << "\t" << val;
+    file_ << "\t" << double_values[ i ];
   }
-  for ( auto& val : long_values )
+  for ( size_t i = 0; i < n_long_values; ++i )
   {
-    file_ << "\t" << val;
+    file_ << "\t" << long_values[ i ];
   }
 
   file_ << "\n";
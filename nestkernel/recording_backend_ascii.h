@@ -184,6 +184,8 @@ public:
 
   void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
 
+  void write_batch( const RecordingDevice&, const RecordBatch& ) override;
+
   void set_status( const DictionaryDatum& ) override;
   void get_status( DictionaryDatum& ) const override;
 
@@ -201,6 +203,7 @@ private:
     void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
     void open_file();
     void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void write( const RecordBatch& );
     void flush_file();
     void close_file();
     void get_status( DictionaryDatum& ) const;
@@ -218,6 +221,9 @@ private:
     std::vector< Name > long_value_names_;   //!< names for values of type long
 
     std::string compute_filename_() const; //!< Compose and return the filename
+
+    //! Write one line with the given time stamp and values
+    void write_record_( index sender, const Time& stamp, double offset, const double*, size_t, const long*, size_t );
   };
 
   typedef std::vector< std::map< size_t, DeviceData > > data_map;
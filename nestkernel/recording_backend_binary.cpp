@@ -0,0 +1,660 @@
+/*
+ *  recording_backend_binary.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// C++ includes:
+#include <cstdint>
+
+// Includes from libnestutil:
+#include "compose.hpp"
+
+// Includes from nestkernel:
+#include "recording_device.h"
+#include "vp_manager_impl.h"
+
+// includes from sli:
+#include "dictutils.h"
+
+#include "recording_backend_binary.h"
+
+const unsigned int nest::RecordingBackendBinary::BINARY_REC_BACKEND_VERSION = 1;
+
+namespace
+{
+
+void
+write_uint32_( std::ofstream& file, const uint32_t value )
+{
+  file.write( reinterpret_cast< const char* >( &value ), sizeof( value ) );
+}
+
+void
+write_string_( std::ofstream& file, const std::string& s )
+{
+  write_uint32_( file, s.size() );
+  file.write( s.data(), s.size() );
+}
+
+} // namespace
+
+nest::RecordingBackendBinary::RecordingBackendBinary()
+  : buffer_size_( 16384 )
+  , stop_writer_requested_( false )
+  , write_error_( false )
+{
+}
+
+nest::RecordingBackendBinary::~RecordingBackendBinary() throw()
+{
+  stop_writer_();
+}
+
+void
+nest::RecordingBackendBinary::initialize()
+{
+  data_map tmp( kernel().vp_manager.get_num_threads() );
+  device_data_.swap( tmp );
+}
+
+void
+nest::RecordingBackendBinary::finalize()
+{
+  stop_writer_();
+}
+
+void
+nest::RecordingBackendBinary::enroll( const RecordingDevice& device, const DictionaryDatum& params )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    std::string vp_node_id_string = compute_vp_node_id_string_( device );
+    std::string modelname = device.get_name();
+    auto p = device_data_[ t ].insert( std::make_pair( node_id, DeviceData( modelname, vp_node_id_string ) ) );
+    device_data = p.first;
+  }
+
+  device_data->second.set_status( params );
+}
+
+void
+nest::RecordingBackendBinary::disenroll( const RecordingDevice& device )
+{
+  const thread t = device.get_thread();
+  const thread node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data_[ t ].erase( device_data );
+  }
+}
+
+void
+nest::RecordingBackendBinary::set_value_names( const RecordingDevice& device,
+  const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  const thread t = device.get_thread();
+  const thread node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  assert( device_data != device_data_[ t ].end() );
+  device_data->second.set_value_names( double_value_names, long_value_names );
+}
+
+void
+nest::RecordingBackendBinary::pre_run_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendBinary::post_run_hook()
+{
+  drain_();
+
+  // the writer thread is idle now, so we can safely access the files
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.flush_file();
+    }
+  }
+
+  if ( write_error_ )
+  {
+    LOG( M_ERROR, "RecordingBackendBinary::post_run_hook()", "I/O error while writing recorded data." );
+    throw IOError();
+  }
+}
+
+void
+nest::RecordingBackendBinary::post_step_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendBinary::cleanup()
+{
+  drain_();
+  stop_writer_();
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.close_file();
+    }
+  }
+}
+
+void
+nest::RecordingBackendBinary::write( const RecordingDevice& device,
+  const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( event, double_values, long_values );
+
+  if ( device_data->second.buffers_[ device_data->second.active_ ].full() )
+  {
+    submit_( device_data->second );
+  }
+}
+
+void
+nest::RecordingBackendBinary::submit_( DeviceData& device_data )
+{
+  assert( writer_.joinable() );
+
+  std::unique_lock< std::mutex > lock( mutex_ );
+
+  Buffer& full_buffer = device_data.buffers_[ device_data.active_ ];
+  full_buffer.in_flight_ = true;
+  queue_.push_back( std::make_pair( &device_data, &full_buffer ) );
+  buffer_queued_.notify_one();
+
+  // continue with the other buffer as soon as the writer is done with it
+  device_data.active_ = 1 - device_data.active_;
+  Buffer& next_buffer = device_data.buffers_[ device_data.active_ ];
+  buffer_written_.wait( lock, [&next_buffer]() { return not next_buffer.in_flight_; } );
+}
+
+void
+nest::RecordingBackendBinary::write_buffers_()
+{
+  std::unique_lock< std::mutex > lock( mutex_ );
+  while ( true )
+  {
+    buffer_queued_.wait( lock, [this]() { return stop_writer_requested_ or not queue_.empty(); } );
+    if ( queue_.empty() )
+    {
+      return;
+    }
+
+    DeviceData* device_data = queue_.front().first;
+    Buffer* buffer = queue_.front().second;
+    queue_.pop_front();
+
+    // write without holding the lock, so that simulation threads can
+    // queue further buffers in the meantime
+    lock.unlock();
+    buffer->write( device_data->file_, device_data->column_is_long_() );
+    const bool good = device_data->file_.good();
+    lock.lock();
+
+    buffer->clear();
+    buffer->in_flight_ = false;
+    write_error_ = write_error_ or not good;
+    buffer_written_.notify_all();
+  }
+}
+
+void
+nest::RecordingBackendBinary::drain_()
+{
+  if ( not writer_.joinable() )
+  {
+    return;
+  }
+
+  std::unique_lock< std::mutex > lock( mutex_ );
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      DeviceData& dd = device_data.second;
+      Buffer& buffer = dd.buffers_[ dd.active_ ];
+      if ( not buffer.empty() )
+      {
+        buffer.in_flight_ = true;
+        queue_.push_back( std::make_pair( &dd, &buffer ) );
+        dd.active_ = 1 - dd.active_;
+      }
+    }
+  }
+  buffer_queued_.notify_one();
+
+  buffer_written_.wait( lock,
+    [this]()
+    {
+      if ( not queue_.empty() )
+      {
+        return false;
+      }
+      for ( const auto& inner : device_data_ )
+      {
+        for ( const auto& device_data : inner )
+        {
+          if ( device_data.second.buffers_[ 0 ].in_flight_ or device_data.second.buffers_[ 1 ].in_flight_ )
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    } );
+}
+
+void
+nest::RecordingBackendBinary::stop_writer_()
+{
+  if ( not writer_.joinable() )
+  {
+    return;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock( mutex_ );
+    stop_writer_requested_ = true;
+  }
+  buffer_queued_.notify_one();
+  writer_.join();
+  stop_writer_requested_ = false;
+}
+
+const std::string
+nest::RecordingBackendBinary::compute_vp_node_id_string_( const RecordingDevice& device ) const
+{
+  const float num_vps = kernel().vp_manager.get_num_virtual_processes();
+  const float num_nodes = kernel().node_manager.size();
+  const int vp_digits = static_cast< int >( std::floor( std::log10( num_vps ) ) + 1 );
+  const int node_id_digits = static_cast< int >( std::floor( std::log10( num_nodes ) ) + 1 );
+
+  std::ostringstream vp_node_id_string;
+  vp_node_id_string << "-" << std::setfill( '0' ) << std::setw( node_id_digits ) << device.get_node_id() << "-"
+                    << std::setfill( '0' ) << std::setw( vp_digits ) << device.get_vp();
+
+  return vp_node_id_string.str();
+}
+
+void
+nest::RecordingBackendBinary::prepare()
+{
+  bool have_devices = false;
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_info : inner )
+    {
+      device_info.second.open_file( buffer_size_ );
+      have_devices = true;
+    }
+  }
+
+  write_error_ = false;
+  if ( have_devices and not writer_.joinable() )
+  {
+    writer_ = std::thread( &RecordingBackendBinary::write_buffers_, this );
+  }
+}
+
+void
+nest::RecordingBackendBinary::set_status( const DictionaryDatum& d )
+{
+  long buffer_size = buffer_size_;
+  if ( updateValue< long >( d, names::buffer_size, buffer_size ) )
+  {
+    if ( writer_.joinable() )
+    {
+      throw BadProperty( "Property buffer_size cannot be set while files are open." );
+    }
+    if ( buffer_size < 1 )
+    {
+      throw BadProperty( "Property buffer_size must be positive." );
+    }
+    buffer_size_ = buffer_size;
+  }
+}
+
+void
+nest::RecordingBackendBinary::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::buffer_size ] = buffer_size_;
+}
+
+void
+nest::RecordingBackendBinary::check_device_status( const DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.set_status( params ); // throws if params contains invalid entries
+}
+
+void
+nest::RecordingBackendBinary::get_device_defaults( DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.get_status( params );
+}
+
+void
+nest::RecordingBackendBinary::get_device_status( const nest::RecordingDevice& device, DictionaryDatum& d ) const
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::const_iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data->second.get_status( d );
+  }
+}
+
+/* ******************* Record buffer class Buffer ******************* */
+
+nest::RecordingBackendBinary::Buffer::Buffer()
+  : in_flight_( false )
+  , capacity_( 0 )
+  , size_( 0 )
+{
+}
+
+void
+nest::RecordingBackendBinary::Buffer::allocate( size_t capacity, size_t n_long_columns, size_t n_double_columns )
+{
+  assert( not in_flight_ );
+  capacity_ = capacity;
+  size_ = 0;
+  long_values_.resize( capacity * n_long_columns );
+  double_values_.resize( capacity * n_double_columns );
+}
+
+void
+nest::RecordingBackendBinary::Buffer::write( std::ofstream& file, const std::vector< bool >& column_is_long ) const
+{
+  const uint64_t n_records = size_;
+  file.write( reinterpret_cast< const char* >( &n_records ), sizeof( n_records ) );
+
+  // NumPy reads the columns as 64 bit values
+  static_assert( sizeof( long ) == 8 and sizeof( double ) == 8, "Binary recording requires 64 bit long and double." );
+
+  size_t long_column = 0;
+  size_t double_column = 0;
+  for ( const bool is_long : column_is_long )
+  {
+    if ( is_long )
+    {
+      file.write( reinterpret_cast< const char* >( &long_values_[ long_column * capacity_ ] ), size_ * sizeof( long ) );
+      ++long_column;
+    }
+    else
+    {
+      file.write(
+        reinterpret_cast< const char* >( &double_values_[ double_column * capacity_ ] ), size_ * sizeof( double ) );
+      ++double_column;
+    }
+  }
+}
+
+/* ******************* Device meta data class DeviceData ******************* */
+
+nest::RecordingBackendBinary::DeviceData::DeviceData( std::string modelname, std::string vp_node_id_string )
+  : active_( 0 )
+  , time_in_steps_( false )
+  , modelname_( modelname )
+  , vp_node_id_string_( vp_node_id_string )
+  , file_extension_( "bin" )
+  , label_( "" )
+{
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::set_value_names( const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  double_value_names_ = double_value_names;
+  long_value_names_ = long_value_names;
+}
+
+size_t
+nest::RecordingBackendBinary::DeviceData::n_long_columns_() const
+{
+  // senders and optionally time steps
+  return 1 + ( time_in_steps_ ? 1 : 0 ) + long_value_names_.size();
+}
+
+size_t
+nest::RecordingBackendBinary::DeviceData::n_double_columns_() const
+{
+  // times in ms or offsets
+  return 1 + double_value_names_.size();
+}
+
+std::vector< bool >
+nest::RecordingBackendBinary::DeviceData::column_is_long_() const
+{
+  std::vector< bool > column_is_long;
+  column_is_long.push_back( true ); // senders
+  if ( time_in_steps_ )
+  {
+    column_is_long.push_back( true );  // times
+    column_is_long.push_back( false ); // offsets
+  }
+  else
+  {
+    column_is_long.push_back( false ); // times
+  }
+  column_is_long.insert( column_is_long.end(), double_value_names_.size(), false );
+  column_is_long.insert( column_is_long.end(), long_value_names_.size(), true );
+  return column_is_long;
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::flush_file()
+{
+  file_.flush();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::open_file( size_t buffer_size )
+{
+  std::string filename = compute_filename_();
+
+  std::ifstream test( filename.c_str() );
+  if ( test.good() && not kernel().io_manager.overwrite_files() )
+  {
+    std::string msg = String::compose(
+      "The file '%1' already exists and overwriting files is disabled. To overwrite files, set "
+      "the kernel property overwrite_files to true. To change the name or location of the file, "
+      "change the kernel properties data_path or data_prefix, or the device property label.",
+      filename );
+    LOG( M_ERROR, "RecordingBackendBinary::prepare()", msg );
+    throw IOError();
+  }
+  test.close();
+
+  file_ = std::ofstream( filename.c_str(), std::ios::binary );
+
+  if ( not file_.good() )
+  {
+    std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+    LOG( M_ERROR, "RecordingBackendBinary::prepare()", msg );
+    throw IOError();
+  }
+
+  write_header();
+
+  active_ = 0;
+  for ( auto& buffer : buffers_ )
+  {
+    buffer.allocate( buffer_size, n_long_columns_(), n_double_columns_() );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::write_header()
+{
+  file_.write( "NESTBIN", 8 ); // includes the terminating null byte
+  write_uint32_( file_, 0x01020304 );
+  write_uint32_( file_, BINARY_REC_BACKEND_VERSION );
+  write_string_( file_, NEST_VERSION_STRING );
+  write_string_( file_, label_.empty() ? modelname_ : label_ );
+
+  std::vector< std::string > column_names;
+  column_names.push_back( names::senders.toString() );
+  column_names.push_back( names::times.toString() );
+  if ( time_in_steps_ )
+  {
+    column_names.push_back( names::offsets.toString() );
+  }
+  for ( auto& val : double_value_names_ )
+  {
+    column_names.push_back( val.toString() );
+  }
+  for ( auto& val : long_value_names_ )
+  {
+    column_names.push_back( val.toString() );
+  }
+
+  const std::vector< bool > column_is_long = column_is_long_();
+  write_uint32_( file_, column_names.size() );
+  for ( size_t i = 0; i < column_names.size(); ++i )
+  {
+    file_.put( column_is_long[ i ] ? 'l' : 'd' );
+    write_string_( file_, column_names[ i ] );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::close_file()
+{
+  file_.close();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::write( const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  assert( double_values.size() == double_value_names_.size() );
+  assert( long_values.size() == long_value_names_.size() );
+
+  Buffer& buffer = buffers_[ active_ ];
+  size_t long_column = 0;
+  size_t double_column = 0;
+
+  buffer.long_value( long_column++ ) = event.get_sender_node_id();
+
+  if ( time_in_steps_ )
+  {
+    buffer.long_value( long_column++ ) = event.get_stamp().get_steps();
+    buffer.double_value( double_column++ ) = event.get_offset();
+  }
+  else
+  {
+    buffer.double_value( double_column++ ) = event.get_stamp().get_ms() - event.get_offset();
+  }
+
+  for ( auto& val : double_values )
+  {
+    buffer.double_value( double_column++ ) = val;
+  }
+  for ( auto& val : long_values )
+  {
+    buffer.long_value( long_column++ ) = val;
+  }
+
+  buffer.commit();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::file_extension ] = file_extension_;
+  ( *d )[ names::time_in_steps ] = time_in_steps_;
+
+  std::string filename = compute_filename_();
+  initialize_property_array( d, names::filenames );
+  append_property( d, names::filenames, filename );
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::set_status( const DictionaryDatum& d )
+{
+  updateValue< std::string >( d, names::file_extension, file_extension_ );
+  updateValue< std::string >( d, names::label, label_ );
+
+  bool time_in_steps = false;
+  if ( updateValue< bool >( d, names::time_in_steps, time_in_steps ) )
+  {
+    if ( kernel().simulation_manager.has_been_simulated() )
+    {
+      throw BadProperty( "Property time_in_steps cannot be set after Simulate has been called." );
+    }
+
+    time_in_steps_ = time_in_steps;
+  }
+}
+
+std::string
+nest::RecordingBackendBinary::DeviceData::compute_filename_() const
+{
+  std::string data_path = kernel().io_manager.get_data_path();
+  if ( not data_path.empty() and not( data_path[ data_path.size() - 1 ] == '/' ) )
+  {
+    data_path += '/';
+  }
+
+  std::string label = label_;
+  if ( label.empty() )
+  {
+    label = modelname_;
+  }
+
+  std::string data_prefix = kernel().io_manager.get_data_prefix();
+
+  return data_path + data_prefix + label + vp_node_id_string_ + "." + file_extension_;
+}
@@ -0,0 +1,322 @@
+/*
+ *  recording_backend_binary.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECORDING_BACKEND_BINARY_H
+#define RECORDING_BACKEND_BINARY_H
+
+// C++ includes:
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "recording_backend.h"
+
+/* BeginUserDocs: recording backend
+
+.. _recording_backend_binary:
+
+Write data to binary files
+##########################
+
+The `binary` recording backend writes collected data persistently to
+binary files. It is meant for simulations that record so much data
+that formatting it as text, as done by the :ref:`recording backend for
+ASCII files <recording_backend_ascii>`, takes a considerable part of
+the run time.
+
+Recorded events are copied into preallocated buffers on the simulation
+threads. Each device has two such buffers on each thread: while one is
+filled, the other one is written to the file by a background writer
+thread, so that file I/O overlaps with the simulation. If the writer
+cannot keep up, the simulation thread waits until the buffer has been
+written.
+
+Like the `ascii` backend, this backend opens one file per recording
+device per thread on each MPI process. Filenames are determined
+according to the following pattern:
+
+::
+
+   data_path/data_prefix(label|model_name)-node_id-vp.file_extension
+
+The life of a file starts with the call to ``Prepare`` and ends with
+the call to ``Cleanup``. The call to ``Run`` waits until all data
+recorded during the run has been written and flushes the files, so
+the data is available for immediate inspection. As for the `ascii`
+backend, existing files are only overwritten if the kernel property
+``overwrite_files`` is set to *true*.
+
+Data format
++++++++++++
+
+The files are self-describing and store the data in columns. All
+values are written in the byte order of the machine that ran the
+simulation. A file starts with a header, which consists of
+
+* the 8 byte magic string ``NESTBIN`` followed by a null byte,
+* a 32 bit unsigned integer with value ``0x01020304``, from which the
+  byte order can be determined,
+* the version of the file format as 32 bit unsigned integer,
+* the NEST version and the label (or model name) of the device, each
+  as a 32 bit unsigned length followed by the characters,
+* the number of columns as 32 bit unsigned integer, and
+* for each column, its type as a single character, ``l`` for 64 bit
+  signed integers and ``d`` for 64 bit floating point numbers,
+  followed by its name as 32 bit unsigned length and characters.
+
+The columns are ``senders``, followed by either ``times`` in ms or,
+if ``time_in_steps`` is *true*, by ``times`` in steps and ``offsets``
+in ms, followed by the recorded floating point and integer values.
+The column names thus match the keys of the ``events`` dictionary of
+the :ref:`memory recording backend <recording_backend_memory>`.
+
+The header is followed by any number of blocks. Each block starts
+with the number of records it contains as 64 bit unsigned integer,
+followed by the values of each column for all records of the block.
+
+The function ``nest.ReadBinaryRecording()`` reads one or more such
+files into a dictionary of NumPy arrays.
+
+Parameter summary
++++++++++++++++++
+
+.. glossary::
+
+ buffer_size
+   The number of records that fit into one buffer (default: *16384*).
+   This is a global property of the backend, which is set via the
+   kernel property ``recording_backends``. It cannot be changed while
+   files are open.
+
+ file_extension
+   A string (default: *"bin"*) that specifies the file name extension,
+   without leading dot.
+
+ filenames
+   A list of the filenames where data is recorded to. This list has one
+   entry per local thread and is a read-only property.
+
+ label
+   A string (default: *""*) that replaces the model name component in
+   the filename if it is set.
+
+ time_in_steps
+   A Boolean (default: *false*) specifying whether to write time in
+   steps, i.e., in integer multiples of the simulation resolution plus
+   a floating point number for the negative offset from the next grid
+   point in ms, or just the simulation time in ms. This property
+   cannot be set after Simulate has been called.
+
+EndUserDocs */
+
+namespace nest
+{
+
+/**
+ * Binary specialization of the RecordingBackend interface.
+ *
+ * RecordingBackendBinary keeps one file and two record buffers for
+ * every recording device instance on every thread. Recording devices
+ * write into the active buffer of their DeviceData. Full buffers are
+ * queued for a background writer thread, which is started in prepare()
+ * and stopped in cleanup(), and the device continues with the other
+ * buffer.
+ *
+ * All members shared with the writer thread are protected by mutex_.
+ * Files are only accessed by the writer thread while it is running,
+ * except when the queue has been drained in post_run_hook().
+ */
+class RecordingBackendBinary : public RecordingBackend
+{
+public:
+  const static unsigned int BINARY_REC_BACKEND_VERSION;
+
+  RecordingBackendBinary();
+
+  ~RecordingBackendBinary() throw();
+
+  void initialize() override;
+
+  void finalize() override;
+
+  void enroll( const RecordingDevice& device, const DictionaryDatum& params ) override;
+
+  void disenroll( const RecordingDevice& device ) override;
+
+  void set_value_names( const RecordingDevice& device,
+    const std::vector< Name >& double_value_names,
+    const std::vector< Name >& long_value_names ) override;
+
+  /**
+   * Open files and start the writer thread
+   */
+  void prepare() override;
+
+  /**
+   * Write remaining data, stop the writer thread and close files
+   */
+  void cleanup() override;
+
+  void pre_run_hook() override;
+
+  /**
+   * Write all data of the run and flush files
+   */
+  void post_run_hook() override;
+
+  void post_step_hook() override;
+
+  void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
+
+  void set_status( const DictionaryDatum& ) override;
+  void get_status( DictionaryDatum& ) const override;
+
+  void check_device_status( const DictionaryDatum& ) const override;
+  void get_device_defaults( DictionaryDatum& ) const override;
+  void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
+
+private:
+  const std::string compute_vp_node_id_string_( const RecordingDevice& device ) const;
+
+  /**
+   * Records of one device in columnar layout.
+   *
+   * The storage for all columns is allocated once, so that appending
+   * records never allocates memory.
+   */
+  class Buffer
+  {
+  public:
+    Buffer();
+
+    void allocate( size_t capacity, size_t n_long_columns, size_t n_double_columns );
+
+    bool
+    empty() const
+    {
+      return size_ == 0;
+    }
+
+    bool
+    full() const
+    {
+      return size_ == capacity_;
+    }
+
+    void
+    clear()
+    {
+      size_ = 0;
+    }
+
+    long&
+    long_value( const size_t column )
+    {
+      return long_values_[ column * capacity_ + size_ ];
+    }
+
+    double&
+    double_value( const size_t column )
+    {
+      return double_values_[ column * capacity_ + size_ ];
+    }
+
+    //! Mark the record filled via long_value() and double_value() as complete
+    void
+    commit()
+    {
+      ++size_;
+    }
+
+    //! Write the records as one block with columns in the given order
+    void write( std::ofstream& file, const std::vector< bool >& column_is_long ) const;
+
+    bool in_flight_; //!< true while queued for or processed by the writer
+
+  private:
+    size_t capacity_;
+    size_t size_;
+    std::vector< long > long_values_;
+    std::vector< double > double_values_;
+  };
+
+  struct DeviceData
+  {
+    DeviceData() = delete;
+    DeviceData( std::string, std::string );
+    void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
+    void open_file( size_t buffer_size );
+    void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void write_header();
+    void flush_file();
+    void close_file();
+    void get_status( DictionaryDatum& ) const;
+    void set_status( const DictionaryDatum& );
+
+    Buffer buffers_[ 2 ];
+    size_t active_;          //!< Index of the buffer that is currently filled
+    std::ofstream file_;     //!< File stream to use for the device
+    bool time_in_steps_;     //!< Should time be recorded in steps (ms if false)
+    std::string modelname_;  //!< File name up to but not including the "."
+    std::string vp_node_id_string_; //!< The vp and node ID component of the filename
+    std::string file_extension_;    //!< File name extension without leading "."
+    std::string label_;             //!< The label of the device.
+    std::vector< Name > double_value_names_; //!< names for values of type double
+    std::vector< Name > long_value_names_;   //!< names for values of type long
+
+    std::string compute_filename_() const; //!< Compose and return the filename
+    size_t n_long_columns_() const;
+    size_t n_double_columns_() const;
+    std::vector< bool > column_is_long_() const; //!< Column types in file order
+  };
+
+  //! Hand the full active buffer of the device to the writer and switch buffers
+  void submit_( DeviceData& device_data );
+
+  //! Main loop of the writer thread
+  void write_buffers_();
+
+  //! Queue all non-empty buffers and wait until the writer is done with them
+  void drain_();
+
+  //! Stop the writer thread if it is running
+  void stop_writer_();
+
+  typedef std::vector< std::map< size_t, DeviceData > > data_map;
+  data_map device_data_;
+
+  size_t buffer_size_; //!< Number of records per buffer
+
+  std::thread writer_;
+  std::mutex mutex_;
+  std::condition_variable buffer_queued_;  //!< Signals new work or stop to the writer
+  std::condition_variable buffer_written_; //!< Signals buffers returned by the writer
+  std::deque< std::pair< DeviceData*, Buffer* > > queue_;
+  bool stop_writer_requested_;
+  bool write_error_; //!< Set by the writer thread if writing failed
+};
+
+} // namespace
+
+#endif // RECORDING_BACKEND_BINARY_H
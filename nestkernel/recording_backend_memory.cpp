@@ -20,6 +20,9 @@
  *
  */
 
+// C++ includes:
+#include <algorithm>
+
 // Includes from nestkernel:
 #include "recording_device.h"
 #include "vp_manager_impl.h"
@@ -27,6 +30,7 @@
 #include "recording_backend_memory.h"
 
 nest::RecordingBackendMemory::RecordingBackendMemory()
+  : chunk_size_( 0 )
 {
 }
 
@@ -55,7 +59,7 @@ nest::RecordingBackendMemory::enroll( const RecordingDevice& device, const Dicti
   device_data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
   if ( device_data == device_data_[ t ].end() )
   {
-    auto p = device_data_[ t ].insert( std::make_pair( node_id, DeviceData() ) );
+    auto p = device_data_[ t ].insert( std::make_pair( node_id, DeviceData( &device ) ) );
     device_data = p.first;
   }
 
@@ -91,7 +95,13 @@ nest::RecordingBackendMemory::set_value_names( const RecordingDevice& device,
 void
 nest::RecordingBackendMemory::pre_run_hook()
 {
-  // nothing to do
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.reserve( chunk_size_ );
+    }
+  }
 }
 
 void
@@ -112,6 +122,15 @@ nest::RecordingBackendMemory::write( const RecordingDevice& device,
   device_data_[ t ][ node_id ].push_back( event, double_values, long_values );
 }
 
+void
+nest::RecordingBackendMemory::write_batch( const RecordingDevice& device, const RecordBatch& batch )
+{
+  thread t = device.get_thread();
+  index node_id = device.get_node_id();
+
+  device_data_[ t ][ node_id ].push_back( batch );
+}
+
 void
 nest::RecordingBackendMemory::check_device_status( const DictionaryDatum& params ) const
 {
@@ -152,15 +171,23 @@ nest::RecordingBackendMemory::post_step_hook()
 }
 
 void
-nest::RecordingBackendMemory::get_status( lockPTRDatum< Dictionary, &SLIInterpreter::Dictionarytype >& ) const
+nest::RecordingBackendMemory::get_status( lockPTRDatum< Dictionary, &SLIInterpreter::Dictionarytype >& d ) const
 {
-  // nothing to do
+  ( *d )[ names::chunk_size ] = chunk_size_;
 }
 
 void
-nest::RecordingBackendMemory::set_status( lockPTRDatum< Dictionary, &SLIInterpreter::Dictionarytype > const& )
+nest::RecordingBackendMemory::set_status( lockPTRDatum< Dictionary, &SLIInterpreter::Dictionarytype > const& d )
 {
-  // nothing to do
+  long chunk_size = chunk_size_;
+  if ( updateValue< long >( d, names::chunk_size, chunk_size ) )
+  {
+    if ( chunk_size < 0 )
+    {
+      throw BadProperty( "chunk_size must be >= 0." );
+    }
+    chunk_size_ = chunk_size;
+  }
 }
 
 void
@@ -169,10 +196,154 @@ nest::RecordingBackendMemory::prepare()
   // nothing to do
 }
 
+/* ******************* Storage of recorded values class Column ******************* */
+
+template < typename T, SLIType* slt >
+nest::RecordingBackendMemory::Column< T, slt >::Column()
+  : chunks_( 1, VectorDatumT( new std::vector< T >() ) )
+{
+}
+
+template < typename T, SLIType* slt >
+inline void
+nest::RecordingBackendMemory::Column< T, slt >::push_back( const T& value, size_t chunk_size )
+{
+  const VectorDatumT& current = chunks_.back();
+  if ( current.references() > 1 or ( chunk_size > 0 and current->size() == current->capacity() ) )
+  {
+    next_chunk_( chunk_size );
+  }
+
+  chunks_.back()->push_back( value );
+}
+
+template < typename T, SLIType* slt >
+void
+nest::RecordingBackendMemory::Column< T, slt >::next_chunk_( size_t chunk_size )
+{
+  VectorDatumT& current = chunks_.back();
+
+  if ( chunk_size == 0 )
+  {
+    // the shared vector is left to the reader and replaced by a copy
+    current = VectorDatumT( new std::vector< T >( *current ) );
+  }
+  else if ( current->empty() and current.references() == 1 )
+  {
+    current->reserve( chunk_size );
+  }
+  else
+  {
+    chunks_.push_back( VectorDatumT( new std::vector< T >() ) );
+    chunks_.back()->reserve( chunk_size );
+  }
+}
+
+template < typename T, SLIType* slt >
+void
+nest::RecordingBackendMemory::Column< T, slt >::reserve( size_t n_values, size_t chunk_size )
+{
+  const VectorDatumT& current = chunks_.back();
+  if ( n_values == 0 or ( current.references() == 1 and current->capacity() - current->size() >= n_values ) )
+  {
+    return;
+  }
+
+  if ( chunk_size > 0 and not current->empty() )
+  {
+    // never move recorded data in chunked mode
+    chunks_.push_back( VectorDatumT( new std::vector< T >() ) );
+    chunks_.back()->reserve( std::max( n_values, chunk_size ) );
+  }
+  else
+  {
+    VectorDatumT resized( new std::vector< T >() );
+    resized->reserve( current->size() + n_values );
+    resized->insert( resized->end(), current->begin(), current->end() );
+    chunks_.back() = resized;
+  }
+}
+
+template < typename T, SLIType* slt >
+void
+nest::RecordingBackendMemory::Column< T, slt >::clear()
+{
+  chunks_.resize( 1 );
+
+  VectorDatumT& current = chunks_.back();
+  if ( current.references() > 1 )
+  {
+    // the shared vector is left to the reader
+    current = VectorDatumT( new std::vector< T >() );
+  }
+  else
+  {
+    current->clear();
+  }
+}
+
+template < typename T, SLIType* slt >
+void
+nest::RecordingBackendMemory::Column< T, slt >::join_chunks_() const
+{
+  size_t n_values = 0;
+  for ( const auto& chunk : chunks_ )
+  {
+    n_values += chunk->size();
+  }
+
+  VectorDatumT joined( new std::vector< T >() );
+  joined->reserve( n_values );
+  for ( const auto& chunk : chunks_ )
+  {
+    joined->insert( joined->end(), chunk->begin(), chunk->end() );
+  }
+
+  chunks_.assign( 1, joined );
+}
+
+template < typename T, SLIType* slt >
+void
+nest::RecordingBackendMemory::Column< T, slt >::add_to( DictionaryDatum& events, Name name ) const
+{
+  if ( chunks_.size() > 1 )
+  {
+    join_chunks_();
+  }
+  const VectorDatumT& values = chunks_.front();
+
+  // The first device to report the values shares them with the
+  // dictionary. The devices on all other threads append their values.
+  if ( not events->known( name ) )
+  {
+    ( *events )[ name ] = values;
+    return;
+  }
+
+  VectorDatumT* existing = dynamic_cast< VectorDatumT* >( events->lookup( name ).datum() );
+  assert( existing != 0 );
+
+  // do not append to the values of another device
+  if ( existing->references() > 1 )
+  {
+    ( *events )[ name ] = VectorDatumT( new std::vector< T >( **existing ) );
+    existing = dynamic_cast< VectorDatumT* >( events->lookup( name ).datum() );
+  }
+
+  ( *existing )->insert( ( *existing )->end(), values->begin(), values->end() );
+}
+
 /* ******************* Device meta data class DeviceInfo ******************* */
 
 nest::RecordingBackendMemory::DeviceData::DeviceData()
-  : time_in_steps_( false )
+  : DeviceData( 0 )
+{
+}
+
+nest::RecordingBackendMemory::DeviceData::DeviceData( const RecordingDevice* device )
+  : device_( device )
+  , chunk_size_( 0 )
+  , time_in_steps_( false )
 {
 }
 
@@ -187,30 +358,114 @@ nest::RecordingBackendMemory::DeviceData::set_value_names( const std::vector< Na
   long_values_.resize( long_value_names.size() );
 }
 
+void
+nest::RecordingBackendMemory::DeviceData::reserve( size_t chunk_size )
+{
+  chunk_size_ = chunk_size;
+
+  if ( device_ == 0 )
+  {
+    return;
+  }
+
+  const Time& clock = kernel().simulation_manager.get_clock();
+  const size_t n_events = device_->get_expected_events( clock, clock + Time::step( kernel().simulation_manager.get_to_do() ) );
+
+  senders_.reserve( n_events, chunk_size );
+
+  if ( time_in_steps_ )
+  {
+    times_steps_.reserve( n_events, chunk_size );
+    times_offset_.reserve( n_events, chunk_size );
+  }
+  else
+  {
+    times_ms_.reserve( n_events, chunk_size );
+  }
+
+  for ( auto& values : double_values_ )
+  {
+    values.reserve( n_events, chunk_size );
+  }
+  for ( auto& values : long_values_ )
+  {
+    values.reserve( n_events, chunk_size );
+  }
+}
+
 void
 nest::RecordingBackendMemory::DeviceData::push_back( const Event& event,
   const std::vector< double >& double_values,
   const std::vector< long >& long_values )
 {
-  senders_.push_back( event.get_sender_node_id() );
+  senders_.push_back( event.get_sender_node_id(), chunk_size_ );
 
   if ( time_in_steps_ )
   {
-    times_steps_.push_back( event.get_stamp().get_steps() );
-    times_offset_.push_back( event.get_offset() );
+    times_steps_.push_back( event.get_stamp().get_steps(), chunk_size_ );
+    times_offset_.push_back( event.get_offset(), chunk_size_ );
   }
   else
   {
-    times_ms_.push_back( event.get_stamp().get_ms() - event.get_offset() );
+    times_ms_.push_back( event.get_stamp().get_ms() - event.get_offset(), chunk_size_ );
   }
 
   for ( size_t i = 0; i < double_values.size(); ++i )
   {
-    double_values_[ i ].push_back( double_values[ i ] );
+    double_values_[ i ].push_back( double_values[ i ], chunk_size_ );
   }
   for ( size_t i = 0; i < long_values.size(); ++i )
   {
-    long_values_[ i ].push_back( long_values[ i ] );
+    long_values_[ i ].push_back( long_values[ i ], chunk_size_ );
+  }
+}
+
+void
+nest::RecordingBackendMemory::DeviceData::push_back( const RecordBatch& batch )
+{
+  // fill one column after the other, making room for the whole batch first
+  const size_t n = batch.size_;
+
+  senders_.reserve( n, chunk_size_ );
+  for ( size_t i = 0; i < n; ++i )
+  {
+    senders_.push_back( batch.senders_[ i ], chunk_size_ );
+  }
+
+  if ( time_in_steps_ )
+  {
+    times_steps_.reserve( n, chunk_size_ );
+    times_offset_.reserve( n, chunk_size_ );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      times_steps_.push_back( batch.stamps_[ i ].get_steps(), chunk_size_ );
+      times_offset_.push_back( batch.get_offset( i ), chunk_size_ );
+    }
+  }
+  else
+  {
+    times_ms_.reserve( n, chunk_size_ );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      times_ms_.push_back( batch.stamps_[ i ].get_ms() - batch.get_offset( i ), chunk_size_ );
+    }
+  }
+
+  for ( size_t j = 0; j < batch.n_double_values_; ++j )
+  {
+    double_values_[ j ].reserve( n, chunk_size_ );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      double_values_[ j ].push_back( batch.double_values_[ i * batch.n_double_values_ + j ], chunk_size_ );
+    }
+  }
+  for ( size_t j = 0; j < batch.n_long_values_; ++j )
+  {
+    long_values_[ j ].reserve( n, chunk_size_ );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      long_values_[ j ].push_back( batch.long_values_[ i * batch.n_long_values_ + j ], chunk_size_ );
+    }
   }
 }
 
@@ -229,32 +484,25 @@ nest::RecordingBackendMemory::DeviceData::get_status( DictionaryDatum& d ) const
     events = getValue< DictionaryDatum >( d, names::events );
   }
 
-  initialize_property_intvector( events, names::senders );
-  append_property( events, names::senders, senders_ );
+  senders_.add_to( events, names::senders );
 
   if ( time_in_steps_ )
   {
-    initialize_property_intvector( events, names::times );
-    append_property( events, names::times, times_steps_ );
-
-    initialize_property_doublevector( events, names::offsets );
-    append_property( events, names::offsets, times_offset_ );
+    times_steps_.add_to( events, names::times );
+    times_offset_.add_to( events, names::offsets );
   }
   else
   {
-    initialize_property_doublevector( events, names::times );
-    append_property( events, names::times, times_ms_ );
+    times_ms_.add_to( events, names::times );
   }
 
   for ( size_t i = 0; i < double_values_.size(); ++i )
   {
-    initialize_property_doublevector( events, double_value_names_[ i ] );
-    append_property( events, double_value_names_[ i ], double_values_[ i ] );
+    double_values_[ i ].add_to( events, double_value_names_[ i ] );
   }
   for ( size_t i = 0; i < long_values_.size(); ++i )
   {
-    initialize_property_intvector( events, long_value_names_[ i ] );
-    append_property( events, long_value_names_[ i ], long_values_[ i ] );
+    long_values_[ i ].add_to( events, long_value_names_[ i ] );
   }
 
   ( *d )[ names::time_in_steps ] = time_in_steps_;
@@ -289,12 +537,12 @@ nest::RecordingBackendMemory::DeviceData::clear()
   times_steps_.clear();
   times_offset_.clear();
 
-  for ( size_t i = 0; i < double_values_.size(); ++i )
+  for ( auto& values : double_values_ )
   {
-    double_values_[ i ].clear();
+    values.clear();
   }
-  for ( size_t i = 0; i < long_values_.size(); ++i )
+  for ( auto& values : long_values_ )
   {
-    long_values_[ i ].clear();
+    values.clear();
   }
 }
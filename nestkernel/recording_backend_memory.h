@@ -26,6 +26,9 @@
 // Includes from nestkernel:
 #include "recording_backend.h"
 
+// Includes from sli:
+#include "arraydatum.h"
+
 /* BeginUserDocs: recording backend
 
 Store data in main memory
@@ -61,11 +64,38 @@ be read out of the `n_events` entry in the status dictionary of the
 recording device. To delete data from memory, `n_events` can be set to
 0. Other values cannot be set.
 
+Reading the ``events`` does not copy the recorded data if the device
+only runs on a single thread: the arrays in the ``events`` dictionary
+share their memory with the backend. The backend only makes a copy
+once it has to add new data while the arrays are still in use. If the
+data is deleted by setting `n_events` to 0 after reading it, the
+backend starts with new arrays and hands the old ones over to the
+user. The function ``nest.ConsumeEvents()`` combines both steps and
+allows to fetch the data of long simulations piecewise and without
+copying it.
+
+Before each call to ``Run``, the backend asks every recording device
+for the number of events it expects to record and reserves memory for
+them. Multimeters and their descendants can compute this number from
+their recording interval, the simulation time and the number of nodes
+they are connected to, so their data never has to be moved while the
+simulation is running. For other devices, the number of events is not
+known in advance. If the global property ``chunk_size`` of the backend
+is set to a positive value, their data is stored in chunks of this
+number of events instead of a single array that is enlarged whenever
+it is full. The chunks are joined when the ``events`` are read.
+
 Parameter summary
 +++++++++++++++++
 
 .. glossary::
 
+ chunk_size
+   The number of events per chunk if data is stored in chunks, or 0
+   (which is the default) to store the data of each device in a single
+   array. This is a global property of the backend, which is set via
+   the kernel property ``recording_backends``.
+
  events
    A dictionary containing the recorded data in the form of one numeric
    array for each quantity measured. It always has the sender global
@@ -106,6 +136,10 @@ namespace nest
  * the basic data structure during the call to enroll(), when the
  * exact fields are known.
  *
+ * In pre_run_hook(), the backend reserves memory for the number of
+ * events each device expects to record during the upcoming run. If
+ * chunk_size_ is positive, data is stored in chunks of fixed capacity,
+ * so that the data recorded before is never moved during simulation.
  */
 class RecordingBackendMemory : public RecordingBackend
 {
@@ -130,6 +164,8 @@ public:
 
   void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
 
+  void write_batch( const RecordingDevice&, const RecordBatch& ) override;
+
   void pre_run_hook() override;
 
   void post_run_hook() override;
@@ -145,29 +181,69 @@ public:
   void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
 
 private:
+  /**
+   * Recorded values of one quantity.
+   *
+   * The values are kept in a sequence of vectors, which are held by
+   * reference counted datums, so that get_status() can pass them on
+   * without copying. Only the last vector is ever modified, and only
+   * while it is not shared. A shared last vector is replaced by a copy
+   * or, if chunk_size is positive, followed by a new chunk.
+   */
+  template < typename T, SLIType* slt >
+  class Column
+  {
+  public:
+    Column();
+
+    void push_back( const T& value, size_t chunk_size );
+    void reserve( size_t n_values, size_t chunk_size );
+    void clear();
+    void add_to( DictionaryDatum& events, Name name ) const;
+
+  private:
+    typedef lockPTRDatum< std::vector< T >, slt > VectorDatumT;
+
+    void next_chunk_( size_t chunk_size );
+    void join_chunks_() const;
+
+    mutable std::vector< VectorDatumT > chunks_; //!< recorded values, joined by get_status()
+  };
+
+  typedef Column< long, &SLIInterpreter::IntVectortype > LongColumn;
+  typedef Column< double, &SLIInterpreter::DoubleVectortype > DoubleColumn;
+
   struct DeviceData
   {
     DeviceData();
+    DeviceData( const RecordingDevice* device );
     void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
+    void reserve( size_t chunk_size );
     void push_back( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void push_back( const RecordBatch& );
     void get_status( DictionaryDatum& ) const;
     void set_status( const DictionaryDatum& );
 
   private:
     void clear();
-    std::vector< long > senders_;                        //!< sender node IDs of the events
-    std::vector< double > times_ms_;                     //!< times of registered events in ms
-    std::vector< long > times_steps_;                    //!< times of registered events in steps
-    std::vector< double > times_offset_;                 //!< offsets of registered events if time_in_steps_
-    std::vector< Name > double_value_names_;             //!< names for values of type double
-    std::vector< Name > long_value_names_;               //!< names for values of type long
-    std::vector< std::vector< double > > double_values_; //!< recorded values of type double, one vector per value
-    std::vector< std::vector< long > > long_values_;     //!< recorded values of type long, one vector per value
-    bool time_in_steps_;                                 //!< Should time be recorded in steps (ms if false)
+
+    const RecordingDevice* device_;             //!< the device recording to this data, or 0
+    size_t chunk_size_;                         //!< number of values per chunk, 0 for a single vector
+    LongColumn senders_;                        //!< sender node IDs of the events
+    DoubleColumn times_ms_;                     //!< times of registered events in ms
+    LongColumn times_steps_;                    //!< times of registered events in steps
+    DoubleColumn times_offset_;                 //!< offsets of registered events if time_in_steps_
+    std::vector< Name > double_value_names_;    //!< names for values of type double
+    std::vector< Name > long_value_names_;      //!< names for values of type long
+    std::vector< DoubleColumn > double_values_; //!< recorded values of type double, one column per value
+    std::vector< LongColumn > long_values_;     //!< recorded values of type long, one column per value
+    bool time_in_steps_;                        //!< Should time be recorded in steps (ms if false)
   };
 
   typedef std::vector< std::map< size_t, DeviceData > > device_data_map;
   device_data_map device_data_;
+
+  size_t chunk_size_; //!< number of values per chunk, 0 for a single vector
 };
 
 } // namespace
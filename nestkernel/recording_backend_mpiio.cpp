@@ -0,0 +1,644 @@
+/*
+ *  recording_backend_mpiio.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// C++ includes:
+#include <cstring>
+#include <fstream>
+#include <set>
+
+// Generated includes:
+#include "config.h"
+
+// Includes from libnestutil:
+#include "compose.hpp"
+
+// Includes from nestkernel:
+#include "recording_backend_binary.h"
+#include "recording_device.h"
+#include "vp_manager_impl.h"
+
+// includes from sli:
+#include "arraydatum.h"
+#include "dictutils.h"
+#include "stringdatum.h"
+
+#include "recording_backend_mpiio.h"
+
+namespace
+{
+
+void
+append_uint32_( std::string& s, const uint32_t value )
+{
+  s.append( reinterpret_cast< const char* >( &value ), sizeof( value ) );
+}
+
+void
+append_string_( std::string& s, const std::string& value )
+{
+  append_uint32_( s, value.size() );
+  s.append( value );
+}
+
+} // namespace
+
+nest::RecordingBackendMPIIO::RecordingBackendMPIIO()
+  : flush_interval_( 100.0 )
+  , write_error_( false )
+{
+}
+
+nest::RecordingBackendMPIIO::~RecordingBackendMPIIO() throw()
+{
+}
+
+void
+nest::RecordingBackendMPIIO::initialize()
+{
+  data_map tmp( kernel().vp_manager.get_num_threads() );
+  device_data_.swap( tmp );
+}
+
+void
+nest::RecordingBackendMPIIO::finalize()
+{
+  close_files_();
+}
+
+void
+nest::RecordingBackendMPIIO::enroll( const RecordingDevice& device, const DictionaryDatum& params )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    std::string node_id_string = compute_node_id_string_( device );
+    std::string modelname = device.get_name();
+    auto p = device_data_[ t ].insert( std::make_pair( node_id, DeviceData( modelname, node_id_string ) ) );
+    device_data = p.first;
+  }
+
+  device_data->second.set_status( params );
+}
+
+void
+nest::RecordingBackendMPIIO::disenroll( const RecordingDevice& device )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data_[ t ].erase( device_data );
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::set_value_names( const RecordingDevice& device,
+  const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  assert( device_data != device_data_[ t ].end() );
+  device_data->second.set_value_names( double_value_names, long_value_names );
+}
+
+void
+nest::RecordingBackendMPIIO::prepare()
+{
+  MPI_Comm comm = kernel().mpi_manager.get_communicator();
+  const bool is_root = kernel().mpi_manager.get_rank() == 0;
+
+  // all processes have a sibling of each device on each of their
+  // threads, so the set of node IDs is the same on all processes
+  std::set< index > node_ids;
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      node_ids.insert( device_data.first );
+    }
+  }
+
+  for ( const index node_id : node_ids )
+  {
+    const DeviceData* device_data = nullptr;
+    for ( auto& inner : device_data_ )
+    {
+      auto it = inner.find( node_id );
+      if ( it != inner.end() )
+      {
+        device_data = &it->second;
+        break;
+      }
+    }
+
+    const std::string filename = device_data->compute_filename();
+
+    int exists = 0;
+    if ( is_root )
+    {
+      std::ifstream test( filename.c_str() );
+      exists = test.good();
+    }
+    MPI_Bcast( &exists, 1, MPI_INT, 0, comm );
+
+    if ( exists and not kernel().io_manager.overwrite_files() )
+    {
+      std::string msg = String::compose(
+        "The file '%1' already exists and overwriting files is disabled. To overwrite files, set "
+        "the kernel property overwrite_files to true. To change the name or location of the file, "
+        "change the kernel properties data_path or data_prefix, or the device property label.",
+        filename );
+      LOG( M_ERROR, "RecordingBackendMPIIO::prepare()", msg );
+      throw IOError();
+    }
+
+    FileEntry entry;
+    const int mode = MPI_MODE_WRONLY | MPI_MODE_CREATE;
+    if ( MPI_File_open( comm, const_cast< char* >( filename.c_str() ), mode, MPI_INFO_NULL, &entry.file_ )
+      != MPI_SUCCESS )
+    {
+      std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+      LOG( M_ERROR, "RecordingBackendMPIIO::prepare()", msg );
+      throw IOError();
+    }
+
+    const std::string header = device_data->header();
+    entry.end_ = header.size();
+    files_.insert( std::make_pair( node_id, entry ) );
+
+    // discard the contents of an existing file
+    bool error = MPI_File_set_size( entry.file_, 0 ) != MPI_SUCCESS;
+    if ( is_root )
+    {
+      char* data = const_cast< char* >( header.data() );
+      error =
+        error or MPI_File_write_at( entry.file_, 0, data, header.size(), MPI_BYTE, MPI_STATUS_IGNORE ) != MPI_SUCCESS;
+    }
+
+    check_error_( error, String::compose( "I/O error while writing header of file '%1'.", filename ) );
+  }
+
+  write_error_ = false;
+}
+
+void
+nest::RecordingBackendMPIIO::cleanup()
+{
+  close_files_();
+}
+
+void
+nest::RecordingBackendMPIIO::pre_run_hook()
+{
+  next_flush_ = kernel().simulation_manager.get_clock() + Time::ms( flush_interval_ );
+}
+
+void
+nest::RecordingBackendMPIIO::post_run_hook()
+{
+  flush_();
+
+  for ( auto& file : files_ )
+  {
+    write_error_ = write_error_ or MPI_File_sync( file.second.file_ ) != MPI_SUCCESS;
+  }
+
+  check_error_( write_error_, "I/O error while writing recorded data." );
+}
+
+void
+nest::RecordingBackendMPIIO::post_step_hook()
+{
+  // collective MPI calls are only allowed on the master thread; all
+  // threads are synchronized before and after this function is called
+#pragma omp master
+  {
+    if ( flush_interval_ > 0 and not files_.empty() and kernel().simulation_manager.get_clock() >= next_flush_ )
+    {
+      flush_();
+      next_flush_ = kernel().simulation_manager.get_clock() + Time::ms( flush_interval_ );
+    }
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::write( const RecordingDevice& device,
+  const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( event, double_values, long_values );
+}
+
+void
+nest::RecordingBackendMPIIO::pack_block_( index node_id, std::vector< uint64_t >& block )
+{
+  // NumPy reads the columns as 64 bit values
+  static_assert( sizeof( long ) == 8 and sizeof( double ) == 8, "MPI-IO recording requires 64 bit long and double." );
+
+  std::vector< DeviceData* > siblings;
+  size_t n_records = 0;
+  for ( auto& inner : device_data_ )
+  {
+    auto it = inner.find( node_id );
+    if ( it != inner.end() )
+    {
+      siblings.push_back( &it->second );
+      n_records += it->second.long_columns_[ 0 ].size(); // senders
+    }
+  }
+
+  block.clear();
+  if ( n_records == 0 )
+  {
+    return;
+  }
+
+  const std::vector< bool > column_is_long = siblings[ 0 ]->column_is_long();
+  block.resize( 1 + n_records * column_is_long.size() );
+  block[ 0 ] = n_records;
+
+  uint64_t* pos = &block[ 1 ];
+  size_t long_column = 0;
+  size_t double_column = 0;
+  for ( const bool is_long : column_is_long )
+  {
+    for ( DeviceData* device_data : siblings )
+    {
+      if ( is_long )
+      {
+        const std::vector< long >& values = device_data->long_columns_[ long_column ];
+        std::memcpy( pos, values.data(), values.size() * sizeof( long ) );
+        pos += values.size();
+      }
+      else
+      {
+        const std::vector< double >& values = device_data->double_columns_[ double_column ];
+        std::memcpy( pos, values.data(), values.size() * sizeof( double ) );
+        pos += values.size();
+      }
+    }
+    is_long ? ++long_column : ++double_column;
+  }
+
+  for ( DeviceData* device_data : siblings )
+  {
+    device_data->clear();
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::flush_()
+{
+  if ( files_.empty() )
+  {
+    return;
+  }
+
+  MPI_Comm comm = kernel().mpi_manager.get_communicator();
+  const int n_files = files_.size();
+
+  std::vector< std::vector< uint64_t > > blocks( n_files );
+  std::vector< uint64_t > block_sizes( n_files );
+  size_t i = 0;
+  for ( auto& file : files_ )
+  {
+    pack_block_( file.first, blocks[ i ] );
+    block_sizes[ i ] = blocks[ i ].size();
+    ++i;
+  }
+
+  // the block of each process starts after the blocks of all processes
+  // with lower rank; MPI_Exscan leaves the result on rank 0 undefined
+  std::vector< uint64_t > block_offsets( n_files, 0 );
+  std::vector< uint64_t > total_sizes( n_files );
+  MPI_Exscan( &block_sizes[ 0 ], &block_offsets[ 0 ], n_files, MPI_UINT64_T, MPI_SUM, comm );
+  if ( kernel().mpi_manager.get_rank() == 0 )
+  {
+    std::fill( block_offsets.begin(), block_offsets.end(), 0 );
+  }
+  MPI_Allreduce( &block_sizes[ 0 ], &total_sizes[ 0 ], n_files, MPI_UINT64_T, MPI_SUM, comm );
+
+  i = 0;
+  for ( auto& file : files_ )
+  {
+    if ( total_sizes[ i ] > 0 )
+    {
+      const MPI_Offset position = file.second.end_ + block_offsets[ i ] * sizeof( uint64_t );
+      write_error_ = write_error_
+        or MPI_File_write_at_all(
+             file.second.file_, position, blocks[ i ].data(), blocks[ i ].size(), MPI_UINT64_T, MPI_STATUS_IGNORE )
+          != MPI_SUCCESS;
+      file.second.end_ += total_sizes[ i ] * sizeof( uint64_t );
+    }
+    ++i;
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::check_error_( bool local_error, const std::string& msg ) const
+{
+  int error = local_error;
+  int any_error = 0;
+  MPI_Allreduce( &error, &any_error, 1, MPI_INT, MPI_LOR, kernel().mpi_manager.get_communicator() );
+
+  if ( any_error )
+  {
+    LOG( M_ERROR, "RecordingBackendMPIIO", msg );
+    throw IOError();
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::close_files_()
+{
+  for ( auto& file : files_ )
+  {
+    MPI_File_close( &file.second.file_ );
+  }
+  files_.clear();
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.clear();
+    }
+  }
+}
+
+const std::string
+nest::RecordingBackendMPIIO::compute_node_id_string_( const RecordingDevice& device ) const
+{
+  const float num_nodes = kernel().node_manager.size();
+  const int node_id_digits = static_cast< int >( std::floor( std::log10( num_nodes ) ) + 1 );
+
+  std::ostringstream node_id_string;
+  node_id_string << "-" << std::setfill( '0' ) << std::setw( node_id_digits ) << device.get_node_id();
+
+  return node_id_string.str();
+}
+
+void
+nest::RecordingBackendMPIIO::set_status( const DictionaryDatum& d )
+{
+  double flush_interval = flush_interval_;
+  if ( updateValue< double >( d, names::flush_interval, flush_interval ) )
+  {
+    if ( not files_.empty() )
+    {
+      throw BadProperty( "Property flush_interval cannot be set while files are open." );
+    }
+    if ( flush_interval < 0 )
+    {
+      throw BadProperty( "Property flush_interval must not be negative." );
+    }
+    flush_interval_ = flush_interval;
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::flush_interval ] = flush_interval_;
+}
+
+void
+nest::RecordingBackendMPIIO::check_device_status( const DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.set_status( params ); // throws if params contains invalid entries
+}
+
+void
+nest::RecordingBackendMPIIO::get_device_defaults( DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.get_status( params );
+}
+
+void
+nest::RecordingBackendMPIIO::get_device_status( const nest::RecordingDevice& device, DictionaryDatum& d ) const
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::const_iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data->second.get_status( d );
+  }
+}
+
+/* ******************* Device meta data class DeviceData ******************* */
+
+nest::RecordingBackendMPIIO::DeviceData::DeviceData( std::string modelname, std::string node_id_string )
+  : long_columns_( 1 )
+  , double_columns_( 1 )
+  , time_in_steps_( false )
+  , modelname_( modelname )
+  , node_id_string_( node_id_string )
+  , file_extension_( "mpiio" )
+  , label_( "" )
+{
+}
+
+void
+nest::RecordingBackendMPIIO::DeviceData::set_value_names( const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  double_value_names_ = double_value_names;
+  long_value_names_ = long_value_names;
+
+  // senders and optionally time steps, times in ms or offsets
+  long_columns_.resize( 1 + ( time_in_steps_ ? 1 : 0 ) + long_value_names_.size() );
+  double_columns_.resize( 1 + double_value_names_.size() );
+}
+
+std::vector< bool >
+nest::RecordingBackendMPIIO::DeviceData::column_is_long() const
+{
+  std::vector< bool > column_is_long;
+  column_is_long.push_back( true ); // senders
+  if ( time_in_steps_ )
+  {
+    column_is_long.push_back( true );  // times
+    column_is_long.push_back( false ); // offsets
+  }
+  else
+  {
+    column_is_long.push_back( false ); // times
+  }
+  column_is_long.insert( column_is_long.end(), double_value_names_.size(), false );
+  column_is_long.insert( column_is_long.end(), long_value_names_.size(), true );
+  return column_is_long;
+}
+
+void
+nest::RecordingBackendMPIIO::DeviceData::write( const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  assert( double_values.size() == double_value_names_.size() );
+  assert( long_values.size() == long_value_names_.size() );
+
+  size_t long_column = 0;
+  size_t double_column = 0;
+
+  long_columns_[ long_column++ ].push_back( event.get_sender_node_id() );
+
+  if ( time_in_steps_ )
+  {
+    long_columns_[ long_column++ ].push_back( event.get_stamp().get_steps() );
+    double_columns_[ double_column++ ].push_back( event.get_offset() );
+  }
+  else
+  {
+    double_columns_[ double_column++ ].push_back( event.get_stamp().get_ms() - event.get_offset() );
+  }
+
+  for ( auto& val : double_values )
+  {
+    double_columns_[ double_column++ ].push_back( val );
+  }
+  for ( auto& val : long_values )
+  {
+    long_columns_[ long_column++ ].push_back( val );
+  }
+}
+
+void
+nest::RecordingBackendMPIIO::DeviceData::clear()
+{
+  // keep the capacity, as the columns fill up again in the next interval
+  for ( auto& column : long_columns_ )
+  {
+    column.clear();
+  }
+  for ( auto& column : double_columns_ )
+  {
+    column.clear();
+  }
+}
+
+std::string
+nest::RecordingBackendMPIIO::DeviceData::header() const
+{
+  std::string header( "NESTBIN", 8 ); // includes the terminating null byte
+  append_uint32_( header, 0x01020304 );
+  append_uint32_( header, RecordingBackendBinary::BINARY_REC_BACKEND_VERSION );
+  append_string_( header, NEST_VERSION_STRING );
+  append_string_( header, label_.empty() ? modelname_ : label_ );
+
+  std::vector< std::string > column_names;
+  column_names.push_back( names::senders.toString() );
+  column_names.push_back( names::times.toString() );
+  if ( time_in_steps_ )
+  {
+    column_names.push_back( names::offsets.toString() );
+  }
+  for ( auto& val : double_value_names_ )
+  {
+    column_names.push_back( val.toString() );
+  }
+  for ( auto& val : long_value_names_ )
+  {
+    column_names.push_back( val.toString() );
+  }
+
+  const std::vector< bool > is_long = column_is_long();
+  append_uint32_( header, column_names.size() );
+  for ( size_t i = 0; i < column_names.size(); ++i )
+  {
+    header.push_back( is_long[ i ] ? 'l' : 'd' );
+    append_string_( header, column_names[ i ] );
+  }
+
+  return header;
+}
+
+void
+nest::RecordingBackendMPIIO::DeviceData::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::file_extension ] = file_extension_;
+  ( *d )[ names::time_in_steps ] = time_in_steps_;
+
+  // all siblings of the device share the file, so it is only listed once
+  ArrayDatum filenames;
+  filenames.push_back( new StringDatum( compute_filename() ) );
+  ( *d )[ names::filenames ] = filenames;
+}
+
+void
+nest::RecordingBackendMPIIO::DeviceData::set_status( const DictionaryDatum& d )
+{
+  updateValue< std::string >( d, names::file_extension, file_extension_ );
+  updateValue< std::string >( d, names::label, label_ );
+
+  bool time_in_steps = false;
+  if ( updateValue< bool >( d, names::time_in_steps, time_in_steps ) )
+  {
+    if ( kernel().simulation_manager.has_been_simulated() )
+    {
+      throw BadProperty( "Property time_in_steps cannot be set after Simulate has been called." );
+    }
+
+    time_in_steps_ = time_in_steps;
+  }
+}
+
+std::string
+nest::RecordingBackendMPIIO::DeviceData::compute_filename() const
+{
+  std::string data_path = kernel().io_manager.get_data_path();
+  if ( not data_path.empty() and not( data_path[ data_path.size() - 1 ] == '/' ) )
+  {
+    data_path += '/';
+  }
+
+  std::string label = label_;
+  if ( label.empty() )
+  {
+    label = modelname_;
+  }
+
+  std::string data_prefix = kernel().io_manager.get_data_prefix();
+
+  return data_path + data_prefix + label + node_id_string_ + "." + file_extension_;
+}
@@ -0,0 +1,250 @@
+/*
+ *  recording_backend_mpiio.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECORDING_BACKEND_MPIIO_H
+#define RECORDING_BACKEND_MPIIO_H
+
+// C++ includes:
+#include <cstdint>
+
+// External includes:
+#include <mpi.h>
+
+// Includes from nestkernel:
+#include "nest_time.h"
+#include "nest_types.h"
+#include "recording_backend.h"
+
+/* BeginUserDocs: recording backend
+
+.. _recording_backend_mpiio:
+
+Write data to shared files using MPI-IO
+#######################################
+
+The `mpiio` recording backend writes the data of each recording device
+into a single file that is shared by all MPI processes and threads. In
+contrast to the :ref:`recording backend for binary files
+<recording_backend_binary>`, which creates one file per device per
+thread on each MPI process, the number of files thus does not grow with
+the number of virtual processes. Unlike the :ref:`SIONlib recording
+backend <recording_backend_sionlib>`, it only requires MPI and is
+available whenever NEST is compiled with MPI support.
+
+Recorded events are collected in memory on each thread. At regular
+intervals of simulated time, which are given by the global property
+``flush_interval``, and at the end of each call to ``Run``, the
+collected data of all threads of an MPI process are written as one
+block to the file of the device. All MPI processes write their blocks
+at the same time using collective MPI-IO operations, which allows the
+MPI library to aggregate the writes.
+
+Filenames are determined according to the following pattern:
+
+::
+
+   data_path/data_prefix(label|model_name)-node_id.file_extension
+
+The life of a file starts with the call to ``Prepare`` and ends with
+the call to ``Cleanup``. The call to ``Run`` writes all data recorded
+during the run and synchronizes the files, so the data is available for
+immediate inspection. As for the other file based backends, existing
+files are only overwritten if the kernel property ``overwrite_files``
+is set to *true*.
+
+Data format
++++++++++++
+
+The files use the same format as the files of the :ref:`binary
+recording backend <recording_backend_binary>` and can be read with the
+function ``nest.ReadBinaryRecording()``. Each block contains the
+records of one MPI process. Within a block, records are ordered by
+thread, and blocks of different MPI processes written at the same time
+are ordered by rank. Records are therefore only sorted by time if the
+simulation uses a single virtual process.
+
+Parameter summary
++++++++++++++++++
+
+.. glossary::
+
+ file_extension
+   A string (default: *"mpiio"*) that specifies the file name
+   extension, without leading dot.
+
+ filenames
+   A list with the name of the file where data is recorded to. This is
+   a read-only property.
+
+ flush_interval
+   The interval of simulated time in ms after which the collected data
+   are written to the files (default: *100.0*). If set to *0.0*, data
+   are only written at the end of each call to ``Run``. This is a
+   global property of the backend, which is set via the kernel
+   property ``recording_backends``. It cannot be changed while files
+   are open.
+
+ label
+   A string (default: *""*) that replaces the model name component in
+   the filename if it is set.
+
+ time_in_steps
+   A Boolean (default: *false*) specifying whether to write time in
+   steps, i.e., in integer multiples of the simulation resolution plus
+   a floating point number for the negative offset from the next grid
+   point in ms, or just the simulation time in ms. This property
+   cannot be set after Simulate has been called.
+
+EndUserDocs */
+
+namespace nest
+{
+
+/**
+ * MPI-IO specialization of the RecordingBackend interface.
+ *
+ * RecordingBackendMPIIO keeps the records of every recording device
+ * instance on every thread in a DeviceData, which only the thread of
+ * the device writes to. The files are shared by all MPI processes and
+ * are opened, written and closed with collective operations. As these
+ * must be called in the same order on all processes, all files are
+ * handled in the order of the node IDs of their devices and are only
+ * written by the master thread, in post_step_hook() at fixed intervals
+ * of simulated time and in post_run_hook().
+ *
+ * Errors that occur while writing during the simulation are recorded
+ * and reported consistently on all processes by post_run_hook().
+ */
+class RecordingBackendMPIIO : public RecordingBackend
+{
+public:
+  RecordingBackendMPIIO();
+
+  ~RecordingBackendMPIIO() throw();
+
+  void initialize() override;
+
+  void finalize() override;
+
+  void enroll( const RecordingDevice& device, const DictionaryDatum& params ) override;
+
+  void disenroll( const RecordingDevice& device ) override;
+
+  void set_value_names( const RecordingDevice& device,
+    const std::vector< Name >& double_value_names,
+    const std::vector< Name >& long_value_names ) override;
+
+  /**
+   * Open files and write their headers
+   */
+  void prepare() override;
+
+  /**
+   * Close files
+   */
+  void cleanup() override;
+
+  void pre_run_hook() override;
+
+  /**
+   * Write all data of the run and synchronize files
+   */
+  void post_run_hook() override;
+
+  /**
+   * Write the collected data if the flush interval has passed
+   */
+  void post_step_hook() override;
+
+  void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
+
+  void set_status( const DictionaryDatum& ) override;
+  void get_status( DictionaryDatum& ) const override;
+
+  void check_device_status( const DictionaryDatum& ) const override;
+  void get_device_defaults( DictionaryDatum& ) const override;
+  void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
+
+private:
+  const std::string compute_node_id_string_( const RecordingDevice& device ) const;
+
+  struct DeviceData
+  {
+    DeviceData() = delete;
+    DeviceData( std::string, std::string );
+    void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
+    void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void clear();
+    std::string header() const; //!< Header of the file in the format of the binary backend
+    void get_status( DictionaryDatum& ) const;
+    void set_status( const DictionaryDatum& );
+    std::string compute_filename() const; //!< Compose and return the filename
+    std::vector< bool > column_is_long() const; //!< Column types in file order
+
+    std::vector< std::vector< long > > long_columns_;     //!< Collected values of integer columns
+    std::vector< std::vector< double > > double_columns_; //!< Collected values of floating point columns
+    bool time_in_steps_;                                  //!< Should time be recorded in steps (ms if false)
+    std::string modelname_;                               //!< File name up to but not including the "."
+    std::string node_id_string_;                          //!< The node ID component of the filename
+    std::string file_extension_;                          //!< File name extension without leading "."
+    std::string label_;                                   //!< The label of the device.
+    std::vector< Name > double_value_names_;              //!< names for values of type double
+    std::vector< Name > long_value_names_;                //!< names for values of type long
+  };
+
+  //! Shared file of one device
+  struct FileEntry
+  {
+    MPI_File file_;
+    MPI_Offset end_; //!< Position up to which all processes have written
+  };
+
+  /**
+   * Pack the data collected for a device on all threads as one block.
+   *
+   * The block is empty if no data has been collected. Values are stored
+   * as 64 bit words, so that blocks can be written with a single MPI
+   * datatype.
+   */
+  void pack_block_( index node_id, std::vector< uint64_t >& block );
+
+  //! Write the collected data of all devices and clear it
+  void flush_();
+
+  //! Throw IOError on all processes if an error occurred on any of them
+  void check_error_( bool local_error, const std::string& msg ) const;
+
+  void close_files_();
+
+  typedef std::vector< std::map< size_t, DeviceData > > data_map;
+  data_map device_data_;
+
+  std::map< index, FileEntry > files_; //!< Files of all devices, ordered by node ID
+
+  double flush_interval_; //!< Interval of simulated time between writes in ms
+  Time next_flush_;       //!< Time of the next write during a run
+  bool write_error_;      //!< Set if writing failed on this process
+};
+
+} // namespace
+
+#endif // RECORDING_BACKEND_MPIIO_H
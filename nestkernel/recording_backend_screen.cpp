@@ -106,6 +106,21 @@ nest::RecordingBackendScreen::write( const RecordingDevice& device,
   device_data_[ t ][ node_id ].write( event, double_values, long_values );
 }
 
+void
+nest::RecordingBackendScreen::write_batch( const RecordingDevice& device, const RecordBatch& batch )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  device_data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( batch );
+}
+
 void
 nest::RecordingBackendScreen::check_device_status( const DictionaryDatum& params ) const
 {
@@ -194,30 +209,69 @@ nest::RecordingBackendScreen::DeviceData::write( const Event& event,
 #pragma omp critical
   {
     prepare_cout_();
+    write_record_( event.get_sender_node_id(),
+      event.get_stamp(),
+      event.get_offset(),
+      double_values.data(),
+      double_values.size(),
+      long_values.data(),
+      long_values.size() );
+    std::cout << std::flush;
+    restore_cout_();
+  }
+}
 
-    std::cout << event.get_sender_node_id() << "\t";
-
-    if ( time_in_steps_ )
-    {
-      std::cout << event.get_stamp().get_steps() << "\t" << event.get_offset();
-    }
-    else
+void
+nest::RecordingBackendScreen::DeviceData::write( const RecordBatch& batch )
+{
+  // the lines of a batch are printed together and flushed once
+#pragma omp critical
+  {
+    prepare_cout_();
+    for ( size_t i = 0; i < batch.size_; ++i )
     {
-      std::cout << event.get_stamp().get_ms() - event.get_offset();
+      write_record_( batch.senders_[ i ],
+        batch.stamps_[ i ],
+        batch.get_offset( i ),
+        batch.double_values_ + i * batch.n_double_values_,
+        batch.n_double_values_,
+        batch.long_values_ + i * batch.n_long_values_,
+        batch.n_long_values_ );
     }
+    std::cout << std::flush;
+    restore_cout_();
+  }
+}
 
-    for ( auto& val : double_values )
-    {
-      std::cout << "\t" << val;
-    }
-    for ( auto& val : long_values )
-    {
-      std::cout << "\t" << val;
-    }
-    std::cout << std::endl;
+void
+nest::RecordingBackendScreen::DeviceData::write_record_( const index sender,
+  const Time& stamp,
+  const double offset,
+  const double* double_values,
+  const size_t n_double_values,
+  const long* long_values,
+  const size_t n_long_values )
+{
+  std::cout << sender << "\t";
 
-    restore_cout_();
+  if ( time_in_steps_ )
+  {
+    std::cout << stamp.get_steps() << "\t" << offset;
+  }
+  else
+  {
+    std::cout << stamp.get_ms() - offset;
+  }
+
+  for ( size_t i = 0; i < n_double_values; ++i )
+  {
+    std::cout << "\t" << double_values[ i ];
+  }
+  for ( size_t i = 0; i < n_long_values; ++i )
+  {
+    std::cout << "\t" << long_values[ i ];
   }
+  std::cout << "\n";
 }
 
 void
@@ -106,6 +106,8 @@ public:
 
   void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
 
+  void write_batch( const RecordingDevice&, const RecordBatch& ) override;
+
   void pre_run_hook() override;
 
   void post_run_hook() override;
@@ -127,10 +129,13 @@ private:
     void get_status( DictionaryDatum& ) const;
     void set_status( const DictionaryDatum& );
     void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void write( const RecordBatch& );
 
   private:
     void prepare_cout_();
     void restore_cout_();
+    //! Write one line with the given time stamp and values to std::cout, without flushing it
+    void write_record_( index sender, const Time& stamp, double offset, const double*, size_t, const long*, size_t );
     std::ios::fmtflags old_fmtflags_;
     long old_precision_;
     long precision_;     //!< Number of decimal places used when writing decimal values
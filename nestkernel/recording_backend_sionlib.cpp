@@ -432,19 +432,73 @@ nest::RecordingBackendSIONlib::write( const RecordingDevice& device,
   const thread t = device.get_thread();
   const sion_uint64 device_node_id = static_cast< sion_uint64 >( device.get_node_id() );
 
-  if ( devices_[ t ].find( device_node_id ) == devices_[ t ].end() )
+  device_map::value_type::iterator device_entry = devices_[ t ].find( device_node_id );
+  if ( device_entry == devices_[ t ].end() )
   {
     return;
   }
 
-  FileEntry& file = files_[ device.get_vp() ];
-  SIONBuffer& buffer = file.buffer;
-  DeviceInfo& device_info = devices_[ t ].find( device_node_id )->second.info;
-
+  DeviceInfo& device_info = device_entry->second.info;
   assert( device_info.double_value_names.size() == double_values.size() );
-  const sion_uint32 double_n_values = static_cast< sion_uint32 >( double_values.size() );
   assert( device_info.long_value_names.size() == long_values.size() );
-  const sion_uint32 long_n_values = static_cast< sion_uint32 >( long_values.size() );
+
+  write_record_( files_[ device.get_vp() ],
+    device_info,
+    device_node_id,
+    static_cast< sion_uint64 >( event.get_sender_node_id() ),
+    static_cast< sion_int64 >( event.get_stamp().get_steps() ),
+    event.get_offset(),
+    double_values.data(),
+    static_cast< sion_uint32 >( double_values.size() ),
+    long_values.data(),
+    static_cast< sion_uint32 >( long_values.size() ) );
+}
+
+void
+nest::RecordingBackendSIONlib::write_batch( const RecordingDevice& device, const RecordBatch& batch )
+{
+  const thread t = device.get_thread();
+  const sion_uint64 device_node_id = static_cast< sion_uint64 >( device.get_node_id() );
+
+  device_map::value_type::iterator device_entry = devices_[ t ].find( device_node_id );
+  if ( device_entry == devices_[ t ].end() )
+  {
+    return;
+  }
+
+  FileEntry& file = files_[ device.get_vp() ];
+  DeviceInfo& device_info = device_entry->second.info;
+  assert( device_info.double_value_names.size() == batch.n_double_values_ );
+  assert( device_info.long_value_names.size() == batch.n_long_values_ );
+
+  for ( size_t i = 0; i < batch.size_; ++i )
+  {
+    write_record_( file,
+      device_info,
+      device_node_id,
+      static_cast< sion_uint64 >( batch.senders_[ i ] ),
+      static_cast< sion_int64 >( batch.stamps_[ i ].get_steps() ),
+      batch.get_offset( i ),
+      batch.double_values_ + i * batch.n_double_values_,
+      static_cast< sion_uint32 >( batch.n_double_values_ ),
+      batch.long_values_ + i * batch.n_long_values_,
+      static_cast< sion_uint32 >( batch.n_long_values_ ) );
+  }
+}
+
+void
+nest::RecordingBackendSIONlib::write_record_( FileEntry& file,
+  DeviceInfo& device_info,
+  const sion_uint64 device_node_id,
+  const sion_uint64 sender_node_id,
+  const sion_int64 step,
+  const double offset,
+  const double* double_values,
+  const sion_uint32 double_n_values,
+  const long* long_values,
+  const sion_uint32 long_n_values )
+{
+  SIONBuffer& buffer = file.buffer;
 
   device_info.n_rec++;
 
@@ -454,21 +508,17 @@ nest::RecordingBackendSIONlib::write( const RecordingDevice& device,
   const unsigned int required_space = 2 * sizeof( sion_uint64 ) + sizeof( sion_int64 ) + sizeof( double )
     + 2 * sizeof( sion_uint32 ) + double_n_values * sizeof( double ) + long_n_values * sizeof( sion_int64 );
 
-  const sion_uint64 sender_node_id = static_cast< sion_uint64 >( event.get_sender_node_id() );
-  const sion_int64 step = static_cast< sion_int64 >( event.get_stamp().get_steps() );
-  const double offset = event.get_offset();
-
   if ( P_.sion_collective_ )
   {
     buffer.ensure_space( required_space );
     buffer << device_node_id << sender_node_id << step << offset << double_n_values << long_n_values;
-    for ( const auto& val : double_values )
+    for ( sion_uint32 i = 0; i < double_n_values; ++i )
     {
-      buffer << val;
+      buffer << double_values[ i ];
     }
-    for ( const auto& val : long_values )
+    for ( sion_uint32 i = 0; i < long_n_values; ++i )
     {
-      buffer << val;
+      buffer << long_values[ i ];
     }
     return;
   }
@@ -482,13 +532,13 @@ nest::RecordingBackendSIONlib::write( const RecordingDevice& device,
     }
 
     buffer << device_node_id << sender_node_id << step << offset << double_n_values << long_n_values;
-    for ( const auto& val : double_values )
+    for ( sion_uint32 i = 0; i < double_n_values; ++i )
     {
-      buffer << val;
+      buffer << double_values[ i ];
     }
-    for ( const auto& val : long_values )
+    for ( sion_uint32 i = 0; i < long_n_values; ++i )
     {
-      buffer << val;
+      buffer << long_values[ i ];
     }
   }
   else
@@ -506,13 +556,10 @@ nest::RecordingBackendSIONlib::write( const RecordingDevice& device,
     sion_fwrite( &double_n_values, sizeof( sion_uint32 ), 1, file.sid );
     sion_fwrite( &long_n_values, sizeof( sion_uint32 ), 1, file.sid );
 
-    for ( const auto& val : double_values )
-    {
-      sion_fwrite( &val, sizeof( double ), 1, file.sid );
-    }
-    for ( const auto& val : long_values )
+    sion_fwrite( double_values, sizeof( double ), double_n_values, file.sid );
+    for ( sion_uint32 i = 0; i < long_n_values; ++i )
     {
-      sion_fwrite( &val, sizeof( sion_int64 ), 1, file.sid );
+      sion_fwrite( &long_values[ i ], sizeof( sion_int64 ), 1, file.sid );
     }
   }
 }
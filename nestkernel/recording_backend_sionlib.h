@@ -223,6 +223,8 @@ public:
     const std::vector< double >& double_values,
     const std::vector< long >& long_values ) override;
 
+  void write_batch( const RecordingDevice& device, const RecordBatch& batch ) override;
+
   void set_status( const DictionaryDatum& ) override;
 
   void get_status( DictionaryDatum& ) const override;
@@ -333,6 +335,18 @@ private:
   };
 
   typedef std::vector< std::map< index, DeviceEntry > > device_map;
+
+  //! Append one record of the device to the buffer of the file or write it to the file directly
+  void write_record_( FileEntry& file,
+    DeviceInfo& device_info,
+    sion_uint64 device_node_id,
+    sion_uint64 sender_node_id,
+    sion_int64 step,
+    double offset,
+    const double* double_values,
+    sion_uint32 double_n_values,
+    const long* long_values,
+    sion_uint32 long_n_values );
   device_map devices_;
 
   typedef std::map< thread, FileEntry > file_map;
@@ -0,0 +1,452 @@
+/*
+ *  recording_backend_spike_archive.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// C++ includes:
+#include <algorithm>
+
+// Includes from libnestutil:
+#include "compose.hpp"
+
+// Includes from nestkernel:
+#include "recording_device.h"
+#include "vp_manager_impl.h"
+
+// includes from sli:
+#include "dictutils.h"
+
+#include "recording_backend_spike_archive.h"
+
+const unsigned int nest::RecordingBackendSpikeArchive::SPIKE_ARCHIVE_REC_BACKEND_VERSION = 1;
+
+namespace
+{
+
+template < typename T >
+void
+write_value_( std::ofstream& file, const T value )
+{
+  static_assert( sizeof( T ) == 8, "Spike archives only contain 64 bit values." );
+  file.write( reinterpret_cast< const char* >( &value ), sizeof( value ) );
+}
+
+} // namespace
+
+nest::RecordingBackendSpikeArchive::RecordingBackendSpikeArchive()
+  : chunk_size_( 65536 )
+  , files_open_( false )
+{
+}
+
+nest::RecordingBackendSpikeArchive::~RecordingBackendSpikeArchive() throw()
+{
+}
+
+void
+nest::RecordingBackendSpikeArchive::initialize()
+{
+  data_map tmp( kernel().vp_manager.get_num_threads() );
+  device_data_.swap( tmp );
+}
+
+void
+nest::RecordingBackendSpikeArchive::finalize()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendSpikeArchive::enroll( const RecordingDevice& device, const DictionaryDatum& params )
+{
+  if ( device.get_type() != RecordingDevice::SPIKE_RECORDER )
+  {
+    throw BadProperty( "Only spike recorders can record to recording backend 'spike_archive'." );
+  }
+
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    std::string vp_node_id_string = compute_vp_node_id_string_( device );
+    std::string modelname = device.get_name();
+    auto p = device_data_[ t ].insert( std::make_pair( node_id, DeviceData( modelname, vp_node_id_string ) ) );
+    device_data = p.first;
+  }
+
+  device_data->second.set_status( params );
+}
+
+void
+nest::RecordingBackendSpikeArchive::disenroll( const RecordingDevice& device )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data_[ t ].erase( device_data );
+  }
+}
+
+void
+nest::RecordingBackendSpikeArchive::set_value_names( const RecordingDevice&,
+  const std::vector< Name >&,
+  const std::vector< Name >& )
+{
+  // nothing to do, spike recorders do not record any additional values
+}
+
+void
+nest::RecordingBackendSpikeArchive::pre_run_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendSpikeArchive::post_run_hook()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.write_chunk();
+      device_data.second.flush_file();
+    }
+  }
+}
+
+void
+nest::RecordingBackendSpikeArchive::post_step_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendSpikeArchive::cleanup()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.write_chunk();
+      device_data.second.write_index();
+      device_data.second.close_file();
+    }
+  }
+  files_open_ = false;
+}
+
+void
+nest::RecordingBackendSpikeArchive::write( const RecordingDevice& device,
+  const Event& event,
+  const std::vector< double >&,
+  const std::vector< long >& )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( event );
+}
+
+const std::string
+nest::RecordingBackendSpikeArchive::compute_vp_node_id_string_( const RecordingDevice& device ) const
+{
+  const float num_vps = kernel().vp_manager.get_num_virtual_processes();
+  const float num_nodes = kernel().node_manager.size();
+  const int vp_digits = static_cast< int >( std::floor( std::log10( num_vps ) ) + 1 );
+  const int node_id_digits = static_cast< int >( std::floor( std::log10( num_nodes ) ) + 1 );
+
+  std::ostringstream vp_node_id_string;
+  vp_node_id_string << "-" << std::setfill( '0' ) << std::setw( node_id_digits ) << device.get_node_id() << "-"
+                    << std::setfill( '0' ) << std::setw( vp_digits ) << device.get_vp();
+
+  return vp_node_id_string.str();
+}
+
+void
+nest::RecordingBackendSpikeArchive::prepare()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_info : inner )
+    {
+      device_info.second.open_file( chunk_size_ );
+    }
+  }
+  files_open_ = true;
+}
+
+void
+nest::RecordingBackendSpikeArchive::set_status( const DictionaryDatum& d )
+{
+  long chunk_size = chunk_size_;
+  if ( updateValue< long >( d, names::chunk_size, chunk_size ) )
+  {
+    if ( files_open_ )
+    {
+      throw BadProperty( "Property chunk_size cannot be set while files are open." );
+    }
+    if ( chunk_size < 1 )
+    {
+      throw BadProperty( "Property chunk_size must be positive." );
+    }
+    chunk_size_ = chunk_size;
+  }
+}
+
+void
+nest::RecordingBackendSpikeArchive::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::chunk_size ] = chunk_size_;
+}
+
+void
+nest::RecordingBackendSpikeArchive::check_device_status( const DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.set_status( params ); // throws if params contains invalid entries
+}
+
+void
+nest::RecordingBackendSpikeArchive::get_device_defaults( DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.get_status( params );
+}
+
+void
+nest::RecordingBackendSpikeArchive::get_device_status( const nest::RecordingDevice& device, DictionaryDatum& d ) const
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::const_iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data->second.get_status( d );
+  }
+}
+
+/* ******************* Spike ******************* */
+
+bool
+nest::RecordingBackendSpikeArchive::Spike::operator<( const Spike& other ) const
+{
+  return sender_ < other.sender_ or ( sender_ == other.sender_ and time_ < other.time_ );
+}
+
+/* ******************* Device meta data class DeviceData ******************* */
+
+nest::RecordingBackendSpikeArchive::DeviceData::DeviceData( std::string modelname, std::string vp_node_id_string )
+  : chunk_size_( 0 )
+  , n_spikes_( 0 )
+  , modelname_( modelname )
+  , vp_node_id_string_( vp_node_id_string )
+  , file_extension_( "spa" )
+  , label_( "" )
+{
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::flush_file()
+{
+  file_.flush();
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::open_file( size_t chunk_size )
+{
+  std::string filename = compute_filename_();
+
+  std::ifstream test( filename.c_str() );
+  if ( test.good() && not kernel().io_manager.overwrite_files() )
+  {
+    std::string msg = String::compose(
+      "The file '%1' already exists and overwriting files is disabled. To overwrite files, set "
+      "the kernel property overwrite_files to true. To change the name or location of the file, "
+      "change the kernel properties data_path or data_prefix, or the device property label.",
+      filename );
+    LOG( M_ERROR, "RecordingBackendSpikeArchive::prepare()", msg );
+    throw IOError();
+  }
+  test.close();
+
+  file_ = std::ofstream( filename.c_str(), std::ios::binary );
+
+  if ( not file_.good() )
+  {
+    std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+    LOG( M_ERROR, "RecordingBackendSpikeArchive::prepare()", msg );
+    throw IOError();
+  }
+
+  chunk_size_ = chunk_size;
+  spikes_.clear();
+  spikes_.reserve( chunk_size_ );
+  index_.clear();
+  n_spikes_ = 0;
+
+  write_header_( 0 );
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::write_header_( uint64_t index_position )
+{
+  file_.write( "NESTSPA", 8 ); // includes the terminating null byte
+  const uint32_t bom_and_version[ 2 ] = { 0x01020304, SPIKE_ARCHIVE_REC_BACKEND_VERSION };
+  file_.write( reinterpret_cast< const char* >( bom_and_version ), sizeof( bom_and_version ) );
+  write_value_< uint64_t >( file_, index_position );
+  write_value_< uint64_t >( file_, index_.size() );
+  write_value_< uint64_t >( file_, n_spikes_ );
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::write_chunk()
+{
+  if ( spikes_.empty() )
+  {
+    return;
+  }
+
+  // sorting by sender allows to find the spikes of a sender by binary search
+  std::sort( spikes_.begin(), spikes_.end() );
+
+  ChunkInfo info;
+  info.n_spikes_ = spikes_.size();
+  info.t_min_ = spikes_[ 0 ].time_;
+  info.t_max_ = spikes_[ 0 ].time_;
+  info.sender_min_ = spikes_.front().sender_;
+  info.sender_max_ = spikes_.back().sender_;
+  for ( const Spike& spike : spikes_ )
+  {
+    info.t_min_ = std::min( info.t_min_, spike.time_ );
+    info.t_max_ = std::max( info.t_max_, spike.time_ );
+  }
+
+  index_.push_back( std::make_pair( static_cast< uint64_t >( file_.tellp() ), info ) );
+
+  write_value_< uint64_t >( file_, info.n_spikes_ );
+  write_value_< double >( file_, info.t_min_ );
+  write_value_< double >( file_, info.t_max_ );
+  write_value_< int64_t >( file_, info.sender_min_ );
+  write_value_< int64_t >( file_, info.sender_max_ );
+  for ( const Spike& spike : spikes_ )
+  {
+    write_value_< int64_t >( file_, spike.sender_ );
+  }
+  for ( const Spike& spike : spikes_ )
+  {
+    write_value_< double >( file_, spike.time_ );
+  }
+
+  n_spikes_ += spikes_.size();
+  spikes_.clear();
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::write_index()
+{
+  if ( not file_.is_open() )
+  {
+    return;
+  }
+
+  const uint64_t index_position = file_.tellp();
+  for ( const auto& entry : index_ )
+  {
+    write_value_< uint64_t >( file_, entry.first );
+    write_value_< uint64_t >( file_, entry.second.n_spikes_ );
+    write_value_< double >( file_, entry.second.t_min_ );
+    write_value_< double >( file_, entry.second.t_max_ );
+    write_value_< int64_t >( file_, entry.second.sender_min_ );
+    write_value_< int64_t >( file_, entry.second.sender_max_ );
+  }
+
+  // the header is only complete once the index is written
+  file_.seekp( 0 );
+  write_header_( index_position );
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::close_file()
+{
+  file_.close();
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::write( const Event& event )
+{
+  Spike spike;
+  spike.sender_ = event.get_sender_node_id();
+  spike.time_ = event.get_stamp().get_ms() - event.get_offset();
+  spikes_.push_back( spike );
+
+  if ( spikes_.size() == chunk_size_ )
+  {
+    write_chunk();
+  }
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::file_extension ] = file_extension_;
+
+  std::string filename = compute_filename_();
+  initialize_property_array( d, names::filenames );
+  append_property( d, names::filenames, filename );
+}
+
+void
+nest::RecordingBackendSpikeArchive::DeviceData::set_status( const DictionaryDatum& d )
+{
+  updateValue< std::string >( d, names::file_extension, file_extension_ );
+  updateValue< std::string >( d, names::label, label_ );
+}
+
+std::string
+nest::RecordingBackendSpikeArchive::DeviceData::compute_filename_() const
+{
+  std::string data_path = kernel().io_manager.get_data_path();
+  if ( not data_path.empty() and not( data_path[ data_path.size() - 1 ] == '/' ) )
+  {
+    data_path += '/';
+  }
+
+  std::string label = label_;
+  if ( label.empty() )
+  {
+    label = modelname_;
+  }
+
+  std::string data_prefix = kernel().io_manager.get_data_prefix();
+
+  return data_path + data_prefix + label + vp_node_id_string_ + "." + file_extension_;
+}
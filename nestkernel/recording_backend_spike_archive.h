@@ -0,0 +1,237 @@
+/*
+ *  recording_backend_spike_archive.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECORDING_BACKEND_SPIKE_ARCHIVE_H
+#define RECORDING_BACKEND_SPIKE_ARCHIVE_H
+
+// C++ includes:
+#include <cstdint>
+#include <fstream>
+
+#include "recording_backend.h"
+
+/* BeginUserDocs: recording backend
+
+.. _recording_backend_spike_archive:
+
+Write spikes to indexed archive files
+#####################################
+
+The `spike_archive` recording backend writes spikes into binary files
+that are laid out for fast queries of the form "all spikes of the
+senders S between times t0 and t1". It can only be used with spike
+recorders.
+
+Recorded spikes are collected in chunks of ``chunk_size`` spikes. Each
+chunk is sorted by sender and, for each sender, by time before it is
+written. The file ends with an index that lists the time range and the
+sender range of each chunk. A query therefore only needs to look at the
+chunks whose ranges overlap the query and can find the spikes of a
+given sender within a chunk by binary search. As spikes are recorded
+in the order of simulation time, chunks cover consecutive time ranges.
+
+All data in the files is aligned to 8 bytes, so the files can be mapped
+into memory and the data of the chunks can be accessed without copying.
+The function ``nest.OpenSpikeArchive()`` opens one or more files in
+this way and allows to query them.
+
+Like the `ascii` backend, this backend opens one file per recording
+device per thread on each MPI process. Filenames are determined
+according to the following pattern:
+
+::
+
+   data_path/data_prefix(label|model_name)-node_id-vp.file_extension
+
+The life of a file starts with the call to ``Prepare`` and ends with
+the call to ``Cleanup``. The call to ``Run`` writes all collected
+spikes as a chunk and flushes the file, so the data is available for
+immediate inspection. The index is written by ``Cleanup``; until then,
+readers find the chunks by scanning the file. As for the `ascii`
+backend, existing files are only overwritten if the kernel property
+``overwrite_files`` is set to *true*.
+
+Data format
++++++++++++
+
+All values are 64 bit wide and written in the byte order of the
+machine that ran the simulation. A file starts with a header of five
+values:
+
+* the magic string ``NESTSPA`` followed by a null byte,
+* a 32 bit unsigned integer with value ``0x01020304``, from which the
+  byte order can be determined, followed by the version of the file
+  format as 32 bit unsigned integer,
+* the position of the index in the file as unsigned integer, or 0
+  if the index has not been written yet,
+* the number of chunks as unsigned integer, and
+* the number of spikes as unsigned integer.
+
+Each chunk starts with the number of spikes *n* as unsigned integer,
+the smallest and largest spike time as floating point numbers in ms
+and the smallest and largest sender as signed integers. This is
+followed by the *n* senders as signed integers and the *n* times as
+floating point numbers in ms. The index consists of one entry per chunk
+with the position of the chunk in the file followed by the five values
+of the chunk header.
+
+Parameter summary
++++++++++++++++++
+
+.. glossary::
+
+ chunk_size
+   The number of spikes per chunk (default: *65536*). This is a global
+   property of the backend, which is set via the kernel property
+   ``recording_backends``. It cannot be changed while files are open.
+
+ file_extension
+   A string (default: *"spa"*) that specifies the file name extension,
+   without leading dot.
+
+ filenames
+   A list of the filenames where data is recorded to. This list has one
+   entry per local thread and is a read-only property.
+
+ label
+   A string (default: *""*) that replaces the model name component in
+   the filename if it is set.
+
+EndUserDocs */
+
+namespace nest
+{
+
+/**
+ * Spike archive specialization of the RecordingBackend interface.
+ *
+ * RecordingBackendSpikeArchive keeps one file and one chunk buffer for
+ * every spike recorder instance on every thread. Each spike recorder
+ * only ever writes into its own DeviceData, so no synchronization
+ * between threads is needed. Full chunks are sorted and written right
+ * away, the index of all chunks is kept in memory and appended to the
+ * file in cleanup().
+ */
+class RecordingBackendSpikeArchive : public RecordingBackend
+{
+public:
+  const static unsigned int SPIKE_ARCHIVE_REC_BACKEND_VERSION;
+
+  RecordingBackendSpikeArchive();
+
+  ~RecordingBackendSpikeArchive() throw();
+
+  void initialize() override;
+
+  void finalize() override;
+
+  void enroll( const RecordingDevice& device, const DictionaryDatum& params ) override;
+
+  void disenroll( const RecordingDevice& device ) override;
+
+  void set_value_names( const RecordingDevice& device,
+    const std::vector< Name >& double_value_names,
+    const std::vector< Name >& long_value_names ) override;
+
+  void prepare() override;
+
+  /**
+   * Write the index and close files
+   */
+  void cleanup() override;
+
+  void pre_run_hook() override;
+
+  /**
+   * Write remaining spikes as chunk and flush files
+   */
+  void post_run_hook() override;
+
+  void post_step_hook() override;
+
+  void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
+
+  void set_status( const DictionaryDatum& ) override;
+  void get_status( DictionaryDatum& ) const override;
+
+  void check_device_status( const DictionaryDatum& ) const override;
+  void get_device_defaults( DictionaryDatum& ) const override;
+  void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
+
+private:
+  const std::string compute_vp_node_id_string_( const RecordingDevice& device ) const;
+
+  struct Spike
+  {
+    long sender_;
+    double time_;
+
+    bool operator<( const Spike& other ) const;
+  };
+
+  //! Header of a chunk, written before the chunk and repeated in the index
+  struct ChunkInfo
+  {
+    uint64_t n_spikes_;
+    double t_min_;
+    double t_max_;
+    int64_t sender_min_;
+    int64_t sender_max_;
+  };
+
+  struct DeviceData
+  {
+    DeviceData() = delete;
+    DeviceData( std::string, std::string );
+    void open_file( size_t chunk_size );
+    void write( const Event& );
+    void write_chunk();
+    void write_index();
+    void flush_file();
+    void close_file();
+    void get_status( DictionaryDatum& ) const;
+    void set_status( const DictionaryDatum& );
+
+    std::vector< Spike > spikes_; //!< Spikes of the current chunk
+    size_t chunk_size_;           //!< Number of spikes per chunk
+    std::vector< std::pair< uint64_t, ChunkInfo > > index_; //!< Position and header of all chunks
+    uint64_t n_spikes_;                                     //!< Number of spikes written
+    std::ofstream file_;                                    //!< File stream to use for the device
+    std::string modelname_;                                 //!< File name up to but not including the "."
+    std::string vp_node_id_string_; //!< The vp and node ID component of the filename
+    std::string file_extension_;    //!< File name extension without leading "."
+    std::string label_;             //!< The label of the device.
+
+    std::string compute_filename_() const; //!< Compose and return the filename
+    void write_header_( uint64_t index_position );
+  };
+
+  typedef std::vector< std::map< size_t, DeviceData > > data_map;
+  data_map device_data_;
+
+  size_t chunk_size_; //!< Number of spikes per chunk
+  bool files_open_;
+};
+
+} // namespace
+
+#endif // RECORDING_BACKEND_SPIKE_ARCHIVE_H
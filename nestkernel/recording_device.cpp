@@ -126,7 +126,18 @@ nest::RecordingDevice::set_status( const DictionaryDatum& d )
 {
   if ( kernel().simulation_manager.has_been_prepared() )
   {
-    throw BadProperty( "Recorder parameters cannot be changed while inside a Prepare/Run/Cleanup context." );
+    // Clearing the recorded events is allowed between calls to Run to
+    // allow reading the data of long simulations piecewise.
+    if ( d->size() != 1 or not d->known( names::n_events ) or get_node_id() == 0 )
+    {
+      throw BadProperty( "Recorder parameters cannot be changed while inside a Prepare/Run/Cleanup context." );
+    }
+
+    State_ stmp = S_;
+    stmp.set( d ); // throws if BadProperty
+    kernel().io_manager.enroll_recorder( P_.record_to_, *this, d );
+    S_ = stmp;
+    return;
   }
 
   Parameters_ ptmp = P_; // temporary copy in case of errors
@@ -200,6 +211,17 @@ nest::RecordingDevice::get_status( DictionaryDatum& d ) const
   }
 }
 
+size_t
+nest::RecordingDevice::get_expected_events( Time const&, Time const& ) const
+{
+  return 0;
+}
+
+void
+nest::RecordingDevice::record_emitted_spikes( const std::vector< EmittedSpike >& )
+{
+}
+
 bool
 nest::RecordingDevice::is_active( Time const& T ) const
 {
@@ -216,3 +238,10 @@ nest::RecordingDevice::write( const Event& event,
   kernel().io_manager.write( P_.record_to_, *this, event, double_values, long_values );
   S_.n_events_++;
 }
+
+void
+nest::RecordingDevice::write_batch( const RecordBatch& batch )
+{
+  kernel().io_manager.write_batch( P_.record_to_, *this, batch );
+  S_.n_events_ += batch.size_;
+}
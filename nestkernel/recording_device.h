@@ -33,6 +33,7 @@
 #include "device_node.h"
 #include "recording_backend.h"
 #include "nest_types.h"
+#include "spike_data.h"
 #include "kernel_manager.h"
 
 // Includes from sli:
@@ -94,6 +95,26 @@ public:
 
   virtual Type get_type() const = 0;
 
+  /**
+   * Return the number of events the device expects to record in the
+   * time interval (from, to].
+   *
+   * Recording backends use this to reserve memory before a call to
+   * Run. The default implementation returns 0 for devices that cannot
+   * know the number of events in advance.
+   */
+  virtual size_t get_expected_events( Time const& from, Time const& to ) const;
+
+  /**
+   * Record spikes emitted by nodes the device is not connected to.
+   *
+   * EventDeliveryManager calls this at the end of each slice with all
+   * spikes emitted by the nodes on the thread of the device, if the
+   * device has registered with register_spike_recorder(). The default
+   * implementation ignores the spikes.
+   */
+  virtual void record_emitted_spikes( const std::vector< EmittedSpike >& );
+
   const std::string& get_label() const;
 
   void set_status( const DictionaryDatum& ) override;
@@ -101,6 +122,7 @@ public:
 
 protected:
   void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+  void write_batch( const RecordBatch& );
   void set_initialized_() override;
 
 private:
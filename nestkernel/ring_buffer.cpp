@@ -46,6 +46,92 @@ nest::RingBuffer::clear()
 }
 
 
+nest::CompactRingBuffer::CompactRingBuffer()
+  : buffer_()
+  , entries_()
+  , sparse_( kernel().event_delivery_manager.get_sparse_input_buffers() )
+{
+  resize();
+}
+
+void
+nest::CompactRingBuffer::resize()
+{
+  if ( sparse_ )
+  {
+    return;
+  }
+
+  size_t size = kernel().connection_manager.get_min_delay() + kernel().connection_manager.get_max_delay();
+  if ( buffer_.size() != size )
+  {
+    buffer_.resize( size );
+  }
+}
+
+size_t
+nest::CompactRingBuffer::dense_memory()
+{
+  return ( kernel().connection_manager.get_min_delay() + kernel().connection_manager.get_max_delay() )
+    * sizeof( double );
+}
+
+void
+nest::CompactRingBuffer::clear()
+{
+  sparse_ = kernel().event_delivery_manager.get_sparse_input_buffers();
+  if ( sparse_ )
+  {
+    std::vector< double >().swap( buffer_ );
+    std::vector< Entry_ >().swap( entries_ );
+    return;
+  }
+
+  std::vector< Entry_ >().swap( entries_ );
+  resize(); // does nothing if size is fine
+  // clear all elements
+  buffer_.assign( buffer_.size(), 0.0 );
+}
+
+
+nest::MultiPortRingBuffer::MultiPortRingBuffer()
+  : buffer_()
+  , n_ports_( 0 )
+{
+}
+
+void
+nest::MultiPortRingBuffer::resize( const size_t n_ports )
+{
+  const size_t n_slots = kernel().connection_manager.get_min_delay() + kernel().connection_manager.get_max_delay();
+  if ( n_ports == n_ports_ and buffer_.size() == n_slots * n_ports )
+  {
+    return;
+  }
+
+  // copy values slot by slot, since the stride changes with the number of ports
+  std::vector< double > new_buffer( n_slots * n_ports, 0.0 );
+  const size_t n_old_slots = n_ports_ > 0 ? buffer_.size() / n_ports_ : 0;
+  const size_t n_common_ports = std::min( n_ports, n_ports_ );
+  for ( size_t slot = 0; slot < std::min( n_slots, n_old_slots ); ++slot )
+  {
+    std::copy( buffer_.begin() + slot * n_ports_,
+      buffer_.begin() + slot * n_ports_ + n_common_ports,
+      new_buffer.begin() + slot * n_ports );
+  }
+
+  buffer_.swap( new_buffer );
+  n_ports_ = n_ports;
+}
+
+void
+nest::MultiPortRingBuffer::clear()
+{
+  resize( n_ports_ ); // does nothing if size is fine
+  // clear all elements
+  buffer_.assign( buffer_.size(), 0.0 );
+}
+
 nest::MultRBuffer::MultRBuffer()
   : buffer_( kernel().connection_manager.get_min_delay() + kernel().connection_manager.get_max_delay(), 0.0 )
 {
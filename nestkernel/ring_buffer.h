@@ -24,7 +24,9 @@
 #define RING_BUFFER_H
 
 // C++ includes:
+#include <algorithm>
 #include <list>
+#include <utility>
 #include <vector>
 
 // Includes from nestkernel:
@@ -195,6 +197,393 @@ RingBuffer::get_index_( const delay d ) const
 }
 
 
+/**
+ * Input buffer that can hold its entries either densely or sparsely.
+ *
+ * In dense mode, the buffer behaves exactly like RingBuffer and keeps
+ * min_delay + max_delay slots. In sparse mode, which is selected by the
+ * kernel attribute sparse_input_buffers, only slots that actually received
+ * input are stored as (step, value) pairs, ordered by decreasing delivery
+ * step, so that the entry due next is always at the back of the list.
+ *
+ * Sparse mode pays off for neurons that receive little input in networks
+ * with long maximal delays, since an idle neuron then needs no buffer
+ * memory at all. For neurons receiving input in most time steps, dense mode
+ * is both smaller and faster.
+ *
+ * The layout is chosen by clear(), i.e., when the buffers of a node are
+ * initialized.
+ */
+class CompactRingBuffer
+{
+public:
+  CompactRingBuffer();
+
+  /**
+   * Add a value to the buffer.
+   * @param  offs     Arrival time relative to beginning of slice.
+   * @param  double Value to add.
+   */
+  void add_value( const long offs, const double );
+
+  /**
+   * Set a buffer entry to a given value.
+   * @param  offs     Arrival time relative to beginning of slice.
+   * @param  double Value to set.
+   */
+  void set_value( const long offs, const double );
+
+  /**
+   * Read one value from buffer.
+   * @param  offs  Offset of element to read within slice.
+   * @returns value
+   */
+  double get_value( const long offs );
+
+  /**
+   * Read one value from buffer without deleting it afterwards.
+   * @param  offs  Offset of element to read within slice.
+   * @returns value
+   */
+  double get_value_wfr_update( const long offs );
+
+  /**
+   * Initialize the buffer with noughts and select its layout.
+   * Also resizes the buffer if necessary.
+   */
+  void clear();
+
+  /**
+   * Resize the dense buffer according to min_delay and max_delay.
+   * @note resize() has no effect in sparse mode or if the buffer has the
+   * correct size.
+   */
+  void resize();
+
+  /**
+   * Returns true if entries are stored sparsely.
+   */
+  bool
+  is_sparse() const
+  {
+    return sparse_;
+  }
+
+  /**
+   * Returns number of stored entries, for memory measurement.
+   */
+  size_t
+  size() const
+  {
+    return sparse_ ? entries_.size() : buffer_.size();
+  }
+
+  /**
+   * Returns number of bytes allocated by the buffer, for memory measurement.
+   */
+  size_t
+  memory() const
+  {
+    return buffer_.capacity() * sizeof( double ) + entries_.capacity() * sizeof( Entry_ );
+  }
+
+  /**
+   * Returns number of bytes needed by a buffer in dense mode.
+   */
+  static size_t dense_memory();
+
+  /**
+   * Returns number of bytes needed per buffered time step in sparse mode.
+   */
+  static size_t
+  sparse_memory_per_entry()
+  {
+    return sizeof( Entry_ );
+  }
+
+private:
+  //! Sparse entry, holding absolute delivery step and value
+  typedef std::pair< long, double > Entry_;
+
+  //! Buffered data in dense mode
+  std::vector< double > buffer_;
+
+  //! Buffered data in sparse mode, ordered by decreasing step
+  std::vector< Entry_ > entries_;
+
+  //! True if the sparse layout is used
+  bool sparse_;
+
+  /**
+   * Obtain buffer index in dense mode.
+   * @param delay delivery delay for event
+   * @returns index to buffer element into which event should be
+   * recorded.
+   */
+  size_t get_index_( const delay d ) const;
+
+  /**
+   * Convert offset relative to beginning of slice to absolute step.
+   */
+  long get_step_( const long offs ) const;
+
+  /**
+   * Return iterator to the sparse entry for step, or to the position at
+   * which an entry for step has to be inserted.
+   */
+  std::vector< Entry_ >::iterator find_( const long step );
+
+  //! Ordering of sparse entries
+  static bool later_than_( const Entry_& lhs, const Entry_& rhs );
+
+  /**
+   * Discard sparse entries for steps before the given step.
+   */
+  void discard_before_( const long step );
+};
+
+inline void
+CompactRingBuffer::add_value( const long offs, const double v )
+{
+  if ( not sparse_ )
+  {
+    buffer_[ get_index_( offs ) ] += v;
+    return;
+  }
+
+  const long step = get_step_( offs );
+  std::vector< Entry_ >::iterator it = find_( step );
+  if ( it != entries_.end() and it->first == step )
+  {
+    it->second += v;
+  }
+  else
+  {
+    entries_.insert( it, Entry_( step, v ) );
+  }
+}
+
+inline void
+CompactRingBuffer::set_value( const long offs, const double v )
+{
+  if ( not sparse_ )
+  {
+    buffer_[ get_index_( offs ) ] = v;
+    return;
+  }
+
+  const long step = get_step_( offs );
+  std::vector< Entry_ >::iterator it = find_( step );
+  if ( it != entries_.end() and it->first == step )
+  {
+    it->second = v;
+  }
+  else
+  {
+    entries_.insert( it, Entry_( step, v ) );
+  }
+}
+
+inline double
+CompactRingBuffer::get_value( const long offs )
+{
+  assert( 0 <= offs );
+  assert( ( delay ) offs < kernel().connection_manager.get_min_delay() );
+
+  if ( not sparse_ )
+  {
+    // offs == 0 is beginning of slice, but we have to
+    // take modulo into account when indexing
+    const long idx = get_index_( offs );
+    const double val = buffer_[ idx ];
+    buffer_[ idx ] = 0.0; // clear buffer after reading
+    return val;
+  }
+
+  const long step = get_step_( offs );
+  discard_before_( step );
+  if ( entries_.empty() or entries_.back().first != step )
+  {
+    return 0.0;
+  }
+  const double val = entries_.back().second;
+  entries_.pop_back(); // clear buffer after reading
+  return val;
+}
+
+inline double
+CompactRingBuffer::get_value_wfr_update( const long offs )
+{
+  assert( 0 <= offs );
+  assert( ( delay ) offs < kernel().connection_manager.get_min_delay() );
+
+  if ( not sparse_ )
+  {
+    return buffer_[ get_index_( offs ) ];
+  }
+
+  const long step = get_step_( offs );
+  std::vector< Entry_ >::iterator it = find_( step );
+  return ( it != entries_.end() and it->first == step ) ? it->second : 0.0;
+}
+
+inline size_t
+CompactRingBuffer::get_index_( const delay d ) const
+{
+  const long idx = kernel().event_delivery_manager.get_modulo( d );
+  assert( 0 <= idx );
+  assert( ( size_t ) idx < buffer_.size() );
+  return idx;
+}
+
+inline long
+CompactRingBuffer::get_step_( const long offs ) const
+{
+  return kernel().simulation_manager.get_slice_origin().get_steps() + offs;
+}
+
+inline std::vector< CompactRingBuffer::Entry_ >::iterator
+CompactRingBuffer::find_( const long step )
+{
+  // entries are ordered by decreasing step
+  return std::lower_bound( entries_.begin(), entries_.end(), Entry_( step, 0.0 ), later_than_ );
+}
+
+inline bool
+CompactRingBuffer::later_than_( const Entry_& lhs, const Entry_& rhs )
+{
+  return lhs.first > rhs.first;
+}
+
+inline void
+CompactRingBuffer::discard_before_( const long step )
+{
+  while ( not entries_.empty() and entries_.back().first < step )
+  {
+    entries_.pop_back();
+  }
+}
+
+
+/**
+ * Ring buffer for neurons with a variable number of receptor ports.
+ *
+ * Values for all ports of one time slot are stored contiguously, so that
+ * get_values_all_ports() provides the input of all receptors for the current
+ * step with a single lookup. Ports are numbered from 0.
+ */
+class MultiPortRingBuffer
+{
+public:
+  MultiPortRingBuffer();
+
+  /**
+   * Add a value to the ring buffer.
+   * @param  offs     Arrival time relative to beginning of slice.
+   * @param  port     Receptor port, counted from 0.
+   * @param  double Value to add.
+   */
+  void add_value( const long offs, const size_t port, const double );
+
+  /**
+   * Read values for all ports from ring buffer.
+   * The values must be cleared with reset_values_all_ports() after reading.
+   * @param  offs  Offset of element to read within slice.
+   * @returns pointer to get_num_ports() contiguous values
+   */
+  const double* get_values_all_ports( const long offs ) const;
+
+  /**
+   * Set values for all ports of one slot to zero.
+   * @param  offs  Offset of element to clear within slice.
+   */
+  void reset_values_all_ports( const long offs );
+
+  /**
+   * Initialize the buffer with noughts.
+   * Also resizes the buffer if necessary.
+   */
+  void clear();
+
+  /**
+   * Resize the buffer according to min_delay, max_delay and the number of
+   * ports. Values for ports that exist before and after resizing are kept.
+   * @note resize() has no effect if the buffer has the correct size.
+   */
+  void resize( const size_t n_ports );
+
+  /**
+   * Returns number of ports.
+   */
+  size_t
+  get_num_ports() const
+  {
+    return n_ports_;
+  }
+
+  /**
+   * Returns buffer size, for memory measurement.
+   */
+  size_t
+  size() const
+  {
+    return buffer_.size();
+  }
+
+private:
+  //! Buffered data, n_ports_ values per time slot
+  std::vector< double > buffer_;
+
+  //! Number of ports
+  size_t n_ports_;
+
+  /**
+   * Obtain buffer index of first port of a time slot.
+   * @param delay delivery delay for event
+   * @returns index to buffer element into which event should be
+   * recorded.
+   */
+  size_t get_index_( const delay d ) const;
+};
+
+inline void
+MultiPortRingBuffer::add_value( const long offs, const size_t port, const double v )
+{
+  assert( port < n_ports_ );
+  buffer_[ get_index_( offs ) + port ] += v;
+}
+
+inline const double*
+MultiPortRingBuffer::get_values_all_ports( const long offs ) const
+{
+  assert( 0 <= offs );
+  assert( ( delay ) offs < kernel().connection_manager.get_min_delay() );
+
+  // offs == 0 is beginning of slice, but we have to
+  // take modulo into account when indexing
+  return buffer_.data() + get_index_( offs );
+}
+
+inline void
+MultiPortRingBuffer::reset_values_all_ports( const long offs )
+{
+  assert( 0 <= offs );
+  assert( ( delay ) offs < kernel().connection_manager.get_min_delay() );
+
+  const size_t idx = get_index_( offs );
+  std::fill( buffer_.begin() + idx, buffer_.begin() + idx + n_ports_, 0.0 );
+}
+
+inline size_t
+MultiPortRingBuffer::get_index_( const delay d ) const
+{
+  const long idx = kernel().event_delivery_manager.get_modulo( d );
+  assert( 0 <= idx );
+  assert( ( size_t ) idx * n_ports_ < buffer_.size() or n_ports_ == 0 );
+  return idx * n_ports_;
+}
+
+
 class MultRBuffer
 {
 public:
@@ -536,7 +536,6 @@ nest::SimulationManager::run( Time const& t )
   assert_valid_simtime( t );
 
   kernel().random_manager.check_rng_synchrony();
-  kernel().io_manager.pre_run_hook();
 
   if ( not prepared_ )
   {
@@ -548,6 +547,9 @@ nest::SimulationManager::run( Time const& t )
   to_do_ += t.get_steps();
   to_do_total_ = to_do_;
 
+  // called after setting to_do_, so backends can size their buffers
+  kernel().io_manager.pre_run_hook();
+
   if ( to_do_ == 0 )
   {
     return;
@@ -591,6 +593,7 @@ nest::SimulationManager::run( Time const& t )
 
   call_update_();
 
+  kernel().node_manager.post_run_cleanup();
   kernel().io_manager.post_run_hook();
   kernel().random_manager.check_rng_synchrony();
 
@@ -688,6 +691,7 @@ nest::SimulationManager::update_connection_infrastructure( const thread tid )
 
   kernel().connection_manager.restructure_connection_tables( tid );
   kernel().connection_manager.sort_connections( tid );
+  kernel().connection_manager.register_postdriven_stdp( tid );
 
 #pragma omp barrier // wait for all threads to finish sorting
 
@@ -956,6 +960,17 @@ nest::SimulationManager::update_()
         }
       }
 
+      // record spikes of nodes on this thread for spike recorders that
+      // are not connected to them
+      try
+      {
+        kernel().event_delivery_manager.record_emitted_spikes( tid );
+      }
+      catch ( std::exception& e )
+      {
+        exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( e ) );
+      }
+
 // parallel section ends, wait until all threads are done -> synchronize
 #pragma omp barrier
 #ifdef TIMER_DETAILED
@@ -154,6 +154,11 @@ public:
   // TODO: rename / precisely how defined?
   delay get_to_step() const;
 
+  /**
+   * Return the number of steps left to simulate in the current call to Run.
+   */
+  delay get_to_do() const;
+
   //! Sorts source table and connections and create new target table.
   void update_connection_infrastructure( const thread tid );
 
@@ -261,6 +266,12 @@ SimulationManager::get_to_step() const
   return to_step_;
 }
 
+inline delay
+SimulationManager::get_to_do() const
+{
+  return to_do_;
+}
+
 inline bool
 SimulationManager::use_wfr() const
 {
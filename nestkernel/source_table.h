@@ -143,6 +143,11 @@ public:
    */
   void add_source( const thread tid, const synindex syn_id, const index node_id, const bool is_primary );
 
+  /**
+   * Makes room for count further sources of synapse type syn_id on thread tid.
+   */
+  void reserve( const thread tid, const synindex syn_id, const size_t count );
+
   /**
    * Clears sources_.
    */
@@ -278,6 +283,12 @@ SourceTable::add_source( const thread tid, const synindex syn_id, const index no
   sources_[ tid ][ syn_id ].push_back( src );
 }
 
+inline void
+SourceTable::reserve( const thread tid, const synindex syn_id, const size_t count )
+{
+  sources_[ tid ][ syn_id ].reserve( sources_[ tid ][ syn_id ].size() + count );
+}
+
 inline void
 SourceTable::clear( const thread tid )
 {
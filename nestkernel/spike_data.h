@@ -305,6 +305,30 @@ OffGridSpikeData::get_offset() const
   return offset_;
 }
 
+/**
+ * Spike emitted by a local node during the current slice.
+ *
+ * EventDeliveryManager collects these for spike recorders that record
+ * the spikes of nodes without being connected to them.
+ */
+struct EmittedSpike
+{
+  EmittedSpike( const index node_id, const long lag, const double offset, const int multiplicity );
+
+  index node_id_;    //!< node ID of the sender
+  long lag_;         //!< lag in the current slice
+  double offset_;    //!< offset of precise spikes
+  int multiplicity_; //!< number of spikes
+};
+
+inline EmittedSpike::EmittedSpike( const index node_id, const long lag, const double offset, const int multiplicity )
+  : node_id_( node_id )
+  , lag_( lag )
+  , offset_( offset )
+  , multiplicity_( multiplicity )
+{
+}
+
 } // namespace nest
 
 #endif /* SPIKE_DATA_H */
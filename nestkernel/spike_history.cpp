@@ -0,0 +1,55 @@
+/*
+ *  spike_history.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spike_history.h"
+
+// C++ includes:
+#include <algorithm>
+
+namespace nest
+{
+
+SpikeHistory::SpikeHistory()
+  : buffer_()
+  , head_( 0 )
+  , size_( 0 )
+  , back_access_counter_( 0 )
+{
+}
+
+void
+SpikeHistory::grow_()
+{
+  // capacity must remain a power of two
+  const size_t new_capacity = std::max( static_cast< size_t >( 8 ), 2 * buffer_.size() );
+
+  std::vector< histentry > new_buffer( new_capacity, histentry( 0.0, 0.0, 0.0, 0 ) );
+  for ( size_t pos = 0; pos < size_; ++pos )
+  {
+    new_buffer[ pos ] = entry_( pos );
+  }
+
+  buffer_.swap( new_buffer );
+  head_ = 0;
+}
+
+} // namespace nest
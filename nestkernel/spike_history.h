@@ -0,0 +1,403 @@
+/*
+ *  spike_history.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SPIKE_HISTORY_H
+#define SPIKE_HISTORY_H
+
+// C++ includes:
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Includes from nestkernel:
+#include "histentry.h"
+
+namespace nest
+{
+
+/**
+ * Spike history of a postsynaptic neuron, read by STDP synapses.
+ *
+ * Entries are kept in a circular buffer, whose capacity is a power of two
+ * and is doubled only if the buffer is full. Once the number of spikes that
+ * must be retained has settled, pushing and popping entries thus never
+ * allocates memory and all entries are stored contiguously up to one
+ * wrap-around.
+ *
+ * Entries are ordered by spike time, so that iterators, which are random
+ * access, can be used for binary searches by time, e.g., with
+ * std::partition_point().
+ *
+ * To keep track of which entries have been read by all incoming synapses,
+ * the access counters of the entries are stored as differences to the
+ * access counter of the preceding entry. Marking an arbitrary range of
+ * entries as read then costs constant time, and the access counter of the
+ * oldest entry, which is the only one needed for pruning, is its stored
+ * value.
+ */
+class SpikeHistory
+{
+public:
+  class iterator
+  {
+    friend class SpikeHistory;
+
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef histentry value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef histentry* pointer;
+    typedef histentry& reference;
+
+    iterator()
+      : history_( 0 )
+      , pos_( 0 )
+    {
+    }
+
+    reference operator*() const;
+    pointer operator->() const;
+    reference operator[]( const difference_type n ) const;
+
+    iterator& operator++();
+    iterator operator++( int );
+    iterator& operator--();
+    iterator operator--( int );
+    iterator& operator+=( const difference_type n );
+    iterator& operator-=( const difference_type n );
+    iterator operator+( const difference_type n ) const;
+    iterator operator-( const difference_type n ) const;
+    difference_type operator-( const iterator& rhs ) const;
+
+    bool operator==( const iterator& rhs ) const;
+    bool operator!=( const iterator& rhs ) const;
+    bool operator<( const iterator& rhs ) const;
+    bool operator>( const iterator& rhs ) const;
+    bool operator<=( const iterator& rhs ) const;
+    bool operator>=( const iterator& rhs ) const;
+
+  private:
+    iterator( SpikeHistory* history, const size_t pos )
+      : history_( history )
+      , pos_( pos )
+    {
+    }
+
+    SpikeHistory* history_;
+    size_t pos_; //!< logical position, 0 is oldest entry
+  };
+
+  SpikeHistory();
+
+  bool empty() const;
+  size_t size() const;
+
+  iterator begin();
+  iterator end();
+
+  histentry& operator[]( const size_t i );
+  histentry& front();
+  histentry& back();
+
+  /**
+   * Append a new spike, which must not be earlier than the last one.
+   * The new entry has not been read by any synapse.
+   */
+  void push_back( const double t, const double Kminus, const double Kminus_triplet );
+
+  /**
+   * Remove the oldest spike.
+   */
+  void pop_front();
+
+  /**
+   * Remove all spikes. The capacity is retained.
+   */
+  void clear();
+
+  /**
+   * Increment the access counter of all entries in [first, last).
+   */
+  void mark_read( const iterator& first, const iterator& last );
+
+  /**
+   * Return the access counter of the oldest entry.
+   */
+  size_t get_front_access_counter() const;
+
+  /**
+   * Return number of entries that fit into the buffer without reallocation.
+   */
+  size_t
+  capacity() const
+  {
+    return buffer_.size();
+  }
+
+private:
+  histentry& entry_( const size_t pos );
+
+  //! Double capacity, moving entries to the beginning of the new buffer
+  void grow_();
+
+  std::vector< histentry > buffer_;
+  size_t head_; //!< physical index of the oldest entry
+  size_t size_;
+
+  /**
+   * Access counter of the newest entry. New entries need this offset to
+   * start with an access counter of zero.
+   */
+  size_t back_access_counter_;
+};
+
+inline histentry&
+SpikeHistory::iterator::operator*() const
+{
+  return history_->entry_( pos_ );
+}
+
+inline histentry* SpikeHistory::iterator::operator->() const
+{
+  return &history_->entry_( pos_ );
+}
+
+inline histentry& SpikeHistory::iterator::operator[]( const difference_type n ) const
+{
+  return history_->entry_( pos_ + n );
+}
+
+inline SpikeHistory::iterator& SpikeHistory::iterator::operator++()
+{
+  ++pos_;
+  return *this;
+}
+
+inline SpikeHistory::iterator SpikeHistory::iterator::operator++( int )
+{
+  iterator old( *this );
+  ++pos_;
+  return old;
+}
+
+inline SpikeHistory::iterator& SpikeHistory::iterator::operator--()
+{
+  --pos_;
+  return *this;
+}
+
+inline SpikeHistory::iterator SpikeHistory::iterator::operator--( int )
+{
+  iterator old( *this );
+  --pos_;
+  return old;
+}
+
+inline SpikeHistory::iterator& SpikeHistory::iterator::operator+=( const difference_type n )
+{
+  pos_ += n;
+  return *this;
+}
+
+inline SpikeHistory::iterator& SpikeHistory::iterator::operator-=( const difference_type n )
+{
+  pos_ -= n;
+  return *this;
+}
+
+inline SpikeHistory::iterator SpikeHistory::iterator::operator+( const difference_type n ) const
+{
+  return iterator( history_, pos_ + n );
+}
+
+inline SpikeHistory::iterator SpikeHistory::iterator::operator-( const difference_type n ) const
+{
+  return iterator( history_, pos_ - n );
+}
+
+inline SpikeHistory::iterator::difference_type SpikeHistory::iterator::operator-( const iterator& rhs ) const
+{
+  return static_cast< difference_type >( pos_ ) - static_cast< difference_type >( rhs.pos_ );
+}
+
+inline bool
+SpikeHistory::iterator::operator==( const iterator& rhs ) const
+{
+  return pos_ == rhs.pos_;
+}
+
+inline bool
+SpikeHistory::iterator::operator!=( const iterator& rhs ) const
+{
+  return pos_ != rhs.pos_;
+}
+
+inline bool
+SpikeHistory::iterator::operator<( const iterator& rhs ) const
+{
+  return pos_ < rhs.pos_;
+}
+
+inline bool
+SpikeHistory::iterator::operator>( const iterator& rhs ) const
+{
+  return pos_ > rhs.pos_;
+}
+
+inline bool
+SpikeHistory::iterator::operator<=( const iterator& rhs ) const
+{
+  return pos_ <= rhs.pos_;
+}
+
+inline bool
+SpikeHistory::iterator::operator>=( const iterator& rhs ) const
+{
+  return pos_ >= rhs.pos_;
+}
+
+inline bool
+SpikeHistory::empty() const
+{
+  return size_ == 0;
+}
+
+inline size_t
+SpikeHistory::size() const
+{
+  return size_;
+}
+
+inline SpikeHistory::iterator
+SpikeHistory::begin()
+{
+  return iterator( this, 0 );
+}
+
+inline SpikeHistory::iterator
+SpikeHistory::end()
+{
+  return iterator( this, size_ );
+}
+
+inline histentry& SpikeHistory::operator[]( const size_t i )
+{
+  assert( i < size_ );
+  return entry_( i );
+}
+
+inline histentry&
+SpikeHistory::front()
+{
+  assert( not empty() );
+  return entry_( 0 );
+}
+
+inline histentry&
+SpikeHistory::back()
+{
+  assert( not empty() );
+  return entry_( size_ - 1 );
+}
+
+inline histentry&
+SpikeHistory::entry_( const size_t pos )
+{
+  // capacity is a power of two
+  return buffer_[ ( head_ + pos ) & ( buffer_.size() - 1 ) ];
+}
+
+inline void
+SpikeHistory::push_back( const double t, const double Kminus, const double Kminus_triplet )
+{
+  assert( empty() or back().t_ <= t );
+
+  if ( size_ == buffer_.size() )
+  {
+    grow_();
+  }
+
+  // the difference to the counter of the preceding entry is chosen such
+  // that the new entry starts with a counter of zero; unsigned arithmetic
+  // wraps around consistently
+  entry_( size_ ) = histentry( t, Kminus, Kminus_triplet, 0 - back_access_counter_ );
+  back_access_counter_ = 0;
+  ++size_;
+}
+
+inline void
+SpikeHistory::pop_front()
+{
+  assert( not empty() );
+
+  const size_t front_counter = entry_( 0 ).access_counter_;
+  head_ = ( head_ + 1 ) & ( buffer_.size() - 1 );
+  --size_;
+  if ( size_ > 0 )
+  {
+    // the new oldest entry stores its counter as absolute value
+    entry_( 0 ).access_counter_ += front_counter;
+  }
+  else
+  {
+    back_access_counter_ = 0;
+  }
+}
+
+inline void
+SpikeHistory::clear()
+{
+  head_ = 0;
+  size_ = 0;
+  back_access_counter_ = 0;
+}
+
+inline void
+SpikeHistory::mark_read( const iterator& first, const iterator& last )
+{
+  if ( not( first < last ) )
+  {
+    return;
+  }
+
+  ++first->access_counter_;
+  if ( last == end() )
+  {
+    ++back_access_counter_;
+  }
+  else
+  {
+    --last->access_counter_;
+  }
+}
+
+inline size_t
+SpikeHistory::get_front_access_counter() const
+{
+  assert( not empty() );
+  return buffer_[ head_ ].access_counter_;
+}
+
+} // namespace nest
+
+#endif /* #ifndef SPIKE_HISTORY_H */
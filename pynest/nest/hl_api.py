@@ -47,10 +47,14 @@ __all__ = [
     'Cleanup',
     'CollocatedSynapses',
     'Connect',
+    'ConnectPlan',
+    'ConnectionPlan',
     'ConnectionRules',
+    'ConsumeEvents',
     'SynapseCollection',
     'CopyModel',
     'Create',
+    'CreateConnectionPlan',
     'CreateMask',
     'CreateParameter',
     'DisableStructuralPlasticity',
@@ -62,6 +66,7 @@ __all__ = [
     'EnableStructuralPlasticity',
     'FindCenterElement',
     'FindNearestElement',
+    'GetConnectionArrays',
     'GetConnections',
     'GetDefaults',
     'GetKernelStatus',
@@ -77,6 +82,7 @@ __all__ = [
     'Mask',
     'Models',
     'NumProcesses',
+    'OpenSpikeArchive',
     'Parameter',
     'PlotLayer',
     'PlotProbabilityParameter',
@@ -84,6 +90,7 @@ __all__ = [
     'Prepare',
     'PrintNodes',
     'Rank',
+    'ReadBinaryRecording',
     'ResetKernel',
     'Run',
     'RunManager',
@@ -94,6 +101,7 @@ __all__ = [
     'SetMaxBuffered',
     'SetStatus',
     'Simulate',
+    'SpikeArchive',
     'authors',
     'get_verbosity',
     'help',
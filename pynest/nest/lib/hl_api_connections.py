@@ -36,15 +36,44 @@ from .hl_api_info import GetStatus
 from .hl_api_nodes import Create
 from .hl_api_parallel_computing import NumProcesses
 from .hl_api_simulation import GetKernelStatus, SetKernelStatus
-from .hl_api_types import NodeCollection, SynapseCollection, Mask, Parameter
+from .hl_api_types import NodeCollection, SynapseCollection, Mask, Parameter, ConnectionPlan
 
 __all__ = [
     'Connect',
+    'ConnectPlan',
+    'CreateConnectionPlan',
     'Disconnect',
+    'GetConnectionArrays',
     'GetConnections',
 ]
 
 
+def _get_connections_params(source, target, synapse_model, synapse_label):
+    """Return the parameter dictionary selecting connections for the kernel."""
+
+    params = {}
+
+    if source is not None:
+        if isinstance(source, NodeCollection):
+            params['source'] = source
+        else:
+            raise TypeError("source must be NodeCollection.")
+
+    if target is not None:
+        if isinstance(target, NodeCollection):
+            params['target'] = target
+        else:
+            raise TypeError("target must be NodeCollection.")
+
+    if synapse_model is not None:
+        params['synapse_model'] = kernel.SLILiteral(synapse_model)
+
+    if synapse_label is not None:
+        params['synapse_label'] = synapse_label
+
+    return params
+
+
 @check_stack
 def GetConnections(source=None, target=None, synapse_model=None,
                    synapse_label=None):
@@ -82,35 +111,76 @@ def GetConnections(source=None, target=None, synapse_model=None,
     the command are returned.
     """
 
-    params = {}
+    params = _get_connections_params(source, target, synapse_model, synapse_label)
 
-    if source is not None:
-        if isinstance(source, NodeCollection):
-            params['source'] = source
-        else:
-            raise TypeError("source must be NodeCollection.")
+    sps(params)
+    sr("GetConnectionArrays")
 
-    if target is not None:
-        if isinstance(target, NodeCollection):
-            params['target'] = target
-        else:
-            raise TypeError("target must be NodeCollection.")
+    conns = spp()
 
-    if synapse_model is not None:
-        params['synapse_model'] = kernel.SLILiteral(synapse_model)
+    if len(conns['source']) == 0:
+        return SynapseCollection(None)
 
-    if synapse_label is not None:
-        params['synapse_label'] = synapse_label
+    return SynapseCollection(conns)
 
-    sps(params)
-    sr("GetConnections")
 
-    conns = spp()
+@check_stack
+def GetConnectionArrays(source=None, target=None, synapse_model=None,
+                        synapse_label=None, keys=None, chunked=False):
+    """Return the connections as a dictionary of NumPy arrays.
 
-    if isinstance(conns, tuple):
-        conns = SynapseCollection(None)
+    The connections are selected as in :py:func:`.GetConnections`, but instead of a `SynapseCollection`, the
+    identifiers of the connections and the values of the parameters in `keys` are returned as one array each.
+    The arrays are filled in parallel by all threads and share their memory with the kernel.
 
-    return conns
+    Parameters
+    ----------
+    source : NodeCollection, optional
+        Source node IDs, only connections from these
+        pre-synaptic neurons are returned
+    target : NodeCollection, optional
+        Target node IDs, only connections to these
+        postsynaptic neurons are returned
+    synapse_model : str, optional
+        Only connections with this synapse type are returned
+    synapse_label : int, optional
+        (non-negative) only connections with this synapse label are returned
+    keys : list of str, optional
+        Names of numerical synapse parameters, e.g. `weight` and `delay`, to return in addition to the
+        identifiers. Connections without the parameter have the value NaN.
+    chunked : bool, optional
+        If True, return a generator yielding one dictionary for the connections stored on each thread, so that
+        only the arrays of one thread are kept in memory at a time.
+
+    Returns
+    -------
+    dict or generator:
+        Dictionary with the arrays `source`, `target`, `target_thread`, `synapse_id` and `port`, one array per
+        parameter in `keys`, and the names of all synapse models indexed by `synapse_id` in `synapse_models`
+
+    Raises
+    ------
+    TypeError
+
+    Notes
+    -----
+    Only connections with targets on the MPI process executing
+    the command are returned.
+    """
+
+    params = _get_connections_params(source, target, synapse_model, synapse_label)
+    if keys is not None:
+        params['keys'] = [keys] if is_literal(keys) else list(keys)
+
+    if not chunked:
+        return sli_func('GetConnectionArrays', params)
+
+    def chunks():
+        for thread in range(GetKernelStatus('local_num_threads')):
+            params['target_thread'] = thread
+            yield sli_func('GetConnectionArrays', params)
+
+    return chunks()
 
 
 @check_stack
@@ -288,6 +358,79 @@ def Connect(pre, post, conn_spec=None, syn_spec=None,
         return GetConnections(pre, post)
 
 
+@check_stack
+def CreateConnectionPlan(pre, post, conn_spec=None, syn_spec=None):
+    """
+    Connect `pre` nodes to `post` nodes and return the connections as a plan.
+
+    The connections are created as by :py:func:`.Connect`. In addition, they
+    are returned as a :py:class:`.ConnectionPlan`, which :py:func:`.ConnectPlan`
+    can create again without drawing them anew.
+
+    Parameters
+    ----------
+    pre : NodeCollection (or array-like object)
+        Presynaptic nodes, as object representing the IDs of the nodes
+    post : NodeCollection (or array-like object)
+        Postsynaptic nodes, as object representing the IDs of the nodes
+    conn_spec : str or dict, optional
+        Specifies connectivity rule, see :py:func:`.Connect`
+    syn_spec : str or dict, optional
+        Specifies synapse model, see :py:func:`.Connect`
+
+    Returns
+    -------
+    ConnectionPlan:
+        The connections created on the virtual processes of this MPI process
+
+    See Also
+    ---------
+    ConnectPlan
+    """
+
+    sr('StartConnectionPlan')
+    try:
+        Connect(pre, post, conn_spec, syn_spec)
+    finally:
+        sr('EndConnectionPlan')
+        plan = spp()
+
+    return ConnectionPlan(plan)
+
+
+@check_stack
+def ConnectPlan(plan):
+    """
+    Create the connections of a connection plan.
+
+    The connections are created directly, without evaluating connection rules,
+    masks or parameters. The numbers of MPI processes and virtual processes
+    must be the same as when the plan was created, and the nodes of the plan
+    must exist.
+
+    Parameters
+    ----------
+    plan : ConnectionPlan
+        Connections returned by :py:func:`.CreateConnectionPlan`
+
+    Raises
+    ------
+    kernel.NESTError
+        If the plan was created with a different number of MPI processes or
+        virtual processes
+
+    See Also
+    ---------
+    CreateConnectionPlan
+    """
+
+    if not isinstance(plan, ConnectionPlan):
+        raise TypeError("plan must be a ConnectionPlan")
+
+    sps(plan._plan)
+    sr('ConnectPlan')
+
+
 @check_stack
 def Disconnect(pre, post, conn_spec='one_to_one', syn_spec='static_synapse'):
     """Disconnect `pre` neurons from `post` neurons.
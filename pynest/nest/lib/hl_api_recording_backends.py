@@ -0,0 +1,383 @@
+# -*- coding: utf-8 -*-
+#
+# hl_api_recording_backends.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Functions for reading data written by recording backends
+"""
+
+import numpy
+
+from .hl_api_helper import is_iterable
+from .hl_api_types import NodeCollection
+
+__all__ = [
+    'ConsumeEvents',
+    'OpenSpikeArchive',
+    'ReadBinaryRecording',
+    'SpikeArchive',
+]
+
+_BINARY_MAGIC = b'NESTBIN\x00'
+_BINARY_BOM = 0x01020304
+_BINARY_VERSION = 1
+
+_SPIKE_ARCHIVE_MAGIC = b'NESTSPA\x00'
+_SPIKE_ARCHIVE_VERSION = 1
+
+
+def ConsumeEvents(recorders):
+    """Return the events recorded in memory and discard them from memory.
+
+    This returns the events recorded by the memory backend since the
+    last call, so that the data of long simulations can be fetched
+    piecewise between calls to ``Run``. If a recorder only runs on a
+    single thread, the data is handed over without copying it.
+
+    The returned arrays share their memory with NEST and are therefore
+    read-only.
+
+    Parameters
+    ----------
+    recorders : NodeCollection
+        Recording devices that record to the memory backend
+
+    Returns
+    -------
+    dict or tuple of dicts:
+        The ``events`` dictionary of the recorder, or a tuple with one
+        ``events`` dictionary per recorder if more than one is given
+
+    Example
+    -------
+    ::
+
+        sr = nest.Create('spike_recorder')
+        ...
+        with nest.RunManager():
+            for _ in range(100):
+                nest.Run(10.)
+                events = nest.ConsumeEvents(sr)
+    """
+
+    if not isinstance(recorders, NodeCollection):
+        raise TypeError("recorders must be a NodeCollection")
+
+    events = recorders.get('events')
+    recorders.set(n_events=0)
+
+    return events
+
+
+def _read_binary_file(filename):
+    """Read one file written by the binary recording backend.
+
+    Returns the label of the device and a dictionary of lists of NumPy
+    arrays, one array per column and block.
+    """
+
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != _BINARY_MAGIC:
+        raise ValueError("'{}' is not a file written by the binary recording backend.".format(filename))
+
+    # the byte order marker tells us how to interpret all further values
+    for byteorder in ('<', '>'):
+        if numpy.frombuffer(data, dtype=byteorder + 'u4', count=1, offset=8)[0] == _BINARY_BOM:
+            break
+    else:
+        raise ValueError("Invalid byte order marker in '{}'.".format(filename))
+
+    u4 = numpy.dtype(byteorder + 'u4')
+    u8 = numpy.dtype(byteorder + 'u8')
+    dtypes = {'l': numpy.dtype(byteorder + 'i8'), 'd': numpy.dtype(byteorder + 'f8')}
+
+    pos = 12
+
+    def read_uint(dtype):
+        nonlocal pos
+        value = int(numpy.frombuffer(data, dtype=dtype, count=1, offset=pos)[0])
+        pos += dtype.itemsize
+        return value
+
+    def read_string():
+        nonlocal pos
+        length = read_uint(u4)
+        s = data[pos:pos + length].decode('utf-8')
+        pos += length
+        return s
+
+    version = read_uint(u4)
+    if version != _BINARY_VERSION:
+        raise ValueError("Unsupported format version {} in '{}'.".format(version, filename))
+    read_string()  # NEST version
+    label = read_string()
+
+    columns = []
+    for _ in range(read_uint(u4)):
+        dtype = dtypes[chr(data[pos])]
+        pos += 1
+        columns.append((read_string(), dtype))
+
+    blocks = {name: [] for name, _ in columns}
+    while pos < len(data):
+        n_records = read_uint(u8)
+        for name, dtype in columns:
+            blocks[name].append(numpy.frombuffer(data, dtype=dtype, count=n_records, offset=pos))
+            pos += n_records * dtype.itemsize
+
+    empty = {name: numpy.empty(0, dtype=dtype) for name, dtype in columns}
+    return label, blocks, empty
+
+
+def ReadBinaryRecording(filenames):
+    """Read data written by the binary or mpiio recording backends.
+
+    The files of a recording device, which are given by its
+    ``filenames`` property, contain the data recorded on the different
+    threads. The mpiio backend writes the data of all threads and MPI
+    processes into a single file. If more than one file is given, their data are concatenated
+    in the order of `filenames`. All files must have the same columns.
+
+    Parameters
+    ----------
+    filenames : str or list of str
+        Name(s) of the file(s) to read
+
+    Returns
+    -------
+    dict:
+        Dictionary with one NumPy array for each column, using the same
+        keys as the ``events`` dictionary of the memory backend.
+
+    Raises
+    ------
+    ValueError
+        If a file was not written by the binary backend or the columns
+        of the files do not match.
+
+    Example
+    -------
+    ::
+
+        sr = nest.Create('spike_recorder', params={'record_to': 'binary'})
+        ...
+        nest.Simulate(100.)
+        events = nest.ReadBinaryRecording(sr.filenames)
+    """
+
+    if isinstance(filenames, str) or not is_iterable(filenames):
+        filenames = [filenames]
+
+    result = None
+    for filename in filenames:
+        _, blocks, empty = _read_binary_file(filename)
+        if result is None:
+            result = {name: [empty[name]] for name in blocks}
+        elif set(result) != set(blocks):
+            raise ValueError("The columns of '{}' differ from those of '{}'.".format(filename, filenames[0]))
+        for name, arrays in blocks.items():
+            result[name].extend(arrays)
+
+    if result is None:
+        return {}
+
+    return {name: numpy.concatenate(arrays) for name, arrays in result.items()}
+
+
+def _chunk_info_dtype(byteorder):
+    """Return the dtype of a chunk header in a spike archive."""
+
+    return numpy.dtype([('n_spikes', byteorder + 'u8'),
+                        ('t_min', byteorder + 'f8'),
+                        ('t_max', byteorder + 'f8'),
+                        ('sender_min', byteorder + 'i8'),
+                        ('sender_max', byteorder + 'i8')])
+
+
+class _SpikeArchiveChunk(object):
+    """One chunk of a spike archive file, mapped into memory."""
+
+    def __init__(self, mm, position, byteorder):
+        info_dtype = _chunk_info_dtype(byteorder)
+        info = numpy.frombuffer(mm, dtype=info_dtype, count=1, offset=position)[0]
+        n_spikes = int(info['n_spikes'])
+        position += info_dtype.itemsize
+
+        self.t_min = float(info['t_min'])
+        self.t_max = float(info['t_max'])
+        self.sender_min = int(info['sender_min'])
+        self.sender_max = int(info['sender_max'])
+        self.senders = numpy.frombuffer(mm, dtype=byteorder + 'i8', count=n_spikes, offset=position)
+        self.times = numpy.frombuffer(mm, dtype=byteorder + 'f8', count=n_spikes, offset=position + 8 * n_spikes)
+        self.end = position + 16 * n_spikes
+
+    def select(self, t_start, t_stop, senders):
+        """Return the indices of all spikes in [t_start, t_stop] of the given senders."""
+
+        if senders is None:
+            selected = numpy.arange(len(self.senders))
+        else:
+            # spikes are sorted by sender, so find each sender by binary search
+            begins = numpy.searchsorted(self.senders, senders, side='left')
+            ends = numpy.searchsorted(self.senders, senders, side='right')
+            selected = numpy.concatenate([numpy.arange(b, e) for b, e in zip(begins, ends)] +
+                                         [numpy.empty(0, dtype=int)])
+
+        if t_start is not None:
+            selected = selected[self.times[selected] >= t_start]
+        if t_stop is not None:
+            selected = selected[self.times[selected] <= t_stop]
+        return selected
+
+
+class SpikeArchive(object):
+    """Spikes written by the spike_archive recording backend.
+
+    The files are mapped into memory, and the ``senders`` and ``times``
+    of each chunk in `chunks` are NumPy arrays that refer to the mapped
+    data without copying it.
+
+    Use :py:func:`.OpenSpikeArchive` to create instances of this class.
+    """
+
+    def __init__(self, filenames):
+        if isinstance(filenames, str) or not is_iterable(filenames):
+            filenames = [filenames]
+
+        self.chunks = []
+        for filename in filenames:
+            self.chunks.extend(self._read_chunks(filename))
+
+    @staticmethod
+    def _read_chunks(filename):
+        mm = numpy.memmap(filename, dtype=numpy.uint8, mode='r')
+
+        if bytes(mm[:8]) != _SPIKE_ARCHIVE_MAGIC:
+            raise ValueError("'{}' is not a file written by the spike_archive recording backend.".format(filename))
+
+        # the byte order marker tells us how to interpret all further values
+        for byteorder in ('<', '>'):
+            if numpy.frombuffer(mm, dtype=byteorder + 'u4', count=1, offset=8)[0] == _BINARY_BOM:
+                break
+        else:
+            raise ValueError("Invalid byte order marker in '{}'.".format(filename))
+
+        version = numpy.frombuffer(mm, dtype=byteorder + 'u4', count=1, offset=12)[0]
+        if version != _SPIKE_ARCHIVE_VERSION:
+            raise ValueError("Unsupported format version {} in '{}'.".format(version, filename))
+
+        index_position, n_chunks, _ = (int(v) for v in numpy.frombuffer(mm, dtype=byteorder + 'u8', count=3, offset=16))
+
+        if index_position > 0:
+            positions = numpy.frombuffer(mm, dtype=byteorder + 'u8', count=n_chunks * 6, offset=index_position)[::6]
+            return [_SpikeArchiveChunk(mm, int(position), byteorder) for position in positions]
+
+        # the index is only written at the end of the simulation, until
+        # then, find the chunks by scanning the file
+        chunks = []
+        position = 40
+        while position < len(mm):
+            chunks.append(_SpikeArchiveChunk(mm, position, byteorder))
+            position = chunks[-1].end
+        return chunks
+
+    def get_spikes(self, t_start=None, t_stop=None, senders=None):
+        """Return all spikes of the given senders in a time interval.
+
+        Only chunks whose time and sender ranges overlap the query are
+        searched.
+
+        Parameters
+        ----------
+        t_start : float, optional
+            Earliest spike time in ms (inclusive), no limit if not given
+        t_stop : float, optional
+            Latest spike time in ms (inclusive), no limit if not given
+        senders : list or NodeCollection, optional
+            Node IDs of the senders, all senders if not given
+
+        Returns
+        -------
+        dict:
+            Dictionary with NumPy arrays ``senders`` and ``times``. The
+            spikes are ordered by chunk, and within each chunk by sender
+            and time.
+        """
+
+        if senders is not None:
+            if isinstance(senders, NodeCollection):
+                senders = senders.tolist()
+            senders = numpy.unique(numpy.asarray(senders, dtype=numpy.int64))
+
+        result_senders = [numpy.empty(0, dtype=numpy.int64)]
+        result_times = [numpy.empty(0, dtype=numpy.float64)]
+        for chunk in self.chunks:
+            if t_start is not None and chunk.t_max < t_start:
+                continue
+            if t_stop is not None and chunk.t_min > t_stop:
+                continue
+            if senders is not None and (len(senders) == 0 or senders[-1] < chunk.sender_min or
+                                        senders[0] > chunk.sender_max):
+                continue
+
+            selected = chunk.select(t_start, t_stop, senders)
+            result_senders.append(chunk.senders[selected])
+            result_times.append(chunk.times[selected])
+
+        return {'senders': numpy.concatenate(result_senders), 'times': numpy.concatenate(result_times)}
+
+
+def OpenSpikeArchive(filenames):
+    """Open files written by the spike_archive recording backend.
+
+    The files of a recording device, which are given by its
+    ``filenames`` property, contain the spikes recorded on the
+    different threads. The files are mapped into memory, so that only
+    the data needed by a query is read from disk.
+
+    Parameters
+    ----------
+    filenames : str or list of str
+        Name(s) of the file(s) to open
+
+    Returns
+    -------
+    SpikeArchive:
+        Object that provides the spikes of all files
+
+    Raises
+    ------
+    ValueError
+        If a file was not written by the spike_archive backend
+
+    Example
+    -------
+    ::
+
+        sr = nest.Create('spike_recorder', params={'record_to': 'spike_archive'})
+        ...
+        nest.Simulate(1000.)
+        archive = nest.OpenSpikeArchive(sr.filenames)
+        spikes = archive.get_spikes(t_start=200., t_stop=300., senders=neurons[:10])
+    """
+
+    return SpikeArchive(filenames)
@@ -252,6 +252,10 @@ def SetKernelStatus(params):
         The number of MPI processes
     off_grid_spiking : bool
         Whether to transmit precise spike times in MPI communication
+    sparse_input_buffers : bool
+        Whether input buffers of supporting neuron models (iaf_psc_delta,
+        parrot_neuron) only store time steps that received input; must be
+        set before the first call to Simulate or Prepare
 
 
     **MPI buffers**
@@ -40,6 +40,7 @@ except ImportError:
 
 __all__ = [
     'CollocatedSynapses',
+    'ConnectionPlan',
     'CreateParameter',
     'Mask',
     'NodeCollection',
@@ -538,13 +539,14 @@ class SynapseCollectionIterator(object):
     """
 
     def __init__(self, synapse_collection):
-        self._iter = iter(synapse_collection._datum)
+        self._synapse_collection = synapse_collection
+        self._iter = iter(range(len(synapse_collection)))
 
     def __iter__(self):
         return self
 
     def __next__(self):
-        return SynapseCollection(next(self._iter))
+        return self._synapse_collection[next(self._iter)]
 
 
 class SynapseCollection(object):
@@ -557,37 +559,60 @@ class SynapseCollection(object):
     source nodes, while :py:func:`targets()` returns an interator over the target nodes of the connections.
 
     A SynapseCollection is created by the :py:func:`.GetConnections` function.
+
+    The collections returned by :py:func:`.GetConnections` store the identifiers of the connections as NumPy arrays.
+    The connection datums needed by SLI are only created when they are first used, e.g., by :py:func:`set()`.
     """
 
-    _datum = None
+    # Identifiers of a connection, stored as one array each by collections created from columns
+    _ID_COLUMNS = ('source', 'target', 'target_thread', 'synapse_id', 'port')
+    # Parameters that get() reads from the arrays, or fetches for all connections at once
+    _COLUMN_KEYS = frozenset(_ID_COLUMNS + ('synapse_model', 'weight', 'delay'))
+
+    _datums = None
+    _columns = None
+    _synapse_models = None
 
     def __init__(self, data):
 
-        if isinstance(data, list):
+        if isinstance(data, dict):
+            # Columns of the connections as returned by GetConnectionArrays.
+            self._columns = {key: numpy.asarray(data[key]) for key in self._ID_COLUMNS}
+            self._synapse_models = tuple(data['synapse_models'])
+        elif isinstance(data, list):
             for datum in data:
                 if (not isinstance(datum, kernel.SLIDatum) or
                         datum.dtype != "connectiontype"):
                     raise TypeError("Expected Connection Datum.")
-            self._datum = data
+            self._datums = data
         elif data is None:
             # We can have an empty SynapseCollection if there are no connections.
-            self._datum = data
+            self._datums = data
         else:
             if (not isinstance(data, kernel.SLIDatum) or
                     data.dtype != "connectiontype"):
                 raise TypeError("Expected Connection Datum.")
-            # self._datum needs to be a list of Connection datums.
-            self._datum = [data]
+            # self._datums needs to be a list of Connection datums.
+            self._datums = [data]
 
         self.print_full = False
 
+    @property
+    def _datum(self):
+        """List of connection datums, created from the columns on first use."""
+        if self._datums is None and self._columns is not None:
+            self._datums = connection_datums(*(self._columns[key] for key in self._ID_COLUMNS))
+        return self._datums
+
     def __iter__(self):
         return SynapseCollectionIterator(self)
 
     def __len__(self):
-        if self._datum is None:
+        if self._columns is not None:
+            return len(self._columns['source'])
+        if self._datums is None:
             return 0
-        return len(self._datum)
+        return len(self._datums)
 
     def __eq__(self, other):
         if not isinstance(other, SynapseCollection):
@@ -609,6 +634,12 @@ class SynapseCollection(object):
         return not self == other
 
     def __getitem__(self, key):
+        if self._columns is not None:
+            if not isinstance(key, slice):
+                key = [key]
+            columns = {column: values[key] for column, values in self._columns.items()}
+            columns['synapse_models'] = self._synapse_models
+            return SynapseCollection(columns)
         if isinstance(key, slice):
             return SynapseCollection(self._datum[key])
         else:
@@ -723,6 +754,32 @@ class SynapseCollection(object):
             targets = (targets,)
         return iter(targets)
 
+    def _get_columns(self, keys):
+        """
+        Return the values of `keys` for all connections as a dictionary of NumPy arrays.
+
+        Weights and delays are fetched for all connections with a single call to the kernel. Returns None if
+        the collection does not store columns, or if any of the connections lacks one of the parameters.
+        """
+
+        if self._columns is None:
+            return None
+
+        values = {}
+        parameter_keys = [key for key in keys if key not in self._ID_COLUMNS and key != 'synapse_model']
+        if parameter_keys:
+            values = sli_func('GetConnectionValues', self._columns, parameter_keys)
+            if any(numpy.isnan(values[key]).any() for key in parameter_keys):
+                return None
+
+        for key in keys:
+            if key == 'synapse_model':
+                values[key] = numpy.array(self._synapse_models)[self._columns['synapse_id']]
+            elif key in self._columns:
+                values[key] = self._columns[key]
+
+        return values
+
     def get(self, keys=None, output=''):
         """
         Return a parameter dictionary of the connections.
@@ -800,12 +857,25 @@ class SynapseCollection(object):
         else:
             raise TypeError("keys should be either a string or an iterable")
 
-        sps(self._datum)
-        sr(cmd)
-        result = spp()
+        columns = None
+        if keys is not None:
+            column_keys = [keys] if is_literal(keys) else list(keys)
+            if self._COLUMN_KEYS.issuperset(column_keys):
+                columns = self._get_columns(column_keys)
 
-        # Need to restructure the data.
-        final_result = restructure_data(result, keys)
+        if columns is not None:
+            single = self.__len__() == 1
+            if is_literal(keys):
+                final_result = columns[keys][0].item() if single else columns[keys].tolist()
+            else:
+                final_result = {key: columns[key][0].item() if single else columns[key].tolist() for key in keys}
+        else:
+            sps(self._datum)
+            sr(cmd)
+            result = spp()
+
+            # Need to restructure the data.
+            final_result = restructure_data(result, keys)
 
         if pandas_output:
             index = (self.get('source') if self.__len__() > 1 else
@@ -918,6 +988,98 @@ class CollocatedSynapses(object):
         return len(self.syn_specs)
 
 
+class ConnectionPlan(object):
+    """
+    Class for connections recorded by :py:func:`.CreateConnectionPlan`.
+
+    A plan holds the connections of the virtual processes of this MPI process
+    as arrays of sources, targets, synapse models, weights, delays and synapse
+    parameters, with one array per virtual process. :py:func:`.ConnectPlan`
+    creates these connections again without running the connection rules,
+    e.g., after :py:func:`.ResetKernel` when the same network is built many
+    times. Plans can be stored in NumPy's binary ``.npz`` format with
+    :py:meth:`save` and read with :py:meth:`load`.
+
+    Example
+    -------
+
+        ::
+
+            nrns = nest.Create('iaf_psc_alpha', 100)
+            plan = nest.CreateConnectionPlan(nrns, nrns, {'rule': 'fixed_indegree', 'indegree': 10})
+
+            nest.ResetKernel()
+            nrns = nest.Create('iaf_psc_alpha', 100)
+            nest.ConnectPlan(plan)
+    """
+
+    _arrays = ('sources', 'targets', 'synapse_model', 'weights', 'delays')
+
+    def __init__(self, plan):
+        """Plans must be created using the CreateConnectionPlan command."""
+        if not isinstance(plan, dict) or 'sources' not in plan:
+            raise TypeError("expected connection plan dictionary")
+        self._plan = plan
+
+    def __len__(self):
+        """Number of connections of this MPI process"""
+        return sum(len(sources) for sources in self._plan['sources'])
+
+    def save(self, filename):
+        """
+        Write the plan to a ``.npz`` file.
+
+        Parameters
+        ----------
+        filename : str
+            Name of the file
+        """
+
+        arrays = {'{}/{}'.format(key, i): values
+                  for key in self._arrays for i, values in enumerate(self._plan[key])}
+        for name, values_on_vps in self._plan['synapse_parameters'].items():
+            arrays.update({'synapse_parameters/{}/{}'.format(name, i): values
+                           for i, values in enumerate(values_on_vps)})
+
+        numpy.savez(filename,
+                    num_processes=self._plan['num_processes'],
+                    total_num_virtual_procs=self._plan['total_num_virtual_procs'],
+                    virtual_processes=numpy.array(self._plan['virtual_processes'], dtype=numpy.int_),
+                    synapse_models=numpy.array([str(model) for model in self._plan['synapse_models']]),
+                    **arrays)
+
+    @classmethod
+    def load(cls, filename):
+        """
+        Read a plan written by :py:meth:`save`.
+
+        Parameters
+        ----------
+        filename : str
+            Name of the file
+
+        Returns
+        -------
+        ConnectionPlan:
+            The plan stored in the file
+        """
+
+        with numpy.load(filename) as data:
+            num_vps = len(data['virtual_processes'])
+            plan = {'num_processes': int(data['num_processes']),
+                    'total_num_virtual_procs': int(data['total_num_virtual_procs']),
+                    'virtual_processes': [int(vp) for vp in data['virtual_processes']],
+                    'synapse_models': [str(model) for model in data['synapse_models']]}
+            for key in cls._arrays:
+                plan[key] = [data['{}/{}'.format(key, i)] for i in range(num_vps)]
+
+            names = set(key.split('/')[1] for key in data.files if key.startswith('synapse_parameters/'))
+            plan['synapse_parameters'] = {name: [data['synapse_parameters/{}/{}'.format(name, i)]
+                                                 for i in range(num_vps)] for name in names}
+
+        return cls(plan)
+
+
 class Mask(object):
     """
     Class for spatial masks.
@@ -53,6 +53,7 @@ from . import pynestkernel as kernel      # noqa
 __all__ = [
     'check_stack',
     'connect_arrays',
+    'connection_datums',
     'set_communicator',
     'get_debug',
     'set_debug',
@@ -74,6 +75,7 @@ sli_push = sps = engine.push
 sli_pop = spp = engine.pop
 take_array_index = engine.take_array_index
 connect_arrays = engine.connect_arrays
+connection_datums = engine.connection_datums
 
 
 def catching_sli_run(cmd):
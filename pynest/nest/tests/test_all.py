@@ -33,8 +33,11 @@ from . import test_connect_fixed_outdegree
 from . import test_connect_fixed_total_number
 from . import test_connect_one_to_one
 from . import test_connect_pairwise_bernoulli
+from . import test_connect_parameter_batch
 from . import test_connect_parameters
 from . import test_connect_symmetric_pairwise_bernoulli
+from . import test_connect_thread_local_targets
+from . import test_connection_plan
 from . import test_create
 from . import test_current_recording_generators
 from . import test_erfc_neuron
@@ -50,6 +53,7 @@ from . import test_labeled_synapses
 from . import test_mc_neuron
 from . import test_mpitests
 from . import test_onetooneconnect
+from . import test_parallel_correlomatrix_detector
 from . import test_parrot_neuron_ps
 from . import test_parrot_neuron
 from . import test_pp_psc_delta
@@ -64,6 +68,8 @@ from . import test_rate_neuron_communication
 from . import test_refractory
 from . import test_siegert_neuron
 from . import test_sp
+from . import test_spike_recorder
+from . import test_spike_statistics_detector
 from . import test_split_simulation
 from . import test_stack
 from . import test_status
@@ -90,8 +96,11 @@ def suite():
     suite.addTest(test_connect_fixed_total_number.suite())
     suite.addTest(test_connect_one_to_one.suite())
     suite.addTest(test_connect_pairwise_bernoulli.suite())
+    suite.addTest(test_connect_parameter_batch.suite())
     suite.addTest(test_connect_parameters.suite())
     suite.addTest(test_connect_symmetric_pairwise_bernoulli.suite())
+    suite.addTest(test_connect_thread_local_targets.suite())
+    suite.addTest(test_connection_plan.suite())
     suite.addTest(test_create.suite())
     suite.addTest(test_current_recording_generators.suite())
     suite.addTest(test_erfc_neuron.suite())
@@ -107,6 +116,7 @@ def suite():
     suite.addTest(test_mc_neuron.suite())
     suite.addTest(test_mpitests.suite())
     suite.addTest(test_onetooneconnect.suite())
+    suite.addTest(test_parallel_correlomatrix_detector.suite())
     suite.addTest(test_parrot_neuron_ps.suite())
     suite.addTest(test_parrot_neuron.suite())
     suite.addTest(test_pp_psc_delta.suite())
@@ -122,6 +132,8 @@ def suite():
     suite.addTest(test_siegert_neuron.suite())
     suite.addTest(test_stdp_nn_synapses.suite())
     suite.addTest(test_sp.suite())
+    suite.addTest(test_spike_recorder.suite())
+    suite.addTest(test_spike_statistics_detector.suite())
     suite.addTest(test_split_simulation.suite())
     suite.addTest(test_stack.suite())
     suite.addTest(test_status.suite())
@@ -338,6 +338,51 @@ class TestConnectArrays(unittest.TestCase):
 
         self.assertEqual(src_alpha_ref, src_alpha)
 
+    @unittest.skipIf(not HAVE_OPENMP, 'NEST was compiled without multi-threading')
+    def test_connect_arrays_threads_independent(self):
+        """Connecting NumPy arrays creates the same connections for any number of threads"""
+
+        rng = np.random.default_rng(12)
+        n = 5000
+        sources = rng.integers(1, 101, n)
+        targets = rng.integers(1, 101, n)
+        syn_spec = {'weight': rng.uniform(1., 2., n), 'delay': rng.uniform(1., 2., n),
+                    'alpha': rng.uniform(size=n), 'receptor_type': np.zeros(n), 'synapse_model': 'stdp_synapse'}
+
+        reference = None
+        for n_threads in (1, 3, 4):
+            nest.ResetKernel()
+            nest.SetKernelStatus({'local_num_threads': n_threads})
+            nest.Create('iaf_psc_alpha', 100)
+            nest.Connect(sources, targets, 'one_to_one', syn_spec)
+
+            conns = nest.GetConnections()
+            conn_info = sorted(zip(conns.source, conns.target, conns.weight, conns.delay, conns.alpha))
+            self.assertEqual(len(conn_info), n)
+            if reference is None:
+                reference = conn_info
+            self.assertEqual(conn_info, reference)
+
+    @unittest.skipIf(not HAVE_OPENMP, 'NEST was compiled without multi-threading')
+    def test_connect_arrays_devices_threaded(self):
+        """Connecting NumPy arrays of neurons and devices, threaded"""
+
+        nest.SetKernelStatus({'local_num_threads': 4})
+        neurons = nest.Create('iaf_psc_alpha', 10)
+        generator = nest.Create('poisson_generator')
+        recorder = nest.Create('spike_recorder')
+
+        sources = np.array(neurons.tolist() + generator.tolist() * 10)
+        targets = np.array(recorder.tolist() * 10 + neurons.tolist())
+        nest.Connect(sources, targets, 'one_to_one', {'weight': np.arange(1., 21.), 'synapse_model': 'static_synapse'})
+
+        to_recorder = nest.GetConnections(target=recorder)
+        self.assertEqual(sorted(zip(to_recorder.source, to_recorder.weight)),
+                         list(zip(neurons.tolist(), np.arange(1., 11.))))
+        from_generator = nest.GetConnections(source=generator)
+        self.assertEqual(sorted(zip(from_generator.target, from_generator.weight)),
+                         list(zip(neurons.tolist(), np.arange(11., 21.))))
+
 
 def suite():
     suite = unittest.TestLoader().loadTestsFromTestCase(TestConnectArrays)
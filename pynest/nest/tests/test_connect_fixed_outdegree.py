@@ -148,6 +148,28 @@ class TestFixedOutDegree(TestParams):
         if M is not None:
             self.assertTrue(M.flatten, np.ones(N * N))
 
+    def testMultapsesFalseLargeDegrees(self):
+        conn_params = self.conn_dict.copy()
+        N = 200
+
+        # degrees close to the population size and varying from node to
+        # node, each drawing the targets without repetitions
+        conn_params['allow_autapses'] = False
+        conn_params['allow_multapses'] = False
+        for degree in [N - 1, hf.nest.random.uniform(0., N - 1.)]:
+            hf.nest.ResetKernel()
+            hf.nest.SetKernelStatus({'local_num_threads': self.nr_threads})
+            pop = hf.nest.Create('iaf_psc_alpha', N)
+            conn_params['outdegree'] = degree
+            hf.nest.Connect(pop, pop, conn_params)
+            M = hf.get_connectivity_matrix(pop, pop)
+            M = hf.gather_data(M)
+            if M is not None:
+                self.assertTrue(np.all(M <= 1))
+                self.assertTrue(np.all(np.diag(M) == 0))
+                if not isinstance(degree, hf.nest.Parameter):
+                    np.testing.assert_array_equal(np.sum(M, axis=0), np.full(N, N - 1))
+
 
 def suite():
     suite = unittest.TestLoader().loadTestsFromTestCase(TestFixedOutDegree)
@@ -122,6 +122,48 @@ class TestFixedTotalNumber(TestParams):
         M = hf.get_connectivity_matrix(pop, pop)
         hf.mpi_assert(np.diag(M), np.zeros(N), self)
 
+    def testStatisticsSerialSplit(self):
+        conn_params = self.conn_dict.copy()
+        conn_params['allow_autapses'] = True
+        conn_params['allow_multapses'] = True
+        conn_params['N'] = self.N
+        conn_params['tree_split'] = False
+        for fan in ['in', 'out']:
+            expected = hf.get_expected_degrees_totalNumber(
+                self.N, fan, self.N_s, self.N_t)
+            pvalues = []
+            for i in range(self.stat_dict['n_runs']):
+                hf.reset_seed(i + 1, self.nr_threads)
+                self.setUpNetwork(conn_dict=conn_params,
+                                  N1=self.N_s, N2=self.N_t)
+                degrees = hf.get_degrees(fan, self.pop1, self.pop2)
+                degrees = hf.gather_data(degrees)
+                if degrees is not None:
+                    chi, p = hf.chi_squared_check(degrees, expected)
+                    pvalues.append(p)
+                hf.mpi_barrier()
+            p = None
+            if degrees is not None:
+                ks, p = scipy.stats.kstest(pvalues, 'uniform')
+            p = hf.bcast_data(p)
+            self.assertGreater(p, self.stat_dict['alpha2'])
+
+    def testTreeSplitThreads(self):
+        # connections are split over the targets of all threads, also if
+        # the targets are not a contiguous range of node IDs
+        conn_params = self.conn_dict.copy()
+        for nr_threads in [1, 3, 4]:
+            for sliced in [False, True]:
+                hf.nest.ResetKernel()
+                hf.nest.SetKernelStatus({'local_num_threads': nr_threads})
+                pop = hf.nest.Create('iaf_psc_alpha', 40)
+                targets = pop[1::3] if sliced else pop[3:11] + pop[20:33]
+                hf.nest.Connect(pop[:10], targets, conn_params)
+                conns = hf.nest.GetConnections()
+                hf.mpi_assert(len(conns), self.Nconn, self)
+                self.assertTrue(set(conns.target) <= set(targets.tolist()))
+                self.assertTrue(set(conns.source) <= set(pop[:10].tolist()))
+
 
 def suite():
     suite = unittest.TestLoader().loadTestsFromTestCase(TestFixedTotalNumber)
@@ -90,6 +90,58 @@ class TestPairwiseBernoulli(TestParams):
         M = hf.get_connectivity_matrix(pop, pop)
         hf.mpi_assert(np.diag(M), np.zeros(N), self)
 
+    def testStatisticsWithoutGeometricSkipping(self):
+        conn_params = self.conn_dict.copy()
+        conn_params['geometric_skipping'] = False
+        for fan in ['in', 'out']:
+            expected = hf.get_expected_degrees_bernoulli(
+                self.p, fan, self.N_s, self.N_t)
+
+            pvalues = []
+            for i in range(self.stat_dict['n_runs']):
+                hf.reset_seed(i+1, self.nr_threads)
+                self.setUpNetwork(conn_dict=conn_params,
+                                  N1=self.N_s, N2=self.N_t)
+                degrees = hf.get_degrees(fan, self.pop1, self.pop2)
+                degrees = hf.gather_data(degrees)
+                if degrees is not None:
+                    chi, p = hf.chi_squared_check(degrees, expected, self.rule)
+                    pvalues.append(p)
+                hf.mpi_barrier()
+            if degrees is not None:
+                ks, p = scipy.stats.kstest(pvalues, 'uniform')
+                self.assertTrue(p > self.stat_dict['alpha2'])
+
+    def testPairwiseStream(self):
+        # without geometric skipping, a constant p draws the same random
+        # numbers per pair as a p computed for each pair
+        conn_params = self.conn_dict.copy()
+        conn_params['geometric_skipping'] = False
+        p_pairwise = hf.nest.CreateParameter('constant', {'value': self.p}) * 1.
+
+        connections = []
+        for p in [self.p, p_pairwise]:
+            conn_params['p'] = p
+            hf.reset_seed(1, self.nr_threads)
+            self.setUpNetwork(conn_dict=conn_params, N1=self.N_s, N2=self.N_t)
+            connections.append(hf.get_connectivity_matrix(self.pop1, self.pop2))
+        hf.mpi_assert(connections[0], connections[1], self)
+
+    def testGeometricSkippingNoConnections(self):
+        conn_params = self.conn_dict.copy()
+        conn_params['p'] = 0.
+        self.setUpNetwork(conn_dict=conn_params, N1=self.N_s, N2=self.N_t)
+        self.assertEqual(hf.nest.GetKernelStatus('num_connections'), 0)
+
+    def testGeometricSkippingAutapsesFalse(self):
+        conn_params = self.conn_dict.copy()
+        conn_params['p'] = 0.9
+        conn_params['allow_autapses'] = False
+        pop = hf.nest.Create('iaf_psc_alpha', 50)
+        hf.nest.Connect(pop, pop, conn_params)
+        M = hf.get_connectivity_matrix(pop, pop)
+        hf.mpi_assert(np.diag(M), np.zeros(50), self)
+
 
 def suite():
     suite = unittest.TestLoader().loadTestsFromTestCase(TestPairwiseBernoulli)
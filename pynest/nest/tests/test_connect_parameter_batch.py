@@ -0,0 +1,110 @@
+# -*- coding: utf-8 -*-
+#
+# test_connect_parameter_batch.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Tests for weights and delays evaluated for all connections to a target at once
+"""
+
+import unittest
+import nest
+import numpy as np
+
+
+@nest.ll_api.check_stack
+class ConnectParameterBatchTestCase(unittest.TestCase):
+
+    def setUp(self):
+        nest.ResetKernel()
+        nest.set_verbosity('M_ERROR')
+
+    def connect(self, conn_spec, syn_spec):
+        """Connect a population to itself and return sources, targets and weights"""
+
+        nrns = nest.Create('iaf_psc_alpha', 12)
+        nest.Connect(nrns, nrns, conn_spec, syn_spec)
+
+        conns = nest.GetConnections()
+        return np.array(conns.source), np.array(conns.target), np.array(conns.get('weight'))
+
+    def test_DeterministicTree(self):
+        """Weights of a tree of deterministic parameters equal the value of the tree"""
+
+        x = nest.CreateParameter('constant', {'value': 0.6})
+        expected = {}
+        expected[True] = 1. + np.exp(-0.6) * np.cos(0.6)
+        expected[False] = min(0.6 ** 2 / 2., 0.7) - 0.1
+
+        for threshold in (0.9, 0.3):
+            weight = nest.logic.conditional(x < threshold,
+                                            1. + nest.math.exp(-x) * nest.math.cos(x),
+                                            nest.math.min(x ** 2 / 2., 0.7) - 0.1)
+            for conn_spec in ('all_to_all', {'rule': 'fixed_indegree', 'indegree': 5}):
+                nest.ResetKernel()
+                _, _, weights = self.connect(conn_spec, {'weight': weight})
+                self.assertGreater(len(weights), 0)
+                np.testing.assert_allclose(weights, expected[0.6 < threshold])
+
+    def test_DeterministicTreeWithoutAutapses(self):
+        """Autapses are left out of the batch of sources"""
+
+        weight = 2. + nest.CreateParameter('constant', {'value': 0.5})
+        sources, targets, weights = self.connect({'rule': 'all_to_all', 'allow_autapses': False}, {'weight': weight})
+        self.assertEqual(len(weights), 12 * 11)
+        self.assertFalse(np.any(sources == targets))
+        np.testing.assert_allclose(weights, 2.5)
+
+    def test_RandomTree(self):
+        """A tree with a single random parameter draws the same random numbers as the parameter itself"""
+
+        x = nest.CreateParameter('constant', {'value': 0.5})
+        weights = {}
+        for name, weight in (('plain', nest.random.uniform(1., 2.)),
+                             ('tree', 3. * nest.random.uniform(1., 2.) + nest.math.exp(x) * 0.)):
+            nest.ResetKernel()
+            _, _, weights[name] = self.connect('all_to_all', {'weight': weight})
+
+        np.testing.assert_allclose(weights['tree'], 3. * weights['plain'])
+
+    def test_RandomWeightAndDelay(self):
+        """Random weights and delays are drawn within their ranges for any number of threads"""
+
+        for n_threads in (1, 2):
+            nest.ResetKernel()
+            nest.SetKernelStatus({'local_num_threads': n_threads})
+            nrns = nest.Create('iaf_psc_alpha', 10)
+            nest.Connect(nrns, nrns, 'all_to_all', {'weight': nest.random.uniform(1., 2.),
+                                                    'delay': nest.random.uniform(1., 2.)})
+            conns = nest.GetConnections()
+            for values in (conns.get('weight'), conns.get('delay')):
+                self.assertEqual(len(values), 100)
+                self.assertTrue(all(1. <= v <= 2. for v in values))
+
+
+def suite():
+
+    suite = unittest.TestLoader().loadTestsFromTestCase(ConnectParameterBatchTestCase)
+    return suite
+
+
+if __name__ == "__main__":
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -0,0 +1,113 @@
+# -*- coding: utf-8 -*-
+#
+# test_connect_thread_local_targets.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Tests that connection builders visiting only the targets on their own
+thread create the same connections for any number of threads
+"""
+
+import unittest
+import nest
+import numpy as np
+
+
+@nest.ll_api.check_stack
+class ThreadLocalTargetsTestCase(unittest.TestCase):
+
+    def connect(self, n_threads, conn_spec, syn_spec=None, targets='composite'):
+        """Return the sorted connections created with the given number of threads"""
+
+        nest.ResetKernel()
+        nest.set_verbosity('M_ERROR')
+        nest.SetKernelStatus({'local_num_threads': n_threads})
+
+        a = nest.Create('iaf_psc_alpha', 7)
+        b = nest.Create('parrot_neuron', 6)
+        c = nest.Create('iaf_psc_alpha', 9)
+        sr = nest.Create('spike_recorder', 3)
+
+        sources, post = {
+            'primitive': (a[:6], c[:6]),
+            'composite': (a[:6] + c[:6], a[1:7] + c[3:9]),
+            'sliced': ((a + c)[1::2], (b + c)[::2]),
+            'autapses': (a[:6] + c[:6], a[:6] + c[3:9]),
+            'devices': (a[:3], sr),
+        }[targets]
+
+        # Connect modifies the arrays in syn_spec
+        nest.Connect(sources, post, conn_spec, dict(syn_spec) if syn_spec else None)
+        conns = nest.GetConnections()
+        return sorted(zip(conns.source, conns.target, conns.get('weight')))
+
+    def assertSameForAllThreads(self, conn_spec, syn_spec=None, targets='composite'):
+        reference = self.connect(1, conn_spec, syn_spec, targets)
+        self.assertGreater(len(reference), 0)
+        for n_threads in (2, 3, 4):
+            self.assertEqual(self.connect(n_threads, conn_spec, syn_spec, targets), reference)
+
+    def test_OneToOne(self):
+        """One-to-one connections are independent of the number of threads"""
+        for targets in ('primitive', 'composite', 'sliced', 'devices'):
+            self.assertSameForAllThreads('one_to_one', targets=targets)
+
+    def test_OneToOneArrays(self):
+        """Array weights of one-to-one connections are assigned to the right targets"""
+        syn_spec = {'weight': [float(i + 1) for i in range(12)]}
+        self.assertSameForAllThreads('one_to_one', syn_spec)
+
+        self.assertSameForAllThreads({'rule': 'one_to_one', 'allow_autapses': False}, syn_spec, targets='autapses')
+
+    def test_AllToAll(self):
+        """All-to-all connections are independent of the number of threads"""
+        for targets in ('primitive', 'composite', 'sliced', 'devices'):
+            self.assertSameForAllThreads('all_to_all', targets=targets)
+
+    def test_AllToAllArrays(self):
+        """Array weights of all-to-all connections are assigned to the right targets"""
+        syn_spec = {'weight': np.arange(144.).reshape(12, 12)}
+        self.assertSameForAllThreads('all_to_all', syn_spec)
+
+    def test_PairwiseBernoulliOne(self):
+        """Pairwise Bernoulli connections with p=1 are independent of the number of threads"""
+        for targets in ('primitive', 'composite', 'sliced'):
+            self.assertSameForAllThreads({'rule': 'pairwise_bernoulli', 'p': 1.}, targets=targets)
+
+    def test_FixedIndegreeCounts(self):
+        """Every target of fixed_indegree gets its indegree for any number of threads"""
+        for targets in ('primitive', 'composite', 'sliced'):
+            for n_threads in (1, 3):
+                conns = self.connect(n_threads, {'rule': 'fixed_indegree', 'indegree': 2}, targets=targets)
+                indegrees = {}
+                for _, target, _ in conns:
+                    indegrees[target] = indegrees.get(target, 0) + 1
+                self.assertEqual(set(indegrees.values()), {2})
+
+
+def suite():
+
+    suite = unittest.TestLoader().loadTestsFromTestCase(ThreadLocalTargetsTestCase)
+    return suite
+
+
+if __name__ == "__main__":
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -0,0 +1,145 @@
+# -*- coding: utf-8 -*-
+#
+# test_connection_plan.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Tests for connections created again from a connection plan
+"""
+
+import os
+import tempfile
+import unittest
+import nest
+import numpy as np
+
+
+@nest.ll_api.check_stack
+class ConnectionPlanTestCase(unittest.TestCase):
+
+    def setUp(self):
+        nest.ResetKernel()
+        nest.set_verbosity('M_ERROR')
+
+    def build(self, n_threads=1):
+        nest.ResetKernel()
+        nest.SetKernelStatus({'local_num_threads': n_threads})
+        return nest.Create('iaf_psc_alpha', 20)
+
+    def connections(self):
+        conns = nest.GetConnections()
+        return sorted(zip(conns.source, conns.target, conns.get('synapse_model'), conns.get('weight'),
+                          conns.get('delay'), conns.get('receptor')))
+
+    def test_ConnectPlanAfterReset(self):
+        """Connecting a plan after ResetKernel creates the recorded connections"""
+
+        for n_threads in (1, 2):
+            nrns = self.build(n_threads)
+            plan = nest.CreateConnectionPlan(nrns, nrns, {'rule': 'fixed_indegree', 'indegree': 5},
+                                             {'weight': nest.random.uniform(1., 2.),
+                                              'delay': nest.random.uniform(1., 3.)})
+            nest.Connect(nrns[:5], nrns[5:10], 'one_to_one', {'synapse_model': 'stdp_synapse'})
+            expected = self.connections()
+            self.assertEqual(len(plan), 100)
+
+            self.build(n_threads)
+            nest.ConnectPlan(plan)
+            nest.ConnectPlan(plan)
+            self.assertEqual(len(nest.GetConnections()), 200)
+
+            nrns = self.build(n_threads)
+            nest.ConnectPlan(plan)
+            nest.Connect(nrns[:5], nrns[5:10], 'one_to_one', {'synapse_model': 'stdp_synapse'})
+            self.assertEqual(self.connections(), expected)
+
+    def test_SynapseModelsAndParameters(self):
+        """Synapse models, receptor types and synapse parameters are recorded"""
+
+        nest.ResetKernel()
+        nrns = nest.Create('iaf_psc_exp_multisynapse', 6, {'tau_syn': [1., 2.]})
+        syn_spec = nest.CollocatedSynapses({'weight': 2.5, 'receptor_type': 2},
+                                           {'synapse_model': 'stdp_synapse', 'alpha': 0.5, 'receptor_type': 1})
+        plan = nest.CreateConnectionPlan(nrns, nrns, 'all_to_all', syn_spec)
+        expected = self.connections()
+        alpha = nest.GetConnections(synapse_model='stdp_synapse').get('alpha')
+
+        nest.ResetKernel()
+        nest.Create('iaf_psc_exp_multisynapse', 6, {'tau_syn': [1., 2.]})
+        nest.ConnectPlan(plan)
+        self.assertEqual(self.connections(), expected)
+        self.assertEqual(nest.GetConnections(synapse_model='stdp_synapse').get('alpha'), alpha)
+
+    def test_SaveAndLoad(self):
+        """A plan read from a file creates the same connections"""
+
+        nrns = self.build()
+        plan = nest.CreateConnectionPlan(nrns, nrns, {'rule': 'pairwise_bernoulli', 'p': 0.3},
+                                         {'synapse_model': 'stdp_synapse', 'alpha': nest.random.uniform()})
+        expected = self.connections()
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            filename = os.path.join(tmpdir, 'plan.npz')
+            plan.save(filename)
+            loaded = nest.ConnectionPlan.load(filename)
+
+        self.build()
+        nest.ConnectPlan(loaded)
+        self.assertEqual(self.connections(), expected)
+
+    def test_ThreadMismatch(self):
+        """A plan cannot be connected with a different number of virtual processes"""
+
+        nrns = self.build(1)
+        plan = nest.CreateConnectionPlan(nrns, nrns, 'all_to_all')
+
+        self.build(2)
+        self.assertRaisesRegex(nest.kernel.NESTError, 'BadProperty', nest.ConnectPlan, plan)
+
+    def test_MissingNodes(self):
+        """All nodes of a plan must exist"""
+
+        nrns = self.build()
+        plan = nest.CreateConnectionPlan(nrns, nrns, 'all_to_all')
+
+        nest.ResetKernel()
+        nest.Create('iaf_psc_alpha', 10)
+        self.assertRaisesRegex(nest.kernel.NESTError, 'UnknownNode', nest.ConnectPlan, plan)
+
+    def test_OnlyRecordsPlanConnections(self):
+        """Connections created before and after the plan are not part of it"""
+
+        nrns = self.build()
+        nest.Connect(nrns[:10], nrns[:10], 'one_to_one')
+        plan = nest.CreateConnectionPlan(nrns, nrns, 'one_to_one')
+        nest.Connect(nrns[:10], nrns[:10], 'one_to_one')
+        self.assertEqual(len(plan), 20)
+        np.testing.assert_array_equal(np.concatenate(plan._plan['sources']), nrns.tolist())
+
+
+def suite():
+
+    suite = unittest.TestLoader().loadTestsFromTestCase(ConnectionPlanTestCase)
+    return suite
+
+
+if __name__ == "__main__":
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -192,6 +192,62 @@ class GetConnectionsTestCase(unittest.TestCase):
             conns = nest.GetConnections(target=tgt, synapse_label=label)
             self.assertEqual(reference_list, conns.synapse_model)
 
+    def test_GetConnectionArrays(self):
+        """GetConnectionArrays returns the same connections as GetConnections"""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({'local_num_threads': 2})
+
+        nrns = nest.Create('iaf_psc_alpha', 10)
+        sr = nest.Create('spike_recorder')
+        nest.Connect(nrns, nrns, {'rule': 'fixed_indegree', 'indegree': 3},
+                     {'weight': nest.random.uniform(1., 2.), 'delay': nest.random.uniform(1., 3.)})
+        nest.Connect(nrns[:4], nrns[4:8], 'one_to_one', {'synapse_model': 'stdp_synapse'})
+        nest.Connect(nrns, sr)
+
+        conns = nest.GetConnections(source=nrns[:5])
+        arrays = nest.GetConnectionArrays(source=nrns[:5], keys=['weight', 'delay'])
+        for key in ('source', 'target', 'target_thread', 'synapse_id', 'port', 'weight', 'delay'):
+            self.assertEqual(arrays[key].tolist(), conns.get(key))
+        self.assertEqual([arrays['synapse_models'][syn_id] for syn_id in arrays['synapse_id']],
+                         conns.get('synapse_model'))
+
+        chunks = list(nest.GetConnectionArrays(source=nrns[:5], keys='weight', chunked=True))
+        self.assertEqual(len(chunks), 2)
+        for thread, chunk in enumerate(chunks):
+            self.assertTrue((chunk['target_thread'] == thread).all())
+        keys = ('source', 'target', 'target_thread', 'synapse_id', 'port', 'weight')
+        self.assertEqual(sorted(zip(*(sum((chunk[key].tolist() for chunk in chunks), []) for key in keys))),
+                         sorted(zip(*(arrays[key].tolist() for key in keys))))
+
+    def test_GetConnectionsColumns(self):
+        """Connections returned by GetConnections match their status"""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({'local_num_threads': 2})
+
+        nrns = nest.Create('iaf_psc_alpha', 6)
+        nest.Connect(nrns, nrns, syn_spec={'weight': nest.random.uniform(1., 2.)})
+        nest.Connect(nrns, nrns, syn_spec={'synapse_model': 'static_synapse_hom_w'})
+
+        conns = nest.GetConnections()
+        status = nest.GetStatus(conns)
+        for key in ('source', 'target', 'target_thread', 'synapse_id', 'port', 'synapse_model', 'delay'):
+            self.assertEqual(conns.get(key), [s[key] for s in status])
+        self.assertEqual(conns[::5].get(['source', 'target']),
+                         {'source': [s['source'] for s in status[::5]],
+                          'target': [s['target'] for s in status[::5]]})
+        self.assertEqual(conns[-1].get('synapse_model'), status[-1]['synapse_model'])
+        self.assertEqual([c.get('port') for c in conns], [s['port'] for s in status])
+
+        # hom_w synapses have no weight of their own
+        self.assertEqual(conns.get('weight'), [s.get('weight') for s in status])
+        static = nest.GetConnections(synapse_model='static_synapse')
+        self.assertEqual(static.get('weight'), [s['weight'] for s in status if s['synapse_model'] == 'static_synapse'])
+
+        static.set(weight=3.)
+        self.assertEqual(static.get('weight'), [3.] * len(static))
+
 
 def suite():
 
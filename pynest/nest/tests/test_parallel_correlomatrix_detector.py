@@ -0,0 +1,131 @@
+# -*- coding: utf-8 -*-
+#
+# test_parallel_correlomatrix_detector.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Tests for the parallel_correlomatrix_detector
+"""
+
+import unittest
+import nest
+import numpy as np
+
+
+@nest.ll_api.check_stack
+class ParallelCorrelomatrixDetectorTestCase(unittest.TestCase):
+    """Compare the histograms with those of the correlomatrix_detector"""
+
+    def simulate(self, n_threads, params={}):
+        """Connect the same sources to both detectors."""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": n_threads})
+
+        nrns = nest.Create("iaf_psc_alpha", 6, params={"I_e": 376.})
+        nrns.set(V_m=list(np.linspace(-70., -55., len(nrns))))
+        # parrots of the same generator spike simultaneously
+        parrots = nest.Create("parrot_neuron", 6)
+        pg = nest.Create("poisson_generator", params={"rate": 200.})
+        nest.Connect(pg, parrots)
+
+        detector_params = dict({"N_channels": 3, "delta_tau": 0.5, "tau_max": 5.}, **params)
+        cd = nest.Create("correlomatrix_detector", params=detector_params)
+        pcd = nest.Create("parallel_correlomatrix_detector", params=detector_params)
+
+        sources = [nrns[:3], nrns[3:] + parrots[:2], parrots[2:]]
+        for channel, source in enumerate(sources):
+            syn_spec = {"receptor_type": channel, "weight": 1. + channel}
+            nest.Connect(source, cd, syn_spec=syn_spec)
+            nest.Connect(source, pcd, syn_spec=syn_spec)
+
+        return cd, pcd
+
+    def assertHistogramsEqual(self, cd, pcd):
+        cd_status = cd.get(["n_events", "count_covariance", "covariance"])
+        pcd_status = pcd.get(["n_events", "count_covariance", "covariance"])
+        self.assertStatusEqual(cd_status, pcd_status)
+
+    def assertStatusEqual(self, cd_status, pcd_status):
+        np.testing.assert_array_equal(pcd_status["n_events"], cd_status["n_events"])
+        np.testing.assert_array_equal(pcd_status["count_covariance"], cd_status["count_covariance"])
+        np.testing.assert_allclose(pcd_status["covariance"], cd_status["covariance"])
+
+    def test_HistogramsEqualCorrelomatrixDetector(self):
+        """Histograms equal those of the correlomatrix_detector"""
+
+        for n_threads in (1, 2, 4):
+            cd, pcd = self.simulate(n_threads, {"Tstart": 20., "Tstop": 180.})
+            nest.Simulate(200.)
+            self.assertGreater(np.sum(cd.count_covariance), 0)
+            self.assertHistogramsEqual(cd, pcd)
+
+    def test_HistogramsBetweenRuns(self):
+        """Histograms are complete after each run, also within a min_delay interval"""
+
+        keys = ["n_events", "count_covariance", "covariance"]
+
+        cd, pcd = self.simulate(2)
+        with nest.RunManager():
+            nest.Run(50.)
+            self.assertHistogramsEqual(cd, pcd)
+            nest.Run(0.3)
+            pcd_status = pcd.get(keys)
+            nest.Run(19.7)
+            self.assertHistogramsEqual(cd, pcd)
+
+        # the correlomatrix_detector only receives spikes at the end of
+        # each min_delay interval, so compare with one that stops counting
+        cd, pcd = self.simulate(2, {"Tstop": 50.3})
+        nest.Simulate(51.)
+        self.assertStatusEqual(cd.get(keys), pcd_status)
+
+    def test_Reset(self):
+        """Changing a parameter resets the histograms"""
+
+        cd, pcd = self.simulate(2)
+        nest.Simulate(100.)
+        cd.Tstart = 0.
+        pcd.Tstart = 0.
+        self.assertEqual(np.sum(pcd.count_covariance), 0)
+
+        nest.Simulate(100.)
+        self.assertHistogramsEqual(cd, pcd)
+
+    def test_DeltaTau(self):
+        """delta_tau must be an odd multiple of the resolution"""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 0.1})
+        pcd = nest.Create("parallel_correlomatrix_detector")
+
+        with self.assertRaises(nest.kernel.NESTError):
+            pcd.delta_tau = 0.2
+
+
+def suite():
+
+    suite = unittest.TestLoader().loadTestsFromTestCase(ParallelCorrelomatrixDetectorTestCase)
+    return suite
+
+
+if __name__ == "__main__":
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -19,9 +19,13 @@
 # You should have received a copy of the GNU General Public License
 # along with NEST.  If not, see <http://www.gnu.org/licenses/>.
 
+import tempfile
 import unittest
+
+import numpy as np
 import nest
 
+HAVE_MPI = nest.ll_api.sli_func("statusdict/have_mpi ::")
 HAVE_SIONLIB = nest.ll_api.sli_func("statusdict/have_sionlib ::")
 
 
@@ -68,10 +72,13 @@ class TestRecordingBackends(unittest.TestCase):
         nest.ResetKernel()
 
         backends = nest.GetKernelStatus("recording_backends")
-        expected_backends = ("ascii", "memory", "screen")
+        expected_backends = ("ascii", "binary", "memory", "screen", "spike_archive")
 
         self.assertTrue(all([b in backends for b in expected_backends]))
 
+        if HAVE_MPI:
+            self.assertTrue("mpiio" in backends)
+
         if HAVE_SIONLIB:
             self.assertTrue("sionlib" in backends)
 
@@ -146,6 +153,254 @@ class TestRecordingBackends(unittest.TestCase):
         self.assertEqual(sr_status["record_to"], "ascii")
         self.assertEqual(sr_status["file_extension"], "dat")
 
+    def testBinaryBackendMatchesMemoryBackend(self):
+        """Test that data read from binary files equals recorded data.
+
+        The buffer size is chosen such that buffers are handed to the
+        writer thread during the run and the last buffer is only
+        partially filled.
+        """
+
+        for time_in_steps in (False, True):
+            nest.ResetKernel()
+            nest.SetKernelStatus({"local_num_threads": 2,
+                                  "overwrite_files": True,
+                                  "data_path": tempfile.mkdtemp(),
+                                  "recording_backends": {"binary": {"buffer_size": 7}}})
+
+            nrns = nest.Create("iaf_psc_alpha", 4, params={"I_e": 400.})
+            rec_params = {"time_in_steps": time_in_steps}
+            sr_mem = nest.Create("spike_recorder", params=rec_params)
+            sr_bin = nest.Create("spike_recorder", params=dict(rec_params, record_to="binary"))
+            mm_mem = nest.Create("multimeter", params=dict(rec_params, record_from=["V_m"], interval=0.5))
+            mm_bin = nest.Create("multimeter",
+                                 params=dict(rec_params, record_to="binary", record_from=["V_m"], interval=0.5))
+            nest.Connect(nrns, sr_mem + sr_bin)
+            nest.Connect(mm_mem + mm_bin, nrns)
+
+            # files are reopened by every call to Simulate, so use two
+            # runs within the same simulation
+            with nest.RunManager():
+                nest.Run(100.)
+                nest.Run(50.)
+
+            for rec_mem, rec_bin in ((sr_mem, sr_bin), (mm_mem, mm_bin)):
+                expected = rec_mem.events
+                recorded = nest.ReadBinaryRecording(rec_bin.filenames)
+                self.assertEqual(set(recorded), set(expected))
+
+                # files hold the data of each thread, so sort before comparing
+                order_exp = np.lexsort((expected["senders"], expected["times"]))
+                order_rec = np.lexsort((recorded["senders"], recorded["times"]))
+                for key in expected:
+                    np.testing.assert_array_equal(recorded[key][order_rec], np.asarray(expected[key])[order_exp])
+
+    def testBinaryBackendBufferSize(self):
+        """Test setting the buffer size of the binary backend."""
+
+        nest.ResetKernel()
+
+        nest.SetKernelStatus({"recording_backends": {"binary": {"buffer_size": 123}}})
+        buffer_size = nest.GetKernelStatus("recording_backends")["binary"]["buffer_size"]
+        self.assertEqual(buffer_size, 123)
+
+        with self.assertRaises(nest.kernel.NESTError):
+            nest.SetKernelStatus({"recording_backends": {"binary": {"buffer_size": 0}}})
+
+    @unittest.skipIf(not HAVE_MPI, 'NEST was compiled without MPI')
+    def testMPIIOBackendMatchesMemoryBackend(self):
+        """Test that data read from MPI-IO files equals recorded data.
+
+        The flush interval is chosen such that data is written during
+        the runs as well as at their end.
+        """
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2,
+                              "overwrite_files": True,
+                              "data_path": tempfile.mkdtemp(),
+                              "recording_backends": {"mpiio": {"flush_interval": 30.}}})
+
+        nrns = nest.Create("iaf_psc_alpha", 4, params={"I_e": 400.})
+        sr_mem = nest.Create("spike_recorder")
+        sr_mpiio = nest.Create("spike_recorder", params={"record_to": "mpiio"})
+        mm_mem = nest.Create("multimeter", params={"record_from": ["V_m"], "interval": 0.5})
+        mm_mpiio = nest.Create("multimeter", params={"record_to": "mpiio", "record_from": ["V_m"], "interval": 0.5})
+        nest.Connect(nrns, sr_mem + sr_mpiio)
+        nest.Connect(mm_mem + mm_mpiio, nrns)
+
+        with nest.RunManager():
+            nest.Run(100.)
+            nest.Run(50.)
+
+        for rec_mem, rec_mpiio in ((sr_mem, sr_mpiio), (mm_mem, mm_mpiio)):
+            # all threads write to the same file
+            self.assertEqual(len(rec_mpiio.filenames), 1)
+
+            expected = rec_mem.events
+            recorded = nest.ReadBinaryRecording(rec_mpiio.filenames)
+            self.assertEqual(set(recorded), set(expected))
+
+            order_exp = np.lexsort((expected["senders"], expected["times"]))
+            order_rec = np.lexsort((recorded["senders"], recorded["times"]))
+            for key in expected:
+                np.testing.assert_array_equal(recorded[key][order_rec], np.asarray(expected[key])[order_exp])
+
+    def testSpikeArchiveQueries(self):
+        """Test that queries of a spike archive return the recorded spikes.
+
+        The archive is read both while it is being written, when only
+        the chunks are available, and after the index has been written.
+        """
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2,
+                              "overwrite_files": True,
+                              "data_path": tempfile.mkdtemp(),
+                              "recording_backends": {"spike_archive": {"chunk_size": 5}}})
+
+        nrns = nest.Create("iaf_psc_alpha", 6, params={"I_e": 400.})
+        sr_mem = nest.Create("spike_recorder")
+        sr_spa = nest.Create("spike_recorder", params={"record_to": "spike_archive"})
+        nest.Connect(nrns, sr_mem + sr_spa)
+
+        def check_query(archive, t_start, t_stop, senders):
+            events = sr_mem.events
+            mask = np.ones(len(events["times"]), dtype=bool)
+            if t_start is not None:
+                mask &= events["times"] >= t_start
+            if t_stop is not None:
+                mask &= events["times"] <= t_stop
+            if senders is not None:
+                mask &= np.in1d(events["senders"], senders.tolist())
+
+            spikes = archive.get_spikes(t_start, t_stop, senders)
+            order = np.lexsort((spikes["senders"], spikes["times"]))
+            order_exp = np.lexsort((events["senders"][mask], events["times"][mask]))
+            np.testing.assert_array_equal(spikes["senders"][order], events["senders"][mask][order_exp])
+            np.testing.assert_array_equal(spikes["times"][order], events["times"][mask][order_exp])
+
+        queries = ((None, None, None), (20., 60., None), (None, None, nrns[1:3]), (30., 120., nrns[::2]))
+
+        with nest.RunManager():
+            nest.Run(100.)
+            archive = nest.OpenSpikeArchive(sr_spa.filenames)
+            self.assertGreater(len(archive.chunks), 2)
+            for query in queries:
+                check_query(archive, *query)
+            nest.Run(50.)
+
+        archive = nest.OpenSpikeArchive(sr_spa.filenames)
+        for query in queries:
+            check_query(archive, *query)
+
+        for chunk in archive.chunks:
+            self.assertTrue(np.all(np.diff(chunk.senders) >= 0))
+            self.assertLessEqual(len(chunk.senders), 5)
+
+    def testSpikeArchiveOnlyForSpikeRecorders(self):
+        """Test that only spike recorders can record to a spike archive."""
+
+        nest.ResetKernel()
+
+        with self.assertRaises(nest.kernel.NESTError):
+            nest.Create("multimeter", params={"record_to": "spike_archive"})
+
+    def testConsumeEvents(self):
+        """Test that ConsumeEvents returns disjoint parts of the data."""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+
+        pg = nest.Create("poisson_generator", params={"rate": 2000.0})
+        parrots = nest.Create("parrot_neuron", 20)
+        nrn = nest.Create("iaf_psc_alpha", params={"I_e": 400.0})
+        srs = nest.Create("spike_recorder", 2)
+        mms = nest.Create("multimeter", 2, params={"record_from": ["V_m"]})
+        nest.Connect(pg, parrots)
+        nest.Connect(parrots, srs)
+        nest.Connect(mms, nrn)
+
+        recorders = srs[0] + mms[0]
+        references = srs[1] + mms[1]
+
+        parts = []
+        with nest.RunManager():
+            for _ in range(5):
+                nest.Run(20.)
+                parts.append(nest.ConsumeEvents(recorders))
+                self.assertEqual(recorders.n_events, (0, 0))
+
+        for i, reference in enumerate(references.events):
+            times = np.concatenate([part[i]["times"] for part in parts])
+            senders = np.concatenate([part[i]["senders"] for part in parts])
+            order = np.lexsort((senders, times))
+            order_ref = np.lexsort((reference["senders"], reference["times"]))
+            self.assertTrue(len(times) > 0)
+            np.testing.assert_array_equal(times[order], reference["times"][order_ref])
+            np.testing.assert_array_equal(senders[order], reference["senders"][order_ref])
+
+    def testMemoryBackendEventsUnchangedByRecording(self):
+        """Test that retrieved events are read-only and not changed by further recording."""
+
+        nest.ResetKernel()
+
+        nrn = nest.Create("iaf_psc_alpha", params={"I_e": 1000.0})
+        sr = nest.Create("spike_recorder")
+        nest.Connect(nrn, sr)
+
+        nest.Simulate(100.)
+        events = sr.events
+        times = events["times"].copy()
+        senders = events["senders"].copy()
+        self.assertTrue(len(times) > 0)
+
+        with self.assertRaises(ValueError):
+            events["times"][0] = 0.
+
+        nest.Simulate(100.)
+        np.testing.assert_array_equal(events["times"], times)
+        np.testing.assert_array_equal(events["senders"], senders)
+        self.assertTrue(sr.n_events > len(times))
+
+        sr.n_events = 0
+        np.testing.assert_array_equal(events["times"], times)
+        self.assertEqual(len(sr.events["times"]), 0)
+
+    def testMemoryBackendChunkSize(self):
+        """Test that data stored in chunks equals data stored in single arrays."""
+
+        recorded = {}
+        for chunk_size in (5, 1000, 0):
+            nest.ResetKernel()
+            nest.SetKernelStatus({"local_num_threads": 2,
+                                  "recording_backends": {"memory": {"chunk_size": chunk_size}}})
+            self.assertEqual(nest.GetKernelStatus("recording_backends")["memory"]["chunk_size"], chunk_size)
+
+            nrns = nest.Create("iaf_psc_alpha", 4, params={"I_e": 400.})
+            sr = nest.Create("spike_recorder")
+            mm = nest.Create("multimeter", params={"record_from": ["V_m"], "interval": 0.5})
+            nest.Connect(nrns, sr)
+            nest.Connect(mm, nrns)
+
+            # read events in between to have shared arrays when recording continues
+            with nest.RunManager():
+                nest.Run(70.)
+                first = sr.events
+                nest.Run(80.)
+            self.assertTrue(len(first["times"]) < sr.n_events)
+
+            recorded[chunk_size] = (sr.events, mm.events)
+
+        for chunk_size in (5, 1000):
+            for events, expected in zip(recorded[chunk_size], recorded[0]):
+                self.assertEqual(set(events), set(expected))
+                for key in expected:
+                    np.testing.assert_array_equal(events[key], expected[key])
+
+        with self.assertRaises(nest.kernel.NESTError):
+            nest.SetKernelStatus({"recording_backends": {"memory": {"chunk_size": -1}}})
+
 
 def suite():
     suite = unittest.TestLoader().loadTestsFromTestCase(TestRecordingBackends)
@@ -32,6 +32,7 @@ in PyNEST only.
 import unittest
 
 from . import test_basics
+from . import test_compiled_parameters
 from . import test_connection_with_elliptical_mask
 from . import test_dumping
 from . import test_plotting
@@ -44,6 +45,7 @@ def suite():
     suite = unittest.TestSuite()
 
     suite.addTest(test_basics.suite())
+    suite.addTest(test_compiled_parameters.suite())
     suite.addTest(test_connection_with_elliptical_mask.suite())
     suite.addTest(test_dumping.suite())
     suite.addTest(test_plotting.suite())
@@ -0,0 +1,103 @@
+# -*- coding: utf-8 -*-
+#
+# test_compiled_parameters.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+"""
+Tests that compiled kernels, weights and delays create the same connections
+as the parameter trees they are compiled from.
+"""
+
+import unittest
+import nest
+import numpy as np
+
+nest.set_verbosity('M_ERROR')
+
+
+class CompiledParametersTestCase(unittest.TestCase):
+
+    def connect(self, conn_spec, syn_spec, compile_parameters, n_threads=1):
+        """Return the connections created with or without compiling the parameters"""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({'rng_seed': 123, 'local_num_threads': n_threads})
+        layer = nest.Create('iaf_psc_alpha', positions=nest.spatial.grid(shape=[6, 5], extent=[1.5, 1.5],
+                                                                          edge_wrap=True))
+
+        conn_spec = dict(conn_spec, compile_parameters=compile_parameters)
+        nest.Connect(layer, layer, conn_spec, syn_spec)
+        conns = nest.GetConnections()
+        return sorted(zip(conns.source, conns.target, conns.get('weight'), conns.get('delay')))
+
+    def assertSameConnections(self, conn_spec, syn_spec=None):
+        for n_threads in (1, 2):
+            tree = self.connect(conn_spec, syn_spec, False, n_threads)
+            compiled = self.connect(conn_spec, syn_spec, True, n_threads)
+            self.assertGreater(len(tree), 0)
+            self.assertEqual(len(compiled), len(tree))
+            for connection, expected in zip(compiled, tree):
+                self.assertEqual(connection[:2], expected[:2])
+                np.testing.assert_allclose(connection[2:], expected[2:])
+
+    def test_PairwiseBernoulliKernel(self):
+        """Distance-dependent probabilities"""
+
+        d = nest.spatial.distance
+        conn_spec = {'rule': 'pairwise_bernoulli', 'p': 0.5 * nest.math.exp(-d / 0.2) * (d < 1.)}
+        self.assertSameConnections(conn_spec)
+        self.assertSameConnections(dict(conn_spec, use_on_source=True))
+
+    def test_ConditionalWeightsAndDelays(self):
+        """Conditional, comparing and mathematical parameters"""
+
+        d = nest.spatial.distance
+        x = nest.spatial.source_pos.x
+        y = nest.spatial.target_pos.y
+        conn_spec = {'rule': 'pairwise_bernoulli', 'p': nest.math.max(1. - d, 0.1),
+                     'mask': {'circular': {'radius': 0.6}}}
+        syn_spec = {'weight': nest.logic.conditional(x > y, nest.math.sin(d) + x, nest.math.cos(d) * y - 2.),
+                    'delay': nest.math.min(1. + 2. * d ** 2 / nest.spatial.distance.x, 5.) + nest.spatial.distance.y}
+        self.assertSameConnections(conn_spec, syn_spec)
+
+    def test_RandomParameters(self):
+        """Random parameters are drawn in the same order"""
+
+        d = nest.spatial.distance
+        conn_spec = {'rule': 'pairwise_bernoulli', 'p': nest.random.uniform(0.2, 0.8) * (d < 0.7)}
+        syn_spec = {'weight': nest.logic.conditional(d < 0.3, nest.random.uniform(0.9, 1.1), 3. + d),
+                    'delay': 1. + nest.random.exponential(1.) * d}
+        self.assertSameConnections(conn_spec, syn_spec)
+
+    def test_FixedDegrees(self):
+        """Kernels and weights of fixed_indegree and fixed_outdegree"""
+
+        d = nest.spatial.distance
+        for rule, degree in (('fixed_indegree', 'indegree'), ('fixed_outdegree', 'outdegree')):
+            conn_spec = {'rule': rule, degree: 4, 'p': nest.math.exp(-d), 'mask': {'circular': {'radius': 0.7}}}
+            self.assertSameConnections(conn_spec, {'weight': 2. * d + 1.})
+
+
+def suite():
+    suite = unittest.makeSuite(CompiledParametersTestCase, 'test')
+    return suite
+
+
+if __name__ == "__main__":
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -0,0 +1,102 @@
+# -*- coding: utf-8 -*-
+#
+# test_spike_recorder.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Tests for recording spikes of nodes given in the senders of a spike recorder
+"""
+
+import unittest
+import nest
+import numpy as np
+
+
+@nest.ll_api.check_stack
+class SpikeRecorderSendersTestCase(unittest.TestCase):
+    """Tests for the senders parameter of the spike recorder"""
+
+    def record(self, n_threads, precise=False):
+        """Record the same spikes through connections and via senders."""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": n_threads})
+
+        model = "iaf_psc_alpha_ps" if precise else "iaf_psc_alpha"
+        nrns = nest.Create(model, 20, params={"I_e": 376.})
+        nrns.set(V_m=list(np.linspace(-70., -55., len(nrns))))
+        parrots = nest.Create("parrot_neuron", 5)
+        pg = nest.Create("poisson_generator", params={"rate": 100.})
+        nest.Connect(pg, parrots)
+
+        recorded = nrns[:10] + parrots
+        sr_conn = nest.Create("spike_recorder", params={"time_in_steps": precise, "start": 20., "stop": 180.})
+        sr_senders = nest.Create("spike_recorder", params={"time_in_steps": precise, "start": 20., "stop": 180.,
+                                                           "senders": recorded})
+        nest.Connect(recorded, sr_conn)
+
+        with nest.RunManager():
+            nest.Run(110.)
+            nest.Run(90.)
+
+        self.assertEqual(sr_senders.senders, recorded)
+
+        return sr_conn.events, sr_senders.events
+
+    def assertEventsEqual(self, expected, events):
+        self.assertEqual(set(events), set(expected))
+        self.assertTrue(len(expected["senders"]) > 0)
+
+        # events of different threads arrive in different order
+        order_exp = np.lexsort((expected["senders"], expected["times"]))
+        order = np.lexsort((events["senders"], events["times"]))
+        for key in expected:
+            np.testing.assert_array_equal(events[key][order], expected[key][order_exp])
+
+    def test_SendersEqualConnections(self):
+        """Spikes recorded via senders equal spikes recorded via connections"""
+
+        for n_threads in (1, 2, 4):
+            self.assertEventsEqual(*self.record(n_threads))
+
+    def test_SendersEqualConnectionsPrecise(self):
+        """Precise spikes recorded via senders equal spikes recorded via connections"""
+
+        self.assertEventsEqual(*self.record(2, precise=True))
+
+    def test_SendersWithoutProxies(self):
+        """Nodes without proxies cannot be recorded via senders"""
+
+        nest.ResetKernel()
+        sg = nest.Create("spike_generator")
+
+        with self.assertRaises(nest.kernel.NESTError):
+            nest.Create("spike_recorder", params={"senders": sg})
+
+
+def suite():
+
+    suite = unittest.TestLoader().loadTestsFromTestCase(SpikeRecorderSendersTestCase)
+    return suite
+
+
+if __name__ == "__main__":
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -0,0 +1,141 @@
+# -*- coding: utf-8 -*-
+#
+# test_spike_statistics_detector.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Tests for the spike_statistics_detector
+"""
+
+import unittest
+import nest
+import numpy as np
+
+
+@nest.ll_api.check_stack
+class SpikeStatisticsDetectorTestCase(unittest.TestCase):
+    """Compare the statistics with those of recorded spikes"""
+
+    def simulate(self, n_threads, start=0., stop=None):
+        """Record the same spikes with a spike recorder and a spike statistics detector."""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": n_threads})
+
+        nrns = nest.Create("iaf_psc_alpha", 10, params={"I_e": 376.})
+        nrns.set(V_m=list(np.linspace(-70., -55., len(nrns))))
+        parrots = nest.Create("parrot_neuron", 5)
+        pg = nest.Create("poisson_generator", params={"rate": 100.})
+        nest.Connect(pg, parrots)
+
+        device_params = {"start": start}
+        if stop is not None:
+            device_params["stop"] = stop
+        sr = nest.Create("spike_recorder", params=device_params)
+        ssd = nest.Create("spike_statistics_detector", params=dict(device_params, bin_width=5.))
+        nest.Connect(nrns + parrots, sr)
+        nest.Connect(nrns + parrots, ssd)
+
+        return sr, ssd
+
+    def assertStatisticsEqual(self, events, status, t0, t_end, bin_width):
+        senders = np.unique(events["senders"])
+        np.testing.assert_array_equal(status["senders"], senders)
+        self.assertEqual(status["n_events"], len(events["times"]))
+
+        duration = t_end - t0
+        for i, sender in enumerate(senders):
+            times = np.sort(events["times"][events["senders"] == sender])
+            self.assertEqual(status["n_spikes"][i], len(times))
+            self.assertAlmostEqual(status["rates"][i], 1000. * len(times) / duration)
+
+            isis = np.diff(times)
+            if len(isis) == 0:
+                self.assertTrue(np.isnan(status["isi_mean"][i]))
+                self.assertTrue(np.isnan(status["cv"][i]))
+            else:
+                self.assertAlmostEqual(status["isi_mean"][i], np.mean(isis))
+                self.assertAlmostEqual(status["isi_variance"][i], np.var(isis))
+                self.assertAlmostEqual(status["cv"][i], np.std(isis) / np.mean(isis))
+
+        # bins are left-open and right-closed, so compute them in steps
+        h = nest.GetKernelStatus("resolution")
+        steps = np.rint((events["times"] - t0) / h).astype(int)
+        bin_steps = int(round(bin_width / h))
+        n_bins = int(round(duration / bin_width))
+        histogram = np.bincount((steps - 1) // bin_steps, minlength=n_bins)
+        np.testing.assert_array_equal(status["population_histogram"], histogram)
+        self.assertAlmostEqual(status["fano_factor"], np.var(histogram) / np.mean(histogram))
+
+    def test_StatisticsEqualRecordedSpikes(self):
+        """Statistics equal those computed from recorded spikes"""
+
+        for n_threads in (1, 2, 4):
+            sr, ssd = self.simulate(n_threads, start=20.)
+            nest.Simulate(200.)
+            self.assertStatisticsEqual(sr.events, ssd.get(), 20., 200., 5.)
+
+    def test_StatisticsDuringRuns(self):
+        """Statistics can be read between runs and are limited to the stop time"""
+
+        sr, ssd = self.simulate(2, stop=150.)
+        with nest.RunManager():
+            nest.Run(100.)
+            self.assertStatisticsEqual(sr.events, ssd.get(), 0., 100., 5.)
+            nest.Run(100.)
+            self.assertStatisticsEqual(sr.events, ssd.get(), 0., 150., 5.)
+
+    def test_Reset(self):
+        """Setting n_events to 0 starts a new observation period"""
+
+        sr, ssd = self.simulate(2)
+        nest.Simulate(100.)
+        ssd.n_events = 0
+        sr.n_events = 0
+        self.assertEqual(len(ssd.senders), 0)
+
+        nest.Simulate(100.)
+        self.assertStatisticsEqual(sr.events, ssd.get(), 100., 200., 5.)
+
+        with self.assertRaises(nest.kernel.NESTError):
+            ssd.n_events = 1
+
+    def test_BinWidth(self):
+        """The bin width must be a positive multiple of the resolution"""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 0.1})
+        ssd = nest.Create("spike_statistics_detector")
+
+        with self.assertRaises(nest.kernel.NESTError):
+            ssd.bin_width = 0.25
+        with self.assertRaises(nest.kernel.NESTError):
+            ssd.bin_width = 0.
+
+
+def suite():
+
+    suite = unittest.TestLoader().loadTestsFromTestCase(SpikeStatisticsDetectorTestCase)
+    return suite
+
+
+if __name__ == "__main__":
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
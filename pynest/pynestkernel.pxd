@@ -103,9 +103,11 @@ cdef extern from "arraydatum.h":
 
     cppclass IntVectorDatum:
         IntVectorDatum(vector[long]*) except +
+        IntVectorDatum(const IntVectorDatum&) except +
 
     cppclass DoubleVectorDatum:
         DoubleVectorDatum(vector[double]*) except +
+        DoubleVectorDatum(const DoubleVectorDatum&) except +
 
 cdef extern from "dict.h":
     cppclass Dictionary:
@@ -181,11 +183,13 @@ ctypedef fused sli_vector_ptr_t:
     sli_vector_int_ptr_t
     sli_vector_double_ptr_t
 
-ctypedef int [:] buffer_int_1d_t
-ctypedef long [:] buffer_long_1d_t
+# const, so that read-only arrays, e.g., those sharing the vectors of
+# IntVectorDatum and DoubleVectorDatum, are not copied element by element
+ctypedef const int [:] buffer_int_1d_t
+ctypedef const long [:] buffer_long_1d_t
 
-ctypedef float [:] buffer_float_1d_t
-ctypedef double [:] buffer_double_1d_t
+ctypedef const float [:] buffer_float_1d_t
+ctypedef const double [:] buffer_double_1d_t
 
 ctypedef fused numeric_buffer_t:
     object
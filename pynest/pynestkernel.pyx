@@ -109,6 +109,48 @@ cdef class SLIDatum(object):
         self.thisptr = dat
 
 
+cdef class SLIVectorBuffer(object):
+    """Read-only buffer sharing the data of an integer or double vector datum.
+
+    The buffer holds its own copy of the datum, which keeps the vector
+    alive as long as the buffer or any NumPy array created from it exists.
+    """
+
+    cdef Datum* thisptr
+    cdef void* data
+    cdef char* format
+    cdef Py_ssize_t itemsize
+    cdef Py_ssize_t shape[1]
+    cdef Py_ssize_t strides[1]
+
+    def __cinit__(self):
+
+        self.thisptr = NULL
+
+    def __dealloc__(self):
+
+        if self.thisptr is not NULL:
+            del self.thisptr
+
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+
+        buffer.buf = self.data
+        buffer.format = self.format
+        buffer.internal = NULL
+        buffer.itemsize = self.itemsize
+        buffer.len = self.shape[0] * self.itemsize
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 1
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+
+        pass
+
+
 cdef class SLILiteral(object):
 
     cdef readonly object name
@@ -321,10 +363,10 @@ cdef class NESTEngine(object):
                 raise ValueError('syn_param_values must be a matrix with arrays of the same length as sources and targets.')
 
         # Get pointers to the first element in each NumPy array
-        cdef long[::1] sources_mv = numpy.ascontiguousarray(sources, dtype=numpy.long)
+        cdef long[::1] sources_mv = numpy.ascontiguousarray(sources, dtype=numpy.int_)
         cdef long* sources_ptr = &sources_mv[0]
 
-        cdef long[::1] targets_mv = numpy.ascontiguousarray(targets, dtype=numpy.long)
+        cdef long[::1] targets_mv = numpy.ascontiguousarray(targets, dtype=numpy.int_)
         cdef long* targets_ptr = &targets_mv[0]
 
         cdef double[::1] weights_mv
@@ -359,6 +401,33 @@ cdef class NESTEngine(object):
             exceptionCls = getattr(NESTErrors, str(e))
             raise exceptionCls('connect_arrays', '') from None
 
+    def connection_datums(self, sources, targets, target_threads, synapse_ids, ports):
+        """Returns a list of connection datums for connections given as arrays of their identifiers"""
+        if not HAVE_NUMPY:
+            raise NESTErrors.PyNESTError("NumPy is not available")
+
+        cdef const long[::1] sources_mv = numpy.ascontiguousarray(sources, dtype=numpy.int_)
+        cdef const long[::1] targets_mv = numpy.ascontiguousarray(targets, dtype=numpy.int_)
+        cdef const long[::1] target_threads_mv = numpy.ascontiguousarray(target_threads, dtype=numpy.int_)
+        cdef const long[::1] synapse_ids_mv = numpy.ascontiguousarray(synapse_ids, dtype=numpy.int_)
+        cdef const long[::1] ports_mv = numpy.ascontiguousarray(ports, dtype=numpy.int_)
+
+        cdef Py_ssize_t i
+        cdef Py_ssize_t n = len(sources_mv)
+        if not (len(targets_mv) == n and len(target_threads_mv) == n and len(synapse_ids_mv) == n and
+                len(ports_mv) == n):
+            raise ValueError('All arrays must have the same length.')
+
+        cdef unicode dtype = SLI_TYPE_CONNECTION.decode()
+        datums = [None] * n
+        for i in range(n):
+            datum = SLIDatum()
+            (<SLIDatum> datum)._set_datum(<Datum*> new ConnectionDatum(ConnectionID(
+                sources_mv[i], targets_mv[i], target_threads_mv[i], synapse_ids_mv[i], ports_mv[i])), dtype)
+            datums[i] = datum
+
+        return datums
+
 cdef inline Datum* python_object_to_datum(obj) except NULL:
 
     cdef Datum* ret = NULL
@@ -604,29 +673,45 @@ cdef inline object sli_vector_to_object(sli_vector_ptr_t dat, vector_value_t _ =
 
     cdef vector_value_t* array_data = NULL
     cdef vector[vector_value_t]* vector_ptr = NULL
+    cdef SLIVectorBuffer buff = None
+
+    if HAVE_NUMPY:
+        buff = SLIVectorBuffer()
 
     if sli_vector_ptr_t is sli_vector_int_ptr_t and vector_value_t is long:
         vector_ptr = deref_ivector(dat)
-        arr = array.clone(ARRAY_LONG, vector_ptr.size(), False)
-        array_data = arr.data.as_longs
         if HAVE_NUMPY:
             ret_dtype = numpy.int_
+            buff.thisptr = <Datum*> new IntVectorDatum(deref(dat))
+            buff.format = b"l"
+        else:
+            arr = array.clone(ARRAY_LONG, vector_ptr.size(), False)
+            array_data = arr.data.as_longs
     elif sli_vector_ptr_t is sli_vector_double_ptr_t and vector_value_t is double:
         vector_ptr = deref_dvector(dat)
-        arr = array.clone(ARRAY_DOUBLE, vector_ptr.size(), False)
-        array_data = arr.data.as_doubles
         if HAVE_NUMPY:
             ret_dtype = numpy.float_
+            buff.thisptr = <Datum*> new DoubleVectorDatum(deref(dat))
+            buff.format = b"d"
+        else:
+            arr = array.clone(ARRAY_DOUBLE, vector_ptr.size(), False)
+            array_data = arr.data.as_doubles
     else:
         raise NESTErrors.PyNESTError("unsupported specialization")
 
-    memcpy(array_data, &vector_ptr.front(), vector_ptr.size() * sizeof(vector_value_t))
-
     if HAVE_NUMPY:
         if vector_ptr.size() > 0:
-            return numpy.frombuffer(arr, dtype=ret_dtype)
+            # share the data of the vector instead of copying it, the
+            # copy of the datum in the buffer keeps the vector alive
+            buff.data = &vector_ptr.front()
+            buff.itemsize = sizeof(vector_value_t)
+            buff.shape[0] = vector_ptr.size()
+            buff.strides[0] = sizeof(vector_value_t)
+            return numpy.frombuffer(buff, dtype=ret_dtype)
         else:
             # Compatibility with NumPy < 1.7.0
             return numpy.array([], dtype=ret_dtype)
-    else:
-        return arr
+
+    memcpy(array_data, &vector_ptr.front(), vector_ptr.size() * sizeof(vector_value_t))
+
+    return arr
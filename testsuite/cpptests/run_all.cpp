@@ -28,6 +28,7 @@
 #include "test_block_vector.h"
 #include "test_enum_bitfield.h"
 #include "test_sort.h"
+#include "test_spike_history.h"
 #include "test_streamers.h"
 #include "test_target_fields.h"
 #include "test_parameter.h"
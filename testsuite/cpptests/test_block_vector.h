@@ -27,6 +27,7 @@
 #include <boost/test/unit_test.hpp>
 
 // C++ includes:
+#include <algorithm>
 #include <vector>
 
 // Includes from libnestutil:
@@ -113,6 +114,40 @@ BOOST_AUTO_TEST_CASE( test_clear )
   BOOST_REQUIRE( n_elements == 0 );
 }
 
+BOOST_AUTO_TEST_CASE( test_reserve )
+{
+  BlockVector< int > block_vector;
+  std::vector< int > reference;
+  int N = 3 * block_vector.get_max_block_size() + 10;
+
+  // reserve while empty and when partly filled, with and without effect
+  block_vector.reserve( N / 2 );
+  for ( int i = 0; i < N; ++i )
+  {
+    if ( i == block_vector.get_max_block_size() - 1 )
+    {
+      block_vector.reserve( N );
+    }
+    if ( i == N - 5 )
+    {
+      block_vector.reserve( 10 );
+    }
+    block_vector.push_back( i );
+    reference.push_back( i );
+  }
+
+  BOOST_REQUIRE( block_vector.size() == ( size_t ) N );
+  BOOST_REQUIRE( std::equal( reference.begin(), reference.end(), block_vector.begin() ) );
+
+  // blocks reserved beyond the end are removed by erasing
+  block_vector.reserve( 2 * N );
+  block_vector.erase( block_vector.begin() + 5, block_vector.end() );
+  BOOST_REQUIRE( block_vector.size() == 5 );
+  block_vector.push_back( 5 );
+  BOOST_REQUIRE( block_vector.size() == 6 );
+  BOOST_REQUIRE( std::equal( block_vector.begin(), block_vector.end(), reference.begin() ) );
+}
+
 BOOST_AUTO_TEST_CASE( test_erase )
 {
   int N = 10;
@@ -0,0 +1,114 @@
+/*
+ *  test_spike_history.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TEST_SPIKE_HISTORY_H
+#define TEST_SPIKE_HISTORY_H
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+// C++ includes:
+#include <algorithm>
+#include <deque>
+
+// Includes from nestkernel:
+#include "spike_history.h"
+
+BOOST_AUTO_TEST_SUITE( test_spike_history )
+
+/**
+ * Push and pop more entries than fit into the initial capacity, so that the
+ * buffer wraps around and grows, and compare with a deque.
+ */
+BOOST_AUTO_TEST_CASE( test_push_pop_wrap_around )
+{
+  nest::SpikeHistory history;
+  std::deque< double > reference;
+
+  for ( int i = 0; i < 100; ++i )
+  {
+    history.push_back( i, 2. * i, 3. * i );
+    reference.push_back( i );
+    if ( i % 3 == 2 )
+    {
+      history.pop_front();
+      reference.pop_front();
+    }
+
+    BOOST_REQUIRE( history.size() == reference.size() );
+    BOOST_REQUIRE( history.front().t_ == reference.front() );
+    BOOST_REQUIRE( history.back().t_ == reference.back() );
+    BOOST_REQUIRE( history.back().Kminus_ == 2. * i );
+  }
+
+  BOOST_REQUIRE( std::equal( reference.begin(),
+    reference.end(),
+    history.begin(),
+    []( const double t, const nest::histentry& entry ) { return t == entry.t_; } ) );
+}
+
+/**
+ * Access counters are stored as differences; check that the counter of the
+ * oldest entry equals the number of read operations covering it.
+ */
+BOOST_AUTO_TEST_CASE( test_access_counter )
+{
+  nest::SpikeHistory history;
+  std::deque< size_t > reference;
+
+  for ( int i = 0; i < 20; ++i )
+  {
+    history.push_back( i, 0., 0. );
+    reference.push_back( 0 );
+
+    // read a range at the end and a range in the middle
+    history.mark_read( history.begin() + history.size() / 2, history.end() );
+    for ( size_t j = reference.size() / 2; j < reference.size(); ++j )
+    {
+      ++reference[ j ];
+    }
+    // empty ranges must be ignored
+    history.mark_read( history.begin() + 1, history.begin() + history.size() / 2 );
+    for ( size_t j = 1; j < reference.size() / 2; ++j )
+    {
+      ++reference[ j ];
+    }
+
+    if ( i % 4 == 3 )
+    {
+      history.pop_front();
+      reference.pop_front();
+    }
+    BOOST_REQUIRE( history.get_front_access_counter() == reference.front() );
+  }
+
+  while ( history.size() > 0 )
+  {
+    BOOST_REQUIRE( history.get_front_access_counter() == reference.front() );
+    history.pop_front();
+    reference.pop_front();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* TEST_SPIKE_HISTORY_H */